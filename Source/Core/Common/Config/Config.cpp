@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
 #include <list>
 #include <map>
 #include <shared_mutex>
@@ -18,6 +19,7 @@ static std::list<ConfigChangedCallback> s_callbacks;
 static u32 s_callback_guards = 0;
 
 static std::shared_mutex s_layers_rw_lock;
+static std::atomic<u32> s_config_version{1};
 
 using ReadLock = std::shared_lock<std::shared_mutex>;
 using WriteLock = std::unique_lock<std::shared_mutex>;
@@ -30,6 +32,7 @@ static void AddLayerInternal(std::shared_ptr<Layer> layer)
     const Config::LayerType layer_type = layer->GetLayer();
     s_layers.insert_or_assign(layer_type, std::move(layer));
   }
+  OnConfigChanged();
   InvokeConfigChangedCallbacks();
 }
 
@@ -58,9 +61,22 @@ void RemoveLayer(LayerType layer)
 
     s_layers.erase(layer);
   }
+  OnConfigChanged();
   InvokeConfigChangedCallbacks();
 }
 
+u32 GetConfigVersion()
+{
+  return s_config_version.load(std::memory_order_acquire);
+}
+
+void OnConfigChanged()
+{
+  // 0 is what an empty cache holds, so skip it when wrapping around.
+  if (s_config_version.fetch_add(1, std::memory_order_acq_rel) + 1 == 0)
+    s_config_version.fetch_add(1, std::memory_order_acq_rel);
+}
+
 void AddConfigChangedCallback(ConfigChangedCallback func)
 {
   s_callbacks.emplace_back(std::move(func));
@@ -110,6 +126,7 @@ void Shutdown()
 
   s_layers.clear();
   s_callbacks.clear();
+  OnConfigChanged();
 }
 
 void ClearCurrentRunLayer()
@@ -117,6 +134,7 @@ void ClearCurrentRunLayer()
   WriteLock lock(s_layers_rw_lock);
 
   s_layers.insert_or_assign(LayerType::CurrentRun, std::make_shared<Layer>(LayerType::CurrentRun));
+  OnConfigChanged();
 }
 
 static const std::map<System, std::string> system_to_name = {
@@ -39,18 +39,38 @@ std::optional<System> GetSystemFromName(const std::string& system);
 const std::string& GetLayerName(LayerType layer);
 LayerType GetActiveLayerForConfig(const Location&);
 
+// Incremented whenever a layer is added, removed or written to. Values cached by Get() are only
+// used while the version they were read at is still current. Never returns 0.
+u32 GetConfigVersion();
+void OnConfigChanged();
+
 template <typename T>
-T Get(LayerType layer, const Info<T>& info)
+T GetUncached(const Info<T>& info)
 {
-  if (layer == LayerType::Meta)
-    return Get(info);
-  return GetLayer(layer)->Get(info);
+  return GetLayer(GetActiveLayerForConfig(info.location))->Get(info);
 }
 
 template <typename T>
 T Get(const Info<T>& info)
 {
-  return GetLayer(GetActiveLayerForConfig(info.location))->Get(info);
+  // The version must be read before the layers are, so that a concurrent write invalidates
+  // whatever we are about to cache.
+  const u32 config_version = GetConfigVersion();
+  T value;
+  if (info.GetCachedValue(config_version, &value))
+    return value;
+
+  value = GetUncached(info);
+  info.SetCachedValue(config_version, value);
+  return value;
+}
+
+template <typename T>
+T Get(LayerType layer, const Info<T>& info)
+{
+  if (layer == LayerType::Meta)
+    return Get(info);
+  return GetLayer(layer)->Get(info);
 }
 
 template <typename T>
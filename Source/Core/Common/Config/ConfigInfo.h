@@ -4,9 +4,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <type_traits>
 
+#include "Common/CommonTypes.h"
 #include "Common/Config/Enums.h"
 
 namespace Config
@@ -16,6 +21,61 @@ namespace detail
 // std::underlying_type may only be used with enum types, so make sure T is an enum type first.
 template <typename T>
 using UnderlyingType = typename std::enable_if_t<std::is_enum<T>{}, std::underlying_type<T>>::type;
+
+// Holds the last value read for an Info along with the config version it was read at.
+// A version of 0 means that nothing has been cached yet.
+template <typename T, typename Enable = void>
+class CachedValue
+{
+public:
+  bool Get(u32 version, T* value) const
+  {
+    std::shared_lock lock(m_mutex);
+    if (m_version != version)
+      return false;
+    *value = m_value;
+    return true;
+  }
+
+  void Set(u32 version, const T& value)
+  {
+    std::unique_lock lock(m_mutex);
+    m_version = version;
+    m_value = value;
+  }
+
+private:
+  mutable std::shared_mutex m_mutex;
+  u32 m_version = 0;
+  T m_value{};
+};
+
+// Small values (bools, ints, floats and most enums) are packed together with the version so that
+// a cache hit is a single atomic load.
+template <typename T>
+class CachedValue<T, std::enable_if_t<std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(u32)>>
+{
+public:
+  bool Get(u32 version, T* value) const
+  {
+    const u64 packed = m_packed.load(std::memory_order_acquire);
+    if (static_cast<u32>(packed >> 32) != version)
+      return false;
+    const u32 bits = static_cast<u32>(packed);
+    std::memcpy(value, &bits, sizeof(T));
+    return true;
+  }
+
+  void Set(u32 version, const T& value)
+  {
+    u32 bits = 0;
+    std::memcpy(&bits, &value, sizeof(T));
+    m_packed.store(static_cast<u64>(version) << 32 | bits, std::memory_order_release);
+  }
+
+private:
+  std::atomic<u64> m_packed{0};
+};
 }  // namespace detail
 
 struct Location
@@ -47,7 +107,31 @@ struct Info
   {
   }
 
+  // The cache belongs to this particular object, so copies start out empty.
+  Info(const Info<T>& other) : location{other.location}, default_value{other.default_value} {}
+
+  Info<T>& operator=(const Info<T>& other)
+  {
+    location = other.location;
+    default_value = other.default_value;
+    m_cached_value.Set(0, T{});
+    return *this;
+  }
+
+  bool GetCachedValue(u32 config_version, T* value) const
+  {
+    return m_cached_value.Get(config_version, value);
+  }
+
+  void SetCachedValue(u32 config_version, const T& value) const
+  {
+    m_cached_value.Set(config_version, value);
+  }
+
   Location location;
   T default_value;
+
+private:
+  mutable detail::CachedValue<T> m_cached_value;
 };
 }  // namespace Config
@@ -52,6 +52,7 @@ bool Layer::DeleteKey(const Location& location)
   {
     iter->second.reset();
     had_value = true;
+    OnConfigChanged();
   }
 
   return had_value;
@@ -64,10 +65,22 @@ void Layer::DeleteAllKeys()
   {
     pair.second.reset();
   }
+  OnConfigChanged();
+}
+
+void Layer::Set(const Location& location, std::string new_value)
+{
+  const auto iter = m_map.find(location);
+  if (iter != m_map.end() && iter->second == new_value)
+    return;
+  m_is_dirty = true;
+  m_map.insert_or_assign(location, std::move(new_value));
+  OnConfigChanged();
 }
 
 Section Layer::GetSection(System system, const std::string& section)
 {
+  OnConfigChanged();
   return Section{m_map.lower_bound(Location{system, section, ""}),
                  m_map.lower_bound(Location{system, section + '\001', ""})};
 }
@@ -83,6 +96,7 @@ void Layer::Load()
   if (m_loader)
     m_loader->Load(this);
   m_is_dirty = false;
+  OnConfigChanged();
 }
 
 void Layer::Save()
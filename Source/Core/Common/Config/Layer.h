@@ -129,15 +129,9 @@ public:
     Set(location, ValueToString(value));
   }
 
-  void Set(const Location& location, std::string new_value)
-  {
-    const auto iter = m_map.find(location);
-    if (iter != m_map.end() && iter->second == new_value)
-      return;
-    m_is_dirty = true;
-    m_map.insert_or_assign(location, std::move(new_value));
-  }
+  void Set(const Location& location, std::string new_value);
 
+  // Values may be modified through the returned section, so this counts as a config change.
   Section GetSection(System system, const std::string& section);
   ConstSection GetSection(System system, const std::string& section) const;
 
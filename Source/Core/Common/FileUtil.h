@@ -105,6 +105,11 @@ public:
   bool IsFile() const;
   // Returns the size of a file (or returns 0 if the path doesn't refer to a file)
   u64 GetSize() const;
+  // Returns the last modification time in seconds since the epoch (or 0 if the path doesn't exist)
+  s64 GetModificationTime() const;
+  // Returns the inode number of the path (or 0 if the path doesn't exist or the
+  // host filesystem doesn't provide one)
+  u64 GetInode() const;
 
 private:
   struct stat m_stat;
@@ -6,12 +6,16 @@
 
 #include <algorithm>
 #include <cstring>
+#include <vector>
+
 #include "Common/BitUtils.h"
 #include "Common/CPUDetect.h"
 #include "Common/CommonFuncs.h"
 #include "Common/Intrinsics.h"
+#include "Common/Swap.h"
 
 #ifdef _M_ARM_64
+#include <arm_neon.h>
 #ifdef _MSC_VER
 #include <intrin.h>
 #else
@@ -505,29 +509,581 @@ static u64 GetMurmurHash3(const u8* src, u32 len, u32 samples)
 }
 #endif
 
+// XXH3-64 (https://github.com/Cyan4973/xxHash), with a seed of 0 and the default secret.
+// Inputs of up to 240 bytes are hashed with scalar code. Longer inputs are split into 64-byte
+// stripes that are accumulated into 8 lanes, which is where the vector versions come in.
+namespace XXH3
+{
+constexpr u32 PRIME32_1 = 0x9E3779B1U;
+constexpr u32 PRIME32_2 = 0x85EBCA77U;
+constexpr u32 PRIME32_3 = 0xC2B2AE3DU;
+constexpr u64 PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr u64 PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr u64 PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr u64 PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr u64 PRIME64_5 = 0x27D4EB2F165667C5ULL;
+constexpr u64 PRIME_MX1 = 0x165667919E3779F9ULL;
+constexpr u64 PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+constexpr u32 STRIPE_SIZE = 64;
+constexpr u32 SECRET_SIZE = 192;
+constexpr u32 SECRET_CONSUME_RATE = 8;
+constexpr u32 STRIPES_PER_BLOCK = (SECRET_SIZE - STRIPE_SIZE) / SECRET_CONSUME_RATE;
+constexpr u32 BLOCK_SIZE = STRIPE_SIZE * STRIPES_PER_BLOCK;
+constexpr u32 MIDSIZE_MAX = 240;
+
+static_assert(HASH64_CHECKPOINT_INTERVAL % BLOCK_SIZE == 0);
+
+alignas(64) constexpr u8 SECRET[SECRET_SIZE] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+constexpr Hash64Checkpoint INITIAL_ACC = {PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3,
+                                          PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1};
+
+static u32 Read32(const u8* p)
+{
+  u32 value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static u64 Read64(const u8* p)
+{
+  u64 value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static u64 RotateLeft64(u64 value, int amount)
+{
+  return (value << amount) | (value >> (64 - amount));
+}
+
+// Multiplies two 64-bit numbers and folds the 128-bit product into 64 bits.
+static u64 Mul128Fold64(u64 lhs, u64 rhs)
+{
+#if defined(__SIZEOF_INT128__)
+  const unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+  return static_cast<u64>(product) ^ static_cast<u64>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X86_64)
+  u64 high;
+  const u64 low = _umul128(lhs, rhs, &high);
+  return low ^ high;
+#elif defined(_MSC_VER) && defined(_M_ARM_64)
+  return (lhs * rhs) ^ __umulh(lhs, rhs);
+#else
+  const u64 lo_lo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+  const u64 hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+  const u64 lo_hi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+  const u64 hi_hi = (lhs >> 32) * (rhs >> 32);
+  const u64 cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+  const u64 upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+  const u64 lower = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+  return lower ^ upper;
+#endif
+}
+
+static u64 XXH64Avalanche(u64 hash)
+{
+  hash ^= hash >> 33;
+  hash *= PRIME64_2;
+  hash ^= hash >> 29;
+  hash *= PRIME64_3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+static u64 Avalanche(u64 hash)
+{
+  hash ^= hash >> 37;
+  hash *= PRIME_MX1;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+static u64 RRMXMX(u64 hash, u64 len)
+{
+  hash ^= RotateLeft64(hash, 49) ^ RotateLeft64(hash, 24);
+  hash *= PRIME_MX2;
+  hash ^= (hash >> 35) + len;
+  hash *= PRIME_MX2;
+  return hash ^ (hash >> 28);
+}
+
+static u64 Mix16B(const u8* input, const u8* secret)
+{
+  return Mul128Fold64(Read64(input) ^ Read64(secret), Read64(input + 8) ^ Read64(secret + 8));
+}
+
+static u64 Hash0To16(const u8* input, u32 len)
+{
+  if (len > 8)
+  {
+    const u64 bitflip1 = Read64(SECRET + 24) ^ Read64(SECRET + 32);
+    const u64 bitflip2 = Read64(SECRET + 40) ^ Read64(SECRET + 48);
+    const u64 input_lo = Read64(input) ^ bitflip1;
+    const u64 input_hi = Read64(input + len - 8) ^ bitflip2;
+    const u64 acc = len + Common::swap64(input_lo) + input_hi + Mul128Fold64(input_lo, input_hi);
+    return Avalanche(acc);
+  }
+  if (len >= 4)
+  {
+    const u64 bitflip = Read64(SECRET + 8) ^ Read64(SECRET + 16);
+    const u64 input64 = Read32(input + len - 4) + (static_cast<u64>(Read32(input)) << 32);
+    return RRMXMX(input64 ^ bitflip, len);
+  }
+  if (len > 0)
+  {
+    const u32 combined = (static_cast<u32>(input[0]) << 16) |
+                         (static_cast<u32>(input[len >> 1]) << 24) | input[len - 1] | (len << 8);
+    const u64 bitflip = Read32(SECRET) ^ Read32(SECRET + 4);
+    return XXH64Avalanche(combined ^ bitflip);
+  }
+  return XXH64Avalanche(Read64(SECRET + 56) ^ Read64(SECRET + 64));
+}
+
+static u64 Hash17To128(const u8* input, u32 len)
+{
+  u64 acc = len * PRIME64_1;
+  if (len > 32)
+  {
+    if (len > 64)
+    {
+      if (len > 96)
+      {
+        acc += Mix16B(input + 48, SECRET + 96);
+        acc += Mix16B(input + len - 64, SECRET + 112);
+      }
+      acc += Mix16B(input + 32, SECRET + 64);
+      acc += Mix16B(input + len - 48, SECRET + 80);
+    }
+    acc += Mix16B(input + 16, SECRET + 32);
+    acc += Mix16B(input + len - 32, SECRET + 48);
+  }
+  acc += Mix16B(input, SECRET);
+  acc += Mix16B(input + len - 16, SECRET + 16);
+  return Avalanche(acc);
+}
+
+static u64 Hash129To240(const u8* input, u32 len)
+{
+  constexpr u32 START_OFFSET = 3;
+  constexpr u32 LAST_OFFSET = 17;
+
+  u64 acc = len * PRIME64_1;
+  const u32 rounds = len / 16;
+  for (u32 i = 0; i < 8; i++)
+    acc += Mix16B(input + 16 * i, SECRET + 16 * i);
+  acc = Avalanche(acc);
+
+  for (u32 i = 8; i < rounds; i++)
+    acc += Mix16B(input + 16 * i, SECRET + 16 * (i - 8) + START_OFFSET);
+  acc += Mix16B(input + len - 16, SECRET + 136 - LAST_OFFSET);
+  return Avalanche(acc);
+}
+
+// Accumulates stripes stripes into acc. Stripe n is read from input + n * stride and mixed with
+// secret + n * SECRET_CONSUME_RATE.
+using AccumulateFunction = void (*)(u64* acc, const u8* input, const u8* secret, u32 stripes,
+                                    size_t stride);
+using ScrambleFunction = void (*)(u64* acc, const u8* secret);
+
+struct Kernel
+{
+  AccumulateFunction accumulate;
+  ScrambleFunction scramble;
+};
+
+static void AccumulateScalar(u64* acc, const u8* input, const u8* secret, u32 stripes,
+                             size_t stride)
+{
+  for (u32 n = 0; n < stripes; n++)
+  {
+    const u8* stripe = input + n * stride;
+    const u8* key = secret + n * SECRET_CONSUME_RATE;
+    for (u32 i = 0; i < 8; i++)
+    {
+      const u64 data_val = Read64(stripe + 8 * i);
+      const u64 data_key = data_val ^ Read64(key + 8 * i);
+      acc[i ^ 1] += data_val;
+      acc[i] += static_cast<u64>(static_cast<u32>(data_key)) * (data_key >> 32);
+    }
+  }
+}
+
+static void ScrambleScalar(u64* acc, const u8* secret)
+{
+  for (u32 i = 0; i < 8; i++)
+  {
+    u64 value = acc[i];
+    value ^= value >> 47;
+    value ^= Read64(secret + 8 * i);
+    value *= PRIME32_1;
+    acc[i] = value;
+  }
+}
+
+#if defined(_M_X86)
+
+static void AccumulateSSE2(u64* acc, const u8* input, const u8* secret, u32 stripes,
+                           size_t stride)
+{
+  __m128i acc_vec[4];
+  for (u32 i = 0; i < 4; i++)
+    acc_vec[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc) + i);
+
+  for (u32 n = 0; n < stripes; n++)
+  {
+    const __m128i* stripe = reinterpret_cast<const __m128i*>(input + n * stride);
+    const __m128i* key = reinterpret_cast<const __m128i*>(secret + n * SECRET_CONSUME_RATE);
+    for (u32 i = 0; i < 4; i++)
+    {
+      const __m128i data_vec = _mm_loadu_si128(stripe + i);
+      const __m128i data_key = _mm_xor_si128(data_vec, _mm_loadu_si128(key + i));
+      const __m128i data_key_hi = _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+      const __m128i product = _mm_mul_epu32(data_key, data_key_hi);
+      const __m128i data_swap = _mm_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+      acc_vec[i] = _mm_add_epi64(product, _mm_add_epi64(acc_vec[i], data_swap));
+    }
+  }
+
+  for (u32 i = 0; i < 4; i++)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(acc) + i, acc_vec[i]);
+}
+
+static void ScrambleSSE2(u64* acc, const u8* secret)
+{
+  const __m128i prime32 = _mm_set1_epi32(static_cast<int>(PRIME32_1));
+  for (u32 i = 0; i < 4; i++)
+  {
+    __m128i acc_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc) + i);
+    acc_vec = _mm_xor_si128(acc_vec, _mm_srli_epi64(acc_vec, 47));
+    const __m128i key = _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i);
+    const __m128i data_key = _mm_xor_si128(acc_vec, key);
+    const __m128i data_key_hi = _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+    const __m128i product_lo = _mm_mul_epu32(data_key, prime32);
+    const __m128i product_hi = _mm_mul_epu32(data_key_hi, prime32);
+    acc_vec = _mm_add_epi64(product_lo, _mm_slli_epi64(product_hi, 32));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(acc) + i, acc_vec);
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void AccumulateAVX2(u64* acc, const u8* input, const u8* secret, u32 stripes,
+                           size_t stride)
+{
+  __m256i acc_vec[2];
+  for (u32 i = 0; i < 2; i++)
+    acc_vec[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc) + i);
+
+  for (u32 n = 0; n < stripes; n++)
+  {
+    const __m256i* stripe = reinterpret_cast<const __m256i*>(input + n * stride);
+    const __m256i* key = reinterpret_cast<const __m256i*>(secret + n * SECRET_CONSUME_RATE);
+    for (u32 i = 0; i < 2; i++)
+    {
+      const __m256i data_vec = _mm256_loadu_si256(stripe + i);
+      const __m256i data_key = _mm256_xor_si256(data_vec, _mm256_loadu_si256(key + i));
+      const __m256i data_key_hi = _mm256_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+      const __m256i product = _mm256_mul_epu32(data_key, data_key_hi);
+      const __m256i data_swap = _mm256_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+      acc_vec[i] = _mm256_add_epi64(product, _mm256_add_epi64(acc_vec[i], data_swap));
+    }
+  }
+
+  for (u32 i = 0; i < 2; i++)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc) + i, acc_vec[i]);
+}
+
+FUNCTION_TARGET_AVX2
+static void ScrambleAVX2(u64* acc, const u8* secret)
+{
+  const __m256i prime32 = _mm256_set1_epi32(static_cast<int>(PRIME32_1));
+  for (u32 i = 0; i < 2; i++)
+  {
+    __m256i acc_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc) + i);
+    acc_vec = _mm256_xor_si256(acc_vec, _mm256_srli_epi64(acc_vec, 47));
+    const __m256i key = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i);
+    const __m256i data_key = _mm256_xor_si256(acc_vec, key);
+    const __m256i data_key_hi = _mm256_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+    const __m256i product_lo = _mm256_mul_epu32(data_key, prime32);
+    const __m256i product_hi = _mm256_mul_epu32(data_key_hi, prime32);
+    acc_vec = _mm256_add_epi64(product_lo, _mm256_slli_epi64(product_hi, 32));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc) + i, acc_vec);
+  }
+}
+
+#elif defined(_M_ARM_64)
+
+static void AccumulateNEON(u64* acc, const u8* input, const u8* secret, u32 stripes,
+                           size_t stride)
+{
+  uint64x2_t acc_vec[4];
+  for (u32 i = 0; i < 4; i++)
+    acc_vec[i] = vld1q_u64(acc + 2 * i);
+
+  for (u32 n = 0; n < stripes; n++)
+  {
+    const u8* stripe = input + n * stride;
+    const u8* key = secret + n * SECRET_CONSUME_RATE;
+    for (u32 i = 0; i < 4; i++)
+    {
+      const uint64x2_t data_vec = vreinterpretq_u64_u8(vld1q_u8(stripe + 16 * i));
+      const uint64x2_t key_vec = vreinterpretq_u64_u8(vld1q_u8(key + 16 * i));
+      const uint64x2_t data_key = veorq_u64(data_vec, key_vec);
+      acc_vec[i] = vaddq_u64(acc_vec[i], vextq_u64(data_vec, data_vec, 1));
+      acc_vec[i] = vmlal_u32(acc_vec[i], vmovn_u64(data_key), vshrn_n_u64(data_key, 32));
+    }
+  }
+
+  for (u32 i = 0; i < 4; i++)
+    vst1q_u64(acc + 2 * i, acc_vec[i]);
+}
+
+static void ScrambleNEON(u64* acc, const u8* secret)
+{
+  const uint32x2_t prime32 = vdup_n_u32(PRIME32_1);
+  for (u32 i = 0; i < 4; i++)
+  {
+    uint64x2_t acc_vec = vld1q_u64(acc + 2 * i);
+    acc_vec = veorq_u64(acc_vec, vshrq_n_u64(acc_vec, 47));
+    const uint64x2_t key = vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i));
+    const uint64x2_t data_key = veorq_u64(acc_vec, key);
+    const uint64x2_t product_hi = vshlq_n_u64(vmull_u32(vshrn_n_u64(data_key, 32), prime32), 32);
+    vst1q_u64(acc + 2 * i, vmlal_u32(product_hi, vmovn_u64(data_key), prime32));
+  }
+}
+
+#endif
+
+constexpr Kernel KERNEL_SCALAR = {AccumulateScalar, ScrambleScalar};
+#if defined(_M_X86)
+constexpr Kernel KERNEL_SSE2 = {AccumulateSSE2, ScrambleSSE2};
+constexpr Kernel KERNEL_AVX2 = {AccumulateAVX2, ScrambleAVX2};
+#elif defined(_M_ARM_64)
+constexpr Kernel KERNEL_NEON = {AccumulateNEON, ScrambleNEON};
+#endif
+
+static const Kernel* s_kernel = &KERNEL_SCALAR;
+
+static u64 MergeAccumulators(const u64* acc, u64 start)
+{
+  constexpr u32 MERGE_OFFSET = 11;
+  u64 result = start;
+  for (u32 i = 0; i < 4; i++)
+  {
+    const u8* secret = SECRET + MERGE_OFFSET + 16 * i;
+    result += Mul128Fold64(acc[2 * i] ^ Read64(secret), acc[2 * i + 1] ^ Read64(secret + 8));
+  }
+  return Avalanche(result);
+}
+
+// Hashes an input longer than MIDSIZE_MAX. Every step-th stripe is accumulated, with the same
+// scrambling after each group of STRIPES_PER_BLOCK stripes that XXH3 does after each block, so a
+// step of 1 gives the exact XXH3 hash.
+//
+// If checkpoints is not null, step must be 1. Hashing starts from the checkpoint at
+// first_checkpoint, and the state is saved whenever a multiple of HASH64_CHECKPOINT_INTERVAL
+// bytes has been processed.
+static u64 HashLong(const Kernel& kernel, const u8* input, u32 len, u32 step,
+                    std::vector<Hash64Checkpoint>* checkpoints, u32 first_checkpoint)
+{
+  constexpr u32 BLOCKS_PER_CHECKPOINT = HASH64_CHECKPOINT_INTERVAL / BLOCK_SIZE;
+
+  // The last stripe always ends at the end of the input, and is hashed separately.
+  const u32 total_stripes = ((len - 1) / STRIPE_SIZE + step - 1) / step;
+  const u32 full_blocks = total_stripes / STRIPES_PER_BLOCK;
+  const size_t stride = size_t(STRIPE_SIZE) * step;
+  const size_t block_stride = stride * STRIPES_PER_BLOCK;
+
+  Hash64Checkpoint acc = INITIAL_ACC;
+  u32 block = 0;
+  if (checkpoints)
+  {
+    checkpoints->resize(full_blocks / BLOCKS_PER_CHECKPOINT + 1);
+    first_checkpoint = std::min<u32>(first_checkpoint, static_cast<u32>(checkpoints->size() - 1));
+    if (first_checkpoint == 0)
+      (*checkpoints)[0] = INITIAL_ACC;
+    acc = (*checkpoints)[first_checkpoint];
+    block = first_checkpoint * BLOCKS_PER_CHECKPOINT;
+  }
+
+  for (; block < full_blocks; block++)
+  {
+    kernel.accumulate(acc.data(), input + block * block_stride, SECRET, STRIPES_PER_BLOCK, stride);
+    kernel.scramble(acc.data(), SECRET + SECRET_SIZE - STRIPE_SIZE);
+    if (checkpoints && (block + 1) % BLOCKS_PER_CHECKPOINT == 0)
+      (*checkpoints)[(block + 1) / BLOCKS_PER_CHECKPOINT] = acc;
+  }
+
+  kernel.accumulate(acc.data(), input + full_blocks * block_stride, SECRET,
+                    total_stripes - full_blocks * STRIPES_PER_BLOCK, stride);
+
+  constexpr u32 LAST_STRIPE_OFFSET = 7;
+  kernel.accumulate(acc.data(), input + len - STRIPE_SIZE,
+                    SECRET + SECRET_SIZE - STRIPE_SIZE - LAST_STRIPE_OFFSET, 1, STRIPE_SIZE);
+
+  return MergeAccumulators(acc.data(), len * PRIME64_1);
+}
+
+static u64 Hash(const Kernel& kernel, const u8* src, u32 len, u32 samples)
+{
+  if (len <= 16)
+    return Hash0To16(src, len);
+  if (len <= 128)
+    return Hash17To128(src, len);
+  if (len <= MIDSIZE_MAX)
+    return Hash129To240(src, len);
+
+  u32 step = 1;
+  if (samples != 0)
+    step = std::max((len - 1) / STRIPE_SIZE / samples, 1u);
+  return HashLong(kernel, src, len, step, nullptr, 0);
+}
+}  // namespace XXH3
+
+static u64 GetXXH3(const u8* src, u32 len, u32 samples)
+{
+  return XXH3::Hash(*XXH3::s_kernel, src, len, samples);
+}
+
+static u64 GetXXH3Scalar(const u8* src, u32 len, u32 samples)
+{
+  return XXH3::Hash(XXH3::KERNEL_SCALAR, src, len, samples);
+}
+
+#if defined(_M_X86)
+static u64 GetXXH3SSE2(const u8* src, u32 len, u32 samples)
+{
+  return XXH3::Hash(XXH3::KERNEL_SSE2, src, len, samples);
+}
+
+static u64 GetXXH3AVX2(const u8* src, u32 len, u32 samples)
+{
+  return XXH3::Hash(XXH3::KERNEL_AVX2, src, len, samples);
+}
+#elif defined(_M_ARM_64)
+static u64 GetXXH3NEON(const u8* src, u32 len, u32 samples)
+{
+  return XXH3::Hash(XXH3::KERNEL_NEON, src, len, samples);
+}
+#endif
+
+// Revisions stored by GetHash64Revision. Only ever add new ones.
+enum : u32
+{
+  HASH64_REVISION_CRC32 = 1,
+  HASH64_REVISION_MURMURHASH3 = 2,
+  HASH64_REVISION_XXH3 = 3,
+};
+
+static Hash64Mode s_hash64_mode = Hash64Mode::Legacy;
+static u32 s_hash64_revision = 0;
+
 u64 GetHash64(const u8* src, u32 len, u32 samples)
 {
   return ptrHashFunction(src, len, samples);
 }
 
-// sets the hash function used for the texture cache
-void SetHash64Function()
+static bool HasCRC32()
 {
 #if defined(_M_X86_64) || defined(_M_X86)
-  if (cpu_info.bSSE4_2)  // sse crc32 version
+  return cpu_info.bSSE4_2;
+#elif defined(_M_ARM_64)
+  return cpu_info.bCRC32;
+#else
+  return false;
+#endif
+}
+
+// sets the hash function used for the texture cache
+void SetHash64Function(Hash64Mode mode)
+{
+  s_hash64_mode = mode;
+
+  if (mode == Hash64Mode::XXH3)
   {
-    ptrHashFunction = &GetCRC32;
-  }
-  else
+#if defined(_M_X86)
+    XXH3::s_kernel = cpu_info.bAVX2 ? &XXH3::KERNEL_AVX2 : &XXH3::KERNEL_SSE2;
 #elif defined(_M_ARM_64)
-  if (cpu_info.bCRC32)
+    XXH3::s_kernel = &XXH3::KERNEL_NEON;
+#else
+    XXH3::s_kernel = &XXH3::KERNEL_SCALAR;
+#endif
+    ptrHashFunction = &GetXXH3;
+    s_hash64_revision = HASH64_REVISION_XXH3;
+  }
+  else if (HasCRC32())
   {
     ptrHashFunction = &GetCRC32;
+    s_hash64_revision = HASH64_REVISION_CRC32;
   }
   else
-#endif
   {
     ptrHashFunction = &GetMurmurHash3;
+    s_hash64_revision = HASH64_REVISION_MURMURHASH3;
   }
 }
+
+Hash64Mode GetHash64Mode()
+{
+  return s_hash64_mode;
+}
+
+u32 GetHash64Revision()
+{
+  return s_hash64_revision;
+}
+
+bool CanHash64Incrementally(u32 len, u32 samples)
+{
+  return s_hash64_mode == Hash64Mode::XXH3 && samples == 0 && len > HASH64_CHECKPOINT_INTERVAL;
+}
+
+u64 GetHash64Incremental(const u8* src, u32 len, u32 resume_offset,
+                         std::vector<Hash64Checkpoint>* checkpoints)
+{
+  if (len <= XXH3::MIDSIZE_MAX)
+  {
+    checkpoints->clear();
+    return GetXXH3(src, len, 0);
+  }
+
+  return XXH3::HashLong(*XXH3::s_kernel, src, len, 1, checkpoints,
+                        resume_offset / HASH64_CHECKPOINT_INTERVAL);
+}
+
+std::vector<Hash64Implementation> GetHash64Implementations()
+{
+  std::vector<Hash64Implementation> implementations;
+  if (HasCRC32())
+    implementations.push_back({"CRC32", Hash64Mode::Legacy, HASH64_REVISION_CRC32, GetCRC32});
+  implementations.push_back(
+      {"MurmurHash3", Hash64Mode::Legacy, HASH64_REVISION_MURMURHASH3, GetMurmurHash3});
+  implementations.push_back(
+      {"XXH3 (scalar)", Hash64Mode::XXH3, HASH64_REVISION_XXH3, GetXXH3Scalar});
+#if defined(_M_X86)
+  implementations.push_back({"XXH3 (SSE2)", Hash64Mode::XXH3, HASH64_REVISION_XXH3, GetXXH3SSE2});
+  if (cpu_info.bAVX2)
+  {
+    implementations.push_back(
+        {"XXH3 (AVX2)", Hash64Mode::XXH3, HASH64_REVISION_XXH3, GetXXH3AVX2});
+  }
+#elif defined(_M_ARM_64)
+  implementations.push_back({"XXH3 (NEON)", Hash64Mode::XXH3, HASH64_REVISION_XXH3, GetXXH3NEON});
+#endif
+  return implementations;
+}
 }  // namespace Common
@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 
@@ -13,6 +15,44 @@ namespace Common
 u32 HashFletcher(const u8* data_u8, size_t length);  // FAST. Length & 1 == 0.
 u32 HashAdler32(const u8* data, size_t len);         // Fairly accurate, slightly slower
 u32 HashEctor(const u8* ptr, int length);            // JUNK. DO NOT USE FOR NEW THINGS
+
+enum class Hash64Mode
+{
+  // CRC32 if the CPU has instructions for it, MurmurHash3 otherwise.
+  Legacy,
+  // XXH3-64 with the default secret and a seed of 0, using SSE2, AVX2 or NEON when available.
+  // With samples != 0, only evenly spaced 64-byte stripes of the input are hashed.
+  XXH3,
+};
+
 u64 GetHash64(const u8* src, u32 len, u32 samples);
-void SetHash64Function();
+void SetHash64Function(Hash64Mode mode = Hash64Mode::Legacy);
+Hash64Mode GetHash64Mode();
+// Identifies the function used by GetHash64. Hashes from a different revision can't be compared
+// with the ones calculated now.
+u32 GetHash64Revision();
+
+// Incremental hashing for buffers of which only a part changes. The hash state is saved every
+// HASH64_CHECKPOINT_INTERVAL bytes, and hashing can be resumed from any of those checkpoints.
+// Only possible in the XXH3 mode without sampling.
+constexpr u32 HASH64_CHECKPOINT_INTERVAL = 4096;
+using Hash64Checkpoint = std::array<u64, 8>;
+
+bool CanHash64Incrementally(u32 len, u32 samples);
+// Returns the same value as GetHash64(src, len, 0). The data before resume_offset, which is
+// rounded down to a multiple of HASH64_CHECKPOINT_INTERVAL, is not read again if checkpoints
+// holds the states from an earlier call with the same length. The checkpoints after it are
+// replaced.
+u64 GetHash64Incremental(const u8* src, u32 len, u32 resume_offset,
+                         std::vector<Hash64Checkpoint>* checkpoints);
+
+// All the functions GetHash64 can use on this CPU, for tests and benchmarks.
+struct Hash64Implementation
+{
+  const char* name;
+  Hash64Mode mode;
+  u32 revision;
+  u64 (*function)(const u8* src, u32 len, u32 samples);
+};
+std::vector<Hash64Implementation> GetHash64Implementations();
 }  // namespace Common
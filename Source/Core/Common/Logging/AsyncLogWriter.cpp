@@ -0,0 +1,645 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/Logging/AsyncLogWriter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include <fmt/format.h>
+
+#include "Common/StringUtil.h"
+#include "Common/Thread.h"
+
+namespace Common::Log
+{
+namespace
+{
+constexpr size_t MAX_MSGLEN = 1024;
+constexpr size_t MAX_SPEC_LENGTH = 16;
+
+std::atomic<u64> s_next_writer_id{1};
+
+enum class Length
+{
+  Default,
+  Char,
+  Short,
+  Long,
+  LongLong,
+  IntMax,
+  Size,
+  PtrDiff,
+  LongDouble,
+};
+
+// A printf conversion specification, without the leading '%'.
+struct Conversion
+{
+  // Flags, width and precision, which are passed on as they are when formatting.
+  const char* spec;
+  size_t spec_size;
+  int star_count;
+  bool star_precision;
+  // -1 if there is no precision or if it is passed as an argument.
+  int precision;
+  Length length;
+  char specifier;
+  const char* end;
+};
+
+// Returns false for anything that the compact encoding doesn't handle, such as wide strings,
+// long doubles and %n. Those messages are formatted on the logging thread instead.
+bool ParseConversion(const char* p, Conversion* conversion)
+{
+  conversion->spec = p;
+  conversion->star_count = 0;
+  conversion->star_precision = false;
+  conversion->precision = -1;
+
+  while (*p && std::strchr("-+ #0", *p))
+    ++p;
+
+  if (*p == '*')
+  {
+    ++conversion->star_count;
+    ++p;
+  }
+  while (*p >= '0' && *p <= '9')
+    ++p;
+
+  if (*p == '.')
+  {
+    ++p;
+    if (*p == '*')
+    {
+      ++conversion->star_count;
+      conversion->star_precision = true;
+      ++p;
+    }
+    else
+    {
+      conversion->precision = 0;
+      while (*p >= '0' && *p <= '9')
+        conversion->precision = conversion->precision * 10 + (*p++ - '0');
+    }
+  }
+
+  conversion->spec_size = p - conversion->spec;
+  if (conversion->spec_size > MAX_SPEC_LENGTH)
+    return false;
+
+  switch (*p)
+  {
+  case 'h':
+    conversion->length = p[1] == 'h' ? Length::Char : Length::Short;
+    p += p[1] == 'h' ? 2 : 1;
+    break;
+  case 'l':
+    conversion->length = p[1] == 'l' ? Length::LongLong : Length::Long;
+    p += p[1] == 'l' ? 2 : 1;
+    break;
+  case 'j':
+    conversion->length = Length::IntMax;
+    ++p;
+    break;
+  case 'z':
+    conversion->length = Length::Size;
+    ++p;
+    break;
+  case 't':
+    conversion->length = Length::PtrDiff;
+    ++p;
+    break;
+  case 'L':
+    conversion->length = Length::LongDouble;
+    ++p;
+    break;
+  default:
+    conversion->length = Length::Default;
+    break;
+  }
+
+  conversion->specifier = *p;
+  conversion->end = p + 1;
+
+  switch (conversion->specifier)
+  {
+  case 'd':
+  case 'i':
+  case 'o':
+  case 'u':
+  case 'x':
+  case 'X':
+    return conversion->length != Length::LongDouble;
+  case 'e':
+  case 'E':
+  case 'f':
+  case 'F':
+  case 'g':
+  case 'G':
+  case 'a':
+  case 'A':
+    return conversion->length == Length::Default || conversion->length == Length::Long;
+  case 'c':
+  case 's':
+  case 'p':
+    return conversion->length == Length::Default;
+  default:
+    return false;
+  }
+}
+
+class ArgumentWriter
+{
+public:
+  ArgumentWriter(u8* data, size_t capacity) : m_data(data), m_capacity(capacity) {}
+
+  template <typename T>
+  bool Write(const T& value)
+  {
+    if (m_size + sizeof(T) > m_capacity)
+      return false;
+    std::memcpy(m_data + m_size, &value, sizeof(T));
+    m_size += sizeof(T);
+    return true;
+  }
+
+  bool WriteString(const char* str, size_t length)
+  {
+    if (m_size + length + 1 > m_capacity)
+      return false;
+    std::memcpy(m_data + m_size, str, length);
+    m_data[m_size + length] = 0;
+    m_size += length + 1;
+    return true;
+  }
+
+  size_t GetSize() const { return m_size; }
+
+private:
+  u8* m_data;
+  size_t m_capacity;
+  size_t m_size = 0;
+};
+
+class ArgumentReader
+{
+public:
+  explicit ArgumentReader(const u8* data) : m_data(data) {}
+
+  template <typename T>
+  T Read()
+  {
+    T value;
+    std::memcpy(&value, m_data + m_offset, sizeof(T));
+    m_offset += sizeof(T);
+    return value;
+  }
+
+  const char* ReadString()
+  {
+    const char* str = reinterpret_cast<const char*>(m_data + m_offset);
+    m_offset += std::strlen(str) + 1;
+    return str;
+  }
+
+private:
+  const u8* m_data;
+  size_t m_offset = 0;
+};
+
+bool EncodeArguments(const char* format, va_list args, u8* data, size_t capacity, u16* size)
+{
+  ArgumentWriter writer(data, capacity);
+
+  for (const char* p = format; *p; ++p)
+  {
+    if (*p != '%')
+      continue;
+    if (p[1] == '%')
+    {
+      ++p;
+      continue;
+    }
+
+    Conversion conversion;
+    if (!ParseConversion(p + 1, &conversion))
+      return false;
+    p = conversion.end - 1;
+
+    int precision = conversion.precision;
+    for (int i = 0; i < conversion.star_count; ++i)
+    {
+      const int value = va_arg(args, int);
+      if (!writer.Write(value))
+        return false;
+      if (conversion.star_precision && i == conversion.star_count - 1)
+        precision = value;
+    }
+
+    bool written;
+    switch (conversion.specifier)
+    {
+    case 'd':
+    case 'i':
+    {
+      s64 value;
+      switch (conversion.length)
+      {
+      case Length::Char:
+        value = static_cast<signed char>(va_arg(args, int));
+        break;
+      case Length::Short:
+        value = static_cast<short>(va_arg(args, int));
+        break;
+      case Length::Long:
+        value = va_arg(args, long);
+        break;
+      case Length::LongLong:
+        value = va_arg(args, long long);
+        break;
+      case Length::IntMax:
+        value = va_arg(args, intmax_t);
+        break;
+      case Length::Size:
+        value = va_arg(args, std::make_signed_t<size_t>);
+        break;
+      case Length::PtrDiff:
+        value = va_arg(args, ptrdiff_t);
+        break;
+      default:
+        value = va_arg(args, int);
+        break;
+      }
+      written = writer.Write(value);
+      break;
+    }
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X':
+    {
+      u64 value;
+      switch (conversion.length)
+      {
+      case Length::Char:
+        value = static_cast<unsigned char>(va_arg(args, unsigned int));
+        break;
+      case Length::Short:
+        value = static_cast<unsigned short>(va_arg(args, unsigned int));
+        break;
+      case Length::Long:
+        value = va_arg(args, unsigned long);
+        break;
+      case Length::LongLong:
+        value = va_arg(args, unsigned long long);
+        break;
+      case Length::IntMax:
+        value = va_arg(args, uintmax_t);
+        break;
+      case Length::Size:
+        value = va_arg(args, size_t);
+        break;
+      case Length::PtrDiff:
+        value = static_cast<std::make_unsigned_t<ptrdiff_t>>(va_arg(args, ptrdiff_t));
+        break;
+      default:
+        value = va_arg(args, unsigned int);
+        break;
+      }
+      written = writer.Write(value);
+      break;
+    }
+    case 'c':
+      written = writer.Write(va_arg(args, int));
+      break;
+    case 'p':
+      written = writer.Write(va_arg(args, void*));
+      break;
+    case 's':
+    {
+      const char* str = va_arg(args, const char*);
+      if (!str)
+        str = "(null)";
+      // With a precision, the string does not have to be null-terminated.
+      const size_t length = precision >= 0 ? strnlen(str, precision) : std::strlen(str);
+      written = writer.WriteString(str, length);
+      break;
+    }
+    default:
+      written = writer.Write(va_arg(args, double));
+      break;
+    }
+
+    if (!written)
+      return false;
+  }
+
+  *size = static_cast<u16>(writer.GetSize());
+  return true;
+}
+
+void FormatArgumentV(char* out, size_t size, const char* spec, ...)
+{
+  va_list args;
+  va_start(args, spec);
+  CharArrayFromFormatV(out, static_cast<int>(size), spec, args);
+  va_end(args);
+}
+
+template <typename T>
+void FormatArgument(char* out, size_t size, const char* spec, const int* stars, int star_count,
+                    T value)
+{
+  switch (star_count)
+  {
+  case 0:
+    FormatArgumentV(out, size, spec, value);
+    break;
+  case 1:
+    FormatArgumentV(out, size, spec, stars[0], value);
+    break;
+  default:
+    FormatArgumentV(out, size, spec, stars[0], stars[1], value);
+    break;
+  }
+}
+
+void DecodeMessage(const char* format, const u8* data, char* out, size_t out_size)
+{
+  ArgumentReader reader(data);
+  size_t out_pos = 0;
+  const auto append = [&](const char* str, size_t length) {
+    length = std::min(length, out_size - 1 - out_pos);
+    std::memcpy(out + out_pos, str, length);
+    out_pos += length;
+  };
+
+  const char* p = format;
+  while (*p)
+  {
+    const char* literal_end = std::strchr(p, '%');
+    if (!literal_end)
+      literal_end = p + std::strlen(p);
+    append(p, literal_end - p);
+    p = literal_end;
+    if (!*p)
+      break;
+
+    if (p[1] == '%')
+    {
+      append("%", 1);
+      p += 2;
+      continue;
+    }
+
+    // This cannot fail, since the message was only encoded if all conversions could be parsed.
+    Conversion conversion;
+    ParseConversion(p + 1, &conversion);
+    p = conversion.end;
+
+    std::array<int, 2> stars{};
+    for (int i = 0; i < conversion.star_count; ++i)
+      stars[i] = reader.Read<int>();
+
+    const bool is_integer = std::strchr("diouxX", conversion.specifier) != nullptr;
+    char spec[MAX_SPEC_LENGTH + 5];
+    size_t spec_size = 0;
+    spec[spec_size++] = '%';
+    std::memcpy(spec + spec_size, conversion.spec, conversion.spec_size);
+    spec_size += conversion.spec_size;
+    if (is_integer)
+    {
+      // Integers were widened to 64 bits when they were encoded.
+      spec[spec_size++] = 'l';
+      spec[spec_size++] = 'l';
+    }
+    spec[spec_size++] = conversion.specifier;
+    spec[spec_size] = 0;
+
+    char piece[MAX_MSGLEN];
+    switch (conversion.specifier)
+    {
+    case 'd':
+    case 'i':
+      FormatArgument(piece, sizeof(piece), spec, stars.data(), conversion.star_count,
+                     static_cast<long long>(reader.Read<s64>()));
+      break;
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X':
+      FormatArgument(piece, sizeof(piece), spec, stars.data(), conversion.star_count,
+                     static_cast<unsigned long long>(reader.Read<u64>()));
+      break;
+    case 'c':
+      FormatArgument(piece, sizeof(piece), spec, stars.data(), conversion.star_count,
+                     reader.Read<int>());
+      break;
+    case 'p':
+      FormatArgument(piece, sizeof(piece), spec, stars.data(), conversion.star_count,
+                     reader.Read<void*>());
+      break;
+    case 's':
+      FormatArgument(piece, sizeof(piece), spec, stars.data(), conversion.star_count,
+                     reader.ReadString());
+      break;
+    default:
+      FormatArgument(piece, sizeof(piece), spec, stars.data(), conversion.star_count,
+                     reader.Read<double>());
+      break;
+    }
+    append(piece, std::strlen(piece));
+  }
+
+  out[out_pos] = 0;
+}
+
+u64 GetTimestampMs()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+AsyncLogWriter::AsyncLogWriter(Callback callback)
+    : m_callback(std::move(callback)), m_id(s_next_writer_id++)
+{
+  m_running.Set();
+  m_thread = std::thread(&AsyncLogWriter::WriterThread, this);
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+  m_running.Clear();
+  m_wakeup.Set();
+  m_thread.join();
+}
+
+void AsyncLogWriter::Push(LOG_LEVELS level, LOG_TYPE type, const char* file, int line,
+                          const char* format, va_list args)
+{
+  Ring& ring = GetThreadRing();
+  const u32 write_index = ring.write_index.load(std::memory_order_relaxed);
+  const u32 free_records =
+      RING_SIZE - (write_index - ring.read_index.load(std::memory_order_acquire));
+  if (free_records == 0)
+  {
+    ring.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  Record& record = ring.records[write_index % RING_SIZE];
+  record.timestamp_ms = GetTimestampMs();
+  record.file = file;
+  record.line = line;
+  record.level = static_cast<u8>(level);
+  record.type = static_cast<u8>(type);
+
+  va_list args_copy;
+  va_copy(args_copy, args);
+  const bool encoded =
+      EncodeArguments(format, args_copy, record.args.data(), record.args.size(), &record.args_size);
+  va_end(args_copy);
+
+  if (encoded)
+  {
+    record.format = format;
+    ring.write_index.store(write_index + 1, std::memory_order_release);
+    return;
+  }
+
+  // Preformatted text that doesn't fit a single record continues in the args of the records
+  // that follow it.
+  char text[MAX_MSGLEN];
+  CharArrayFromFormatV(text, sizeof(text), format, args);
+  const size_t text_size = std::strlen(text) + 1;
+  const u32 record_count =
+      static_cast<u32>((text_size + record.args.size() - 1) / record.args.size());
+  if (record_count > free_records)
+  {
+    ring.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  record.format = nullptr;
+  record.args_size = static_cast<u16>(text_size);
+  for (u32 i = 0; i < record_count; ++i)
+  {
+    const size_t offset = i * record.args.size();
+    std::memcpy(ring.records[(write_index + i) % RING_SIZE].args.data(), text + offset,
+                std::min(record.args.size(), text_size - offset));
+  }
+
+  ring.write_index.store(write_index + record_count, std::memory_order_release);
+}
+
+u64 AsyncLogWriter::GetDroppedCount() const
+{
+  return m_total_dropped.load(std::memory_order_relaxed);
+}
+
+AsyncLogWriter::Ring& AsyncLogWriter::GetThreadRing()
+{
+  // The id makes sure a thread that outlives a writer doesn't keep using a ring that the next
+  // writer doesn't know about.
+  thread_local u64 t_writer_id = 0;
+  thread_local std::shared_ptr<Ring> t_ring;
+
+  if (t_writer_id != m_id)
+  {
+    t_ring = std::make_shared<Ring>();
+    t_writer_id = m_id;
+
+    std::lock_guard lk(m_rings_lock);
+    m_rings.push_back(t_ring);
+  }
+
+  return *t_ring;
+}
+
+void AsyncLogWriter::WriterThread()
+{
+  Common::SetCurrentThreadName("Log writer");
+
+  while (m_running.IsSet())
+  {
+    m_wakeup.WaitFor(std::chrono::milliseconds(10));
+    Drain();
+  }
+
+  Drain();
+}
+
+void AsyncLogWriter::Drain()
+{
+  std::vector<std::shared_ptr<Ring>> rings;
+  {
+    std::lock_guard lk(m_rings_lock);
+    rings = m_rings;
+  }
+
+  for (const auto& ring : rings)
+    DrainRing(*ring);
+  rings.clear();
+
+  // Forget about rings of threads that have exited once everything they logged has been written.
+  std::lock_guard lk(m_rings_lock);
+  m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(),
+                               [](const std::shared_ptr<Ring>& ring) {
+                                 return ring.use_count() == 1 &&
+                                        ring->read_index.load() == ring->write_index.load();
+                               }),
+                m_rings.end());
+}
+
+void AsyncLogWriter::DrainRing(Ring& ring)
+{
+  const u32 write_index = ring.write_index.load(std::memory_order_acquire);
+  for (u32 read_index = ring.read_index.load(std::memory_order_relaxed); read_index != write_index;
+       ++read_index)
+  {
+    const Record& record = ring.records[read_index % RING_SIZE];
+
+    char text[MAX_MSGLEN];
+    u32 last_index = read_index;
+    if (record.format)
+    {
+      DecodeMessage(record.format, record.args.data(), text, sizeof(text));
+    }
+    else
+    {
+      // Long preformatted text continues in the following records.
+      for (size_t offset = 0; offset < record.args_size; offset += record.args.size())
+      {
+        const Record& part = ring.records[last_index++ % RING_SIZE];
+        std::memcpy(text + offset, part.args.data(),
+                    std::min(record.args.size(), record.args_size - offset));
+      }
+      --last_index;
+    }
+
+    m_callback({record.timestamp_ms, record.file, record.line,
+                static_cast<LOG_LEVELS>(record.level), static_cast<LOG_TYPE>(record.type), text});
+    read_index = last_index;
+    ring.read_index.store(read_index + 1, std::memory_order_release);
+  }
+
+  const u64 dropped = ring.dropped.exchange(0, std::memory_order_relaxed);
+  if (dropped != 0)
+  {
+    m_total_dropped.fetch_add(dropped, std::memory_order_relaxed);
+    const std::string text =
+        fmt::format("{} log messages were dropped because the log buffer was full", dropped);
+    m_callback({GetTimestampMs(), nullptr, 0, LWARNING, COMMON, text.c_str()});
+  }
+}
+}  // namespace Common::Log
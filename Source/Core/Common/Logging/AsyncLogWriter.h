@@ -0,0 +1,106 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdarg>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+#include "Common/Logging/Log.h"
+
+namespace Common::Log
+{
+// Moves the cost of formatting and writing log messages off the threads that log them.
+//
+// Each logging thread gets its own ring of fixed-size records. A record holds the timestamp,
+// the file, line, level and type, a pointer to the format string and the raw arguments, so
+// pushing one only has to walk the format string to find out how many bytes to copy. A writer
+// thread drains the rings, formats the messages and hands them to the callback. When a ring is
+// full, the message is dropped and counted instead of blocking the logging thread.
+//
+// The format and file strings are not copied, so they must outlive the writer. This is the case
+// for the string literals passed through the logging macros.
+class AsyncLogWriter
+{
+public:
+  struct Message
+  {
+    u64 timestamp_ms;
+    // nullptr for messages from the writer itself.
+    const char* file;
+    int line;
+    LOG_LEVELS level;
+    LOG_TYPE type;
+    const char* text;
+  };
+
+  using Callback = std::function<void(const Message& message)>;
+
+  explicit AsyncLogWriter(Callback callback);
+  ~AsyncLogWriter();
+
+  AsyncLogWriter(const AsyncLogWriter&) = delete;
+  AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+  void Push(LOG_LEVELS level, LOG_TYPE type, const char* file, int line, const char* format,
+            va_list args);
+
+  // Total number of messages dropped because a ring was full.
+  u64 GetDroppedCount() const;
+
+private:
+  static constexpr size_t RECORD_SIZE = 512;
+  static constexpr u32 RING_SIZE = 512;
+
+  struct Record
+  {
+    u64 timestamp_ms;
+    const char* file;
+    // nullptr if the message did not fit the compact encoding and the arguments hold the
+    // already formatted message instead. args_size is then the size of the text, which continues
+    // in the arguments of the following records if it is longer than one record's arguments.
+    const char* format;
+    s32 line;
+    u8 level;
+    u8 type;
+    u16 args_size;
+    std::array<u8, RECORD_SIZE - 32> args;
+  };
+  static_assert(sizeof(Record) <= RECORD_SIZE);
+
+  // Single producer, single consumer.
+  struct Ring
+  {
+    std::array<Record, RING_SIZE> records;
+    alignas(64) std::atomic<u32> write_index{0};
+    alignas(64) std::atomic<u32> read_index{0};
+    std::atomic<u64> dropped{0};
+  };
+
+  Ring& GetThreadRing();
+  void WriterThread();
+  void Drain();
+  void DrainRing(Ring& ring);
+
+  Callback m_callback;
+  const u64 m_id;
+
+  std::mutex m_rings_lock;
+  std::vector<std::shared_ptr<Ring>> m_rings;
+
+  std::atomic<u64> m_total_dropped{0};
+  Common::Flag m_running;
+  Common::Event m_wakeup;
+  std::thread m_thread;
+};
+}  // namespace Common::Log
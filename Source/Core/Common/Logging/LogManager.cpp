@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cstdarg>
 #include <cstring>
+#include <ctime>
 #include <locale>
 #include <mutex>
 #include <ostream>
@@ -17,6 +18,7 @@
 #include "Common/CommonPaths.h"
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
+#include "Common/Logging/AsyncLogWriter.h"
 #include "Common/Logging/ConsoleListener.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
@@ -33,6 +35,7 @@ const Config::Info<bool> LOGGER_WRITE_TO_CONSOLE{
 const Config::Info<bool> LOGGER_WRITE_TO_WINDOW{
     {Config::System::Logger, "Options", "WriteToWindow"}, true};
 const Config::Info<int> LOGGER_VERBOSITY{{Config::System::Logger, "Options", "Verbosity"}, 0};
+const Config::Info<bool> LOGGER_ASYNC{{Config::System::Logger, "Options", "Async"}, false};
 
 class FileLogListener : public LogListener
 {
@@ -90,6 +93,27 @@ static size_t DeterminePathCutOffPoint()
   return 0;
 }
 
+// Matches the format of Timer::GetTimeFormatted.
+static std::string FormatTimestamp(u64 timestamp_ms)
+{
+  const time_t seconds = static_cast<time_t>(timestamp_ms / 1000);
+  // Messages are formatted on the log writer thread, so the thread-safe variants are needed.
+  struct tm local_time;
+#ifdef _WIN32
+  const bool converted = localtime_s(&local_time, &seconds) == 0;
+#else
+  const bool converted = localtime_r(&seconds, &local_time) != nullptr;
+#endif
+  // Time zone offsets are whole minutes in practice, so the UTC values are a good fallback.
+  if (!converted)
+  {
+    local_time.tm_min = static_cast<int>(seconds / 60 % 60);
+    local_time.tm_sec = static_cast<int>(seconds % 60);
+  }
+  return fmt::format("{:02}:{:02}:{:03}", local_time.tm_min, local_time.tm_sec,
+                     timestamp_ms % 1000);
+}
+
 LogManager::LogManager()
 {
   // create log containers
@@ -166,10 +190,23 @@ LogManager::LogManager()
         Config::Info<bool>{{Config::System::Logger, "Logs", container.m_short_name}, false});
 
   m_path_cutoff_point = DeterminePathCutOffPoint();
+
+  // Formats and writes messages on a separate thread, so that verbose logging doesn't slow
+  // down the CPU and GPU threads as much.
+  if (Config::Get(LOGGER_ASYNC))
+  {
+    m_async_writer = std::make_unique<AsyncLogWriter>([this](const AsyncLogWriter::Message& msg) {
+      DispatchMessage(msg.level, msg.type, FormatTimestamp(msg.timestamp_ms), msg.file, msg.line,
+                      msg.text);
+    });
+  }
 }
 
 LogManager::~LogManager()
 {
+  // Write out whatever is still queued while the listeners are still around.
+  m_async_writer.reset();
+
   // The log window listener pointer is owned by the GUI code.
   delete m_listeners[LogListener::CONSOLE_LISTENER];
   delete m_listeners[LogListener::FILE_LISTENER];
@@ -198,6 +235,15 @@ void LogManager::SaveSettings()
 void LogManager::Log(LOG_LEVELS level, LOG_TYPE type, const char* file, int line,
                      const char* format, va_list args)
 {
+  if (m_async_writer)
+  {
+    if (!IsEnabled(type, level) || !static_cast<bool>(m_listener_ids))
+      return;
+
+    m_async_writer->Push(level, type, file + m_path_cutoff_point, line, format, args);
+    return;
+  }
+
   return LogWithFullPath(level, type, file + m_path_cutoff_point, line, format, args);
 }
 
@@ -210,9 +256,17 @@ void LogManager::LogWithFullPath(LOG_LEVELS level, LOG_TYPE type, const char* fi
   char temp[MAX_MSGLEN];
   CharArrayFromFormatV(temp, MAX_MSGLEN, format, args);
 
+  DispatchMessage(level, type, Common::Timer::GetTimeFormatted(), file, line, temp);
+}
+
+void LogManager::DispatchMessage(LOG_LEVELS level, LOG_TYPE type, const std::string& time,
+                                 const char* file, int line, const char* text)
+{
   const std::string msg =
-      fmt::format("{} {}:{} {}[{}]: {}\n", Common::Timer::GetTimeFormatted(), file, line,
-                  LOG_LEVEL_TO_CHAR[static_cast<int>(level)], GetShortName(type), temp);
+      file ? fmt::format("{} {}:{} {}[{}]: {}\n", time, file, line,
+                         LOG_LEVEL_TO_CHAR[static_cast<int>(level)], GetShortName(type), text) :
+             fmt::format("{} {}[{}]: {}\n", time, LOG_LEVEL_TO_CHAR[static_cast<int>(level)],
+                         GetShortName(type), text);
 
   for (auto listener_id : m_listener_ids)
     if (m_listeners[listener_id])
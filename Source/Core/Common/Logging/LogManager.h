@@ -6,12 +6,16 @@
 
 #include <array>
 #include <cstdarg>
+#include <memory>
+#include <string>
 
 #include "Common/BitSet.h"
 #include "Common/Logging/Log.h"
 
 namespace Common::Log
 {
+class AsyncLogWriter;
+
 // pure virtual interface
 class LogListener
 {
@@ -67,6 +71,9 @@ private:
   LogManager();
   ~LogManager();
 
+  void DispatchMessage(LOG_LEVELS level, LOG_TYPE type, const std::string& time, const char* file,
+                       int line, const char* text);
+
   LogManager(const LogManager&) = delete;
   LogManager& operator=(const LogManager&) = delete;
   LogManager(LogManager&&) = delete;
@@ -77,5 +84,6 @@ private:
   std::array<LogListener*, LogListener::NUMBER_OF_LISTENERS> m_listeners{};
   BitSet32 m_listener_ids;
   size_t m_path_cutoff_point = 0;
+  std::unique_ptr<AsyncLogWriter> m_async_writer;
 };
 }  // namespace Common::Log
@@ -9,6 +9,7 @@
 #include <string>
 
 #include "CommonTypes.h"
+#include "Common/Trace.h"
 
 namespace Common
 {
@@ -20,6 +21,8 @@ public:
 
   static std::string ToString();
 
+  const std::string& GetName() const { return m_name; }
+
   void Start();
   void Stop();
   std::string Read();
@@ -49,11 +52,13 @@ private:
 class ProfilerExecuter
 {
 public:
-  ProfilerExecuter(Profiler* _p) : m_p(_p) { m_p->Start(); }
+  ProfilerExecuter(Profiler* _p) : m_p(_p), m_trace(_p->GetName().c_str()) { m_p->Start(); }
   ~ProfilerExecuter() { m_p->Stop(); }
 
 private:
   Profiler* m_p;
+  // Profiled functions also show up in traces.
+  Trace::Scope m_trace;
 };
 };  // namespace Common
 
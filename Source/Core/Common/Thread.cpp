@@ -5,6 +5,7 @@
 #include "Common/Thread.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/Trace.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -66,6 +67,8 @@ void SwitchCurrentThread()
 // https://docs.microsoft.com/en-us/visualstudio/debugger/how-to-set-a-thread-name-in-native-code
 void SetCurrentThreadName(const char* szThreadName)
 {
+  Trace::SetThreadName(szThreadName);
+
   static const DWORD MS_VC_EXCEPTION = 0x406D1388;
 
 #pragma pack(push, 8)
@@ -131,6 +134,8 @@ void SwitchCurrentThread()
 
 void SetCurrentThreadName(const char* szThreadName)
 {
+  Trace::SetThreadName(szThreadName);
+
 #ifdef __APPLE__
   pthread_setname_np(szThreadName);
 #elif defined __FreeBSD__ || defined __OpenBSD__
@@ -0,0 +1,208 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/Trace.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+
+namespace Common::Trace
+{
+namespace
+{
+constexpr size_t EVENTS_PER_THREAD = 1 << 16;
+
+struct Event
+{
+  const char* name;
+  u64 start;
+  u64 end;
+};
+
+struct ThreadBuffer
+{
+  std::array<Event, EVENTS_PER_THREAD> events;
+  // Number of events recorded so far. Only written by the thread that owns the buffer.
+  std::atomic<u64> write_index{0};
+  // Events before this index have been cleared.
+  std::atomic<u64> start_index{0};
+
+  // Protected by s_buffers_lock.
+  u32 id = 0;
+  std::string name;
+};
+
+std::mutex s_buffers_lock;
+std::vector<std::shared_ptr<ThreadBuffer>> s_buffers;
+u32 s_next_thread_id = 1;
+
+thread_local std::shared_ptr<ThreadBuffer> t_buffer;
+thread_local std::string t_thread_name;
+
+ThreadBuffer& GetThreadBuffer()
+{
+  if (!t_buffer)
+  {
+    t_buffer = std::make_shared<ThreadBuffer>();
+
+    std::lock_guard lk(s_buffers_lock);
+    t_buffer->id = s_next_thread_id++;
+    t_buffer->name =
+        t_thread_name.empty() ? fmt::format("Thread {}", t_buffer->id) : t_thread_name;
+    s_buffers.push_back(t_buffer);
+  }
+
+  return *t_buffer;
+}
+
+std::string EscapeJSON(const std::string& str)
+{
+  std::string result;
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+      result += '\\';
+    if (static_cast<unsigned char>(c) >= 0x20)
+      result += c;
+  }
+  return result;
+}
+}  // namespace
+
+std::atomic<bool> g_enabled{false};
+
+void SetEnabled(bool enabled)
+{
+  g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void SetThreadName(const char* name)
+{
+  t_thread_name = name;
+  if (t_buffer)
+  {
+    std::lock_guard lk(s_buffers_lock);
+    t_buffer->name = name;
+  }
+}
+
+u64 GetTimestamp()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void RecordEvent(const char* name, u64 start, u64 end)
+{
+  ThreadBuffer& buffer = GetThreadBuffer();
+  const u64 write_index = buffer.write_index.load(std::memory_order_relaxed);
+  buffer.events[write_index % EVENTS_PER_THREAD] = {name, start, end};
+  buffer.write_index.store(write_index + 1, std::memory_order_release);
+}
+
+bool ExportChromeTrace(const std::string& path)
+{
+  struct ThreadEvents
+  {
+    u32 id;
+    std::string name;
+    std::vector<Event> events;
+  };
+
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  std::vector<ThreadEvents> threads;
+  {
+    std::lock_guard lk(s_buffers_lock);
+    buffers = s_buffers;
+    for (const auto& buffer : buffers)
+      threads.push_back({buffer->id, buffer->name, {}});
+  }
+
+  u64 base_time = UINT64_MAX;
+  for (size_t i = 0; i < buffers.size(); i++)
+  {
+    ThreadBuffer& buffer = *buffers[i];
+    const u64 end_index = buffer.write_index.load(std::memory_order_acquire);
+    const u64 start_index = std::max(buffer.start_index.load(std::memory_order_relaxed),
+                                     end_index - std::min<u64>(end_index, EVENTS_PER_THREAD));
+
+    std::vector<Event>& events = threads[i].events;
+    for (u64 index = start_index; index < end_index; index++)
+      events.push_back(buffer.events[index % EVENTS_PER_THREAD]);
+
+    // The thread may have overwritten the oldest events while they were copied, including the
+    // slot of the event it is writing right now.
+    const u64 new_end_index = buffer.write_index.load(std::memory_order_acquire);
+    if (new_end_index + 1 > start_index + EVENTS_PER_THREAD)
+    {
+      const u64 overwritten = std::min<u64>(new_end_index + 1 - EVENTS_PER_THREAD - start_index,
+                                            events.size());
+      events.erase(events.begin(), events.begin() + overwritten);
+    }
+
+    for (const Event& event : events)
+      base_time = std::min(base_time, event.start);
+  }
+
+  std::string trace = "{\"traceEvents\":[\n";
+  bool first = true;
+  const auto append = [&](const std::string& event) {
+    if (!first)
+      trace += ",\n";
+    trace += event;
+    first = false;
+  };
+
+  for (const ThreadEvents& thread : threads)
+  {
+    append(fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},"
+                       "\"args\":{{\"name\":\"{}\"}}}}",
+                       thread.id, EscapeJSON(thread.name)));
+    for (const Event& event : thread.events)
+    {
+      append(fmt::format(
+          "{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+          EscapeJSON(event.name), thread.id, (event.start - base_time) / 1000.0,
+          (event.end - event.start) / 1000.0));
+    }
+  }
+  trace += "\n]}\n";
+
+  if (!File::WriteStringToFile(path, trace))
+  {
+    ERROR_LOG(COMMON, "Failed to write trace to %s", path.c_str());
+    return false;
+  }
+
+  NOTICE_LOG(COMMON, "Wrote trace to %s", path.c_str());
+  return true;
+}
+
+void Clear()
+{
+  std::lock_guard lk(s_buffers_lock);
+  for (const auto& buffer : s_buffers)
+  {
+    buffer->start_index.store(buffer->write_index.load(std::memory_order_acquire),
+                              std::memory_order_relaxed);
+  }
+
+  // Forget about the buffers of threads that have exited.
+  s_buffers.erase(std::remove_if(s_buffers.begin(), s_buffers.end(),
+                                 [](const std::shared_ptr<ThreadBuffer>& buffer) {
+                                   return buffer.use_count() == 1;
+                                 }),
+                  s_buffers.end());
+}
+}  // namespace Common::Trace
@@ -0,0 +1,71 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// Records how long named scopes take on each thread, so that the work of the CPU, GPU, DVD, DSP
+// and other threads can be looked at on a common timeline.
+//
+// Every thread records into its own ring buffer, which holds the most recent events. Recording
+// can be enabled and disabled at any time. While it is disabled, a scope only costs a relaxed
+// load and a branch. The recorded events can be exported in the Chrome trace event format, which
+// can be opened in chrome://tracing or ui.perfetto.dev.
+namespace Common::Trace
+{
+extern std::atomic<bool> g_enabled;
+
+inline bool IsEnabled()
+{
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+void SetEnabled(bool enabled);
+
+// Names the calling thread in exported traces. Called by Common::SetCurrentThreadName.
+void SetThreadName(const char* name);
+
+// Returns a monotonic timestamp in nanoseconds.
+u64 GetTimestamp();
+
+// Records an event on the calling thread. The name has to stay valid until the events have been
+// exported or cleared, so it should usually be a string literal.
+void RecordEvent(const char* name, u64 start, u64 end);
+
+// Writes the events of all threads to a file. Can be called while recording.
+bool ExportChromeTrace(const std::string& path);
+
+// Drops all recorded events.
+void Clear();
+
+class Scope
+{
+public:
+  explicit Scope(const char* name) : m_name(IsEnabled() ? name : nullptr)
+  {
+    if (m_name)
+      m_start = GetTimestamp();
+  }
+
+  ~Scope()
+  {
+    if (m_name)
+      RecordEvent(m_name, m_start, GetTimestamp());
+  }
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+private:
+  const char* m_name;
+  u64 m_start = 0;
+};
+}  // namespace Common::Trace
+
+// Records the time until the end of the enclosing block.
+#define TRACE_SCOPE(name) Common::Trace::Scope trace_scope(name)
@@ -38,6 +38,7 @@ extern const Info<bool> GFX_OVERLAY_PROJ_STATS;
 extern const Info<bool> GFX_DUMP_TEXTURES;
 extern const Info<bool> GFX_HIRES_TEXTURES;
 extern const Info<bool> GFX_CACHE_HIRES_TEXTURES;
+extern const Info<int> GFX_HIRES_TEXTURE_CACHE_SIZE;
 extern const Info<bool> GFX_DUMP_EFB_TARGET;
 extern const Info<bool> GFX_DUMP_XFB_TARGET;
 extern const Info<bool> GFX_DUMP_FRAMES_AS_IMAGES;
@@ -122,6 +123,8 @@ extern const Info<bool> GFX_HACK_SKIP_DUPLICATE_XFBS;
 extern const Info<bool> GFX_HACK_COPY_EFB_SCALED;
 extern const Info<bool> GFX_HACK_EFB_EMULATE_FORMAT_CHANGES;
 extern const Info<bool> GFX_HACK_VERTEX_ROUDING;
+extern const Info<bool> GFX_HACK_TRACK_TEXTURE_WRITES;
+extern const Info<bool> GFX_HACK_XXH3_TEXTURE_HASHING;
 
 // Graphics.GameSpecific
 
@@ -26,6 +26,8 @@ extern const Info<bool> MAIN_SKIP_IPL;
 extern const Info<bool> MAIN_LOAD_IPL_DUMP;
 extern const Info<PowerPC::CPUCore> MAIN_CPU_CORE;
 extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
+extern const Info<bool> MAIN_JIT_TIERED_COMPILATION;
+extern const Info<bool> MAIN_JIT_PROFILE_CACHE;
 extern const Info<bool> MAIN_FASTMEM;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
 extern const Info<bool> MAIN_DSP_HLE;
@@ -64,6 +66,7 @@ extern const Info<bool> MAIN_WIIMOTE_ENABLE_SPEAKER;
 extern const Info<bool> MAIN_RUN_COMPARE_SERVER;
 extern const Info<bool> MAIN_RUN_COMPARE_CLIENT;
 extern const Info<bool> MAIN_MMU;
+extern const Info<bool> MAIN_HLE_LIBC_FUNCTIONS;
 extern const Info<int> MAIN_BB_DUMP_PORT;
 extern const Info<bool> MAIN_SYNC_GPU;
 extern const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE;
@@ -93,6 +96,7 @@ extern const Info<bool> MAIN_POLL_ON_SIREAD;
 
 extern const Info<bool> MAIN_DSP_CAPTURE_LOG;
 extern const Info<bool> MAIN_DSP_JIT;
+extern const Info<bool> MAIN_DSP_HLE_THREAD;
 extern const Info<bool> MAIN_DUMP_AUDIO;
 extern const Info<bool> MAIN_DUMP_AUDIO_SILENT;
 extern const Info<bool> MAIN_DUMP_UCODE;
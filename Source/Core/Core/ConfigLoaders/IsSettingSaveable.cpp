@@ -28,7 +28,7 @@ bool IsSettingSaveable(const Config::Location& config_location)
       return true;
   }
 
-  static constexpr std::array<const Config::Location*, 105> s_setting_saveable = {
+  static constexpr std::array<const Config::Location*, 108> s_setting_saveable = {
       // Main.Core
 
       &Config::MAIN_DEFAULT_ISO.location,
@@ -81,6 +81,7 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::GFX_DUMP_TEXTURES.location,
       &Config::GFX_HIRES_TEXTURES.location,
       &Config::GFX_CACHE_HIRES_TEXTURES.location,
+      &Config::GFX_HIRES_TEXTURE_CACHE_SIZE.location,
       &Config::GFX_DUMP_EFB_TARGET.location,
       &Config::GFX_DUMP_FRAMES_AS_IMAGES.location,
       &Config::GFX_FREE_LOOK.location,
@@ -156,6 +157,8 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::GFX_HACK_COPY_EFB_SCALED.location,
       &Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES.location,
       &Config::GFX_HACK_VERTEX_ROUDING.location,
+      &Config::GFX_HACK_TRACK_TEXTURE_WRITES.location,
+      &Config::GFX_HACK_XXH3_TEXTURE_HASHING.location,
 
       // Graphics.GameSpecific
 
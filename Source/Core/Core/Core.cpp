@@ -100,6 +100,8 @@ static Common::Flag s_is_booting;
 static Common::Event s_done_booting;
 static std::thread s_emu_thread;
 static StateChangedCallbackFunc s_on_state_changed_callback;
+static FrameCallbackFunc s_on_frame_presented_callback;
+static FrameCallbackFunc s_on_new_field_callback;
 
 static std::thread s_cpu_thread;
 static bool s_request_refresh_info = false;
@@ -862,11 +864,17 @@ void Callback_FramePresented()
 {
   s_drawn_frame++;
   s_stop_frame_step.store(true);
+
+  if (s_on_frame_presented_callback)
+    s_on_frame_presented_callback();
 }
 
 // Called from VideoInterface::Update (CPU thread) at emulated field boundaries
 void Callback_NewField()
 {
+  if (s_on_new_field_callback)
+    s_on_new_field_callback();
+
   if (s_frame_step)
   {
     // To ensure that s_stop_frame_step is up to date, wait for the GPU thread queue to empty,
@@ -976,6 +984,16 @@ void SetOnStateChangedCallback(StateChangedCallbackFunc callback)
   s_on_state_changed_callback = std::move(callback);
 }
 
+void SetOnFramePresentedCallback(FrameCallbackFunc callback)
+{
+  s_on_frame_presented_callback = std::move(callback);
+}
+
+void SetOnNewFieldCallback(FrameCallbackFunc callback)
+{
+  s_on_new_field_callback = std::move(callback);
+}
+
 void UpdateWantDeterminism(bool initial)
 {
   // For now, this value is not itself configurable.  Instead, individual
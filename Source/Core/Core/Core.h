@@ -145,6 +145,12 @@ void RunOnCPUThread(std::function<void()> function, bool wait_for_completion);
 using StateChangedCallbackFunc = std::function<void(Core::State)>;
 void SetOnStateChangedCallback(StateChangedCallbackFunc callback);
 
+// Called on the GPU thread for every frame that is presented, and on the CPU thread at every
+// emulated field. Used to measure performance; set them before booting.
+using FrameCallbackFunc = std::function<void()>;
+void SetOnFramePresentedCallback(FrameCallbackFunc callback);
+void SetOnNewFieldCallback(FrameCallbackFunc callback);
+
 // Run on the Host thread when the factors change. [NOT THREADSAFE]
 void UpdateWantDeterminism(bool initial = false);
 
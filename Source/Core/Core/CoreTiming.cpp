@@ -17,6 +17,7 @@
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/SPSCQueue.h"
+#include "Common/Trace.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -69,6 +70,10 @@ static float s_last_OC_factor;
 static constexpr int MAX_SLICE_LENGTH = 20000;
 
 static s64 s_idled_cycles;
+// Idle skipping statistics for the current session. Unlike s_idled_cycles, these aren't affected
+// by loading states.
+static u64 s_session_idled_cycles;
+static u64 s_session_idle_skips;
 static u32 s_fake_dec_start_value;
 static u64 s_fake_dec_start_ticks;
 
@@ -129,6 +134,8 @@ void Init()
   g.slice_length = MAX_SLICE_LENGTH;
   g.global_timer = 0;
   s_idled_cycles = 0;
+  s_session_idled_cycles = 0;
+  s_session_idle_skips = 0;
 
   // The time between CoreTiming being intialized and the first call to Advance() is considered
   // the slice boundary between slice -1 and slice 0. Dispatcher loops must call Advance() before
@@ -142,6 +149,13 @@ void Init()
 
 void Shutdown()
 {
+  if (s_session_idle_skips != 0)
+  {
+    INFO_LOG(POWERPC, "Idle skipping for %s: %" PRIu64 " cycles skipped in %" PRIu64 " idle loops",
+             SConfig::GetInstance().GetGameID().c_str(), s_session_idled_cycles,
+             s_session_idle_skips);
+  }
+
   std::lock_guard<std::mutex> lk(s_ts_write_lock);
   MoveEvents();
   ClearPendingEvents();
@@ -314,6 +328,8 @@ void MoveEvents()
 
 void Advance()
 {
+  TRACE_SCOPE("CoreTiming::Advance");
+
   MoveEvents();
 
   int cyclesExecuted = g.slice_length - DowncountToCycles(PowerPC::ppcState.downcount);
@@ -383,7 +399,10 @@ void Idle()
     Fifo::FlushGpu();
   }
 
-  s_idled_cycles += DowncountToCycles(PowerPC::ppcState.downcount);
+  const int skipped_cycles = DowncountToCycles(PowerPC::ppcState.downcount);
+  s_idled_cycles += skipped_cycles;
+  s_session_idled_cycles += skipped_cycles;
+  s_session_idle_skips++;
   PowerPC::ppcState.downcount = 0;
 }
 
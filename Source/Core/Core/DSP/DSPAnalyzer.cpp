@@ -9,6 +9,7 @@
 
 #include "Common/Logging/Log.h"
 
+#include "Core/DSP/DSPCore.h"
 #include "Core/DSP/DSPMemoryMap.h"
 #include "Core/DSP/DSPTables.h"
 
@@ -67,6 +68,55 @@ constexpr u16 idle_skip_sigs[NUM_IDLE_SIGS][MAX_IDLE_SIG_SIZE + 1] = {
      0x0295, 0xFFFF,  // JZ    0x????
      0, 0}};
 
+// Besides the fixed signatures above, any loop that only reads the high half of a mailbox,
+// tests its status bit and jumps back to the read is waiting for mail:
+//   LRS/LR $AC?.M, @DMBH/@CMBH
+//   ANDF/ANDCF $AC?.M, #0x8000
+//   Jcc <address of the read>
+bool IsMailboxPollLoop(u16 addr)
+{
+  u16 pc = addr;
+  const u16 read = dsp_imem_read(pc);
+  u16 reg;
+  u16 mailbox;
+  if ((read & 0xf800) == 0x2000)
+  {
+    // LRS $D, @M
+    reg = 0x18 + ((read >> 8) & 0x7);
+    mailbox = 0xff00 | (read & 0xff);
+    pc += 1;
+  }
+  else if ((read & 0xffe0) == 0x00c0)
+  {
+    // LR $D, @M
+    reg = read & 0x1f;
+    mailbox = dsp_imem_read(static_cast<u16>(pc + 1));
+    pc += 2;
+  }
+  else
+  {
+    return false;
+  }
+
+  if ((reg != DSP_REG_ACM0 && reg != DSP_REG_ACM1) || (mailbox != 0xfffc && mailbox != 0xfffe))
+    return false;
+
+  // ANDF and ANDCF select the middle accumulator with bit 8.
+  const u16 test = dsp_imem_read(pc);
+  const u16 test_reg = DSP_REG_ACM0 + ((test >> 8) & 1);
+  if (((test & 0xfeff) != 0x02a0 && (test & 0xfeff) != 0x02c0) || test_reg != reg ||
+      dsp_imem_read(static_cast<u16>(pc + 1)) != 0x8000)
+  {
+    return false;
+  }
+  pc += 2;
+
+  // Any condition will do: only the mailbox can change the outcome of the test.
+  const u16 jump = dsp_imem_read(pc);
+  return (jump & 0xfff0) == 0x0290 && jump != 0x029f &&
+         dsp_imem_read(static_cast<u16>(pc + 1)) == addr;
+}
+
 void Reset()
 {
   code_flags.fill(0);
@@ -149,6 +199,15 @@ void AnalyzeRange(u16 start_addr, u16 end_addr)
       }
     }
   }
+  for (u16 addr = start_addr; addr < end_addr; addr++)
+  {
+    if ((code_flags[addr] & CODE_START_OF_INST) && !(code_flags[addr] & CODE_IDLE_SKIP) &&
+        IsMailboxPollLoop(addr))
+    {
+      INFO_LOG(DSPLLE, "Idle skip location found at %02x (mailbox poll loop)", addr);
+      code_flags[addr] |= CODE_IDLE_SKIP;
+    }
+  }
   INFO_LOG(DSPLLE, "Finished analysis.");
 }
 }  // Anonymous namespace
@@ -30,6 +30,12 @@ constexpr size_t COMPILED_CODE_SIZE = 2097152;
 constexpr size_t MAX_BLOCK_SIZE = 250;
 constexpr u16 DSP_IDLE_SKIP_CYCLES = 0x1000;
 
+// Only IRAM (0x0xxx) and IROM (0x8xxx) hold code.
+static bool IsCodeAddress(u16 address)
+{
+  return address < DSP_IRAM_SIZE || (address >= 0x8000 && address < 0x8000 + DSP_IROM_SIZE);
+}
+
 DSPEmitter::DSPEmitter()
     : m_compile_status_register{SR_INT_ENABLE | SR_EXT_INT_ENABLE}, m_blocks(MAX_BLOCKS),
       m_block_size(MAX_BLOCKS), m_block_links(MAX_BLOCKS)
@@ -222,6 +228,7 @@ void DSPEmitter::Compile(u16 start_addr)
 
   m_compile_pc = start_addr;
   bool fixup_pc = false;
+  bool ended_with_uncond_branch = false;
   m_block_size[start_addr] = 0;
 
   while (m_compile_pc < start_addr + MAX_BLOCK_SIZE)
@@ -287,6 +294,7 @@ void DSPEmitter::Compile(u16 start_addr)
       fixup_pc = false;
       if (opcode->uncond_branch)
       {
+        ended_with_uncond_branch = true;
         break;
       }
 
@@ -329,6 +337,11 @@ void DSPEmitter::Compile(u16 start_addr)
     MOV(16, M_SDSP_pc(), Imm16(m_compile_pc));
   }
 
+  // If we ran off the end of the block rather than branching away, chain straight into the
+  // block that follows so the accumulators can stay in their host registers.
+  if (!ended_with_uncond_branch && IsCodeAddress(m_compile_pc))
+    WriteLinkedJump(m_compile_pc);
+
   m_blocks[start_addr] = (DSPCompiledCode)entryPoint;
 
   // Mark this block as a linkable destination if it does not contain
@@ -210,6 +210,7 @@ private:
 
   void WriteBranchExit();
   void WriteBlockLink(u16 dest);
+  void WriteLinkedJump(u16 dest);
 
   void ReJitConditional(UDSPInstruction opc, void (DSPEmitter::*conditional_fn)(UDSPInstruction));
   void r_jcc(UDSPInstruction opc);
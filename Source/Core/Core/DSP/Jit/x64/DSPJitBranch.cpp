@@ -100,27 +100,30 @@ void DSPEmitter::WriteBlockLink(u16 dest)
 {
   // Jump directly to the called block if it has already been compiled.
   if (!(dest >= m_start_address && dest <= m_compile_pc))
+    WriteLinkedJump(dest);
+}
+
+void DSPEmitter::WriteLinkedJump(u16 dest)
+{
+  if (m_block_links[dest] != nullptr)
+  {
+    m_gpr.FlushRegs();
+    // Check if we have enough cycles to execute the next block
+    MOV(64, R(RAX), ImmPtr(&m_cycles_left));
+    MOV(16, R(ECX), MatR(RAX));
+    CMP(16, R(ECX), Imm16(m_block_size[m_start_address] + m_block_size[dest]));
+    FixupBranch notEnoughCycles = J_CC(CC_BE);
+
+    SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
+    MOV(16, MatR(RAX), R(ECX));
+    JMP(m_block_links[dest], true);
+    SetJumpTarget(notEnoughCycles);
+  }
+  else
   {
-    if (m_block_links[dest] != nullptr)
-    {
-      m_gpr.FlushRegs();
-      // Check if we have enough cycles to execute the next block
-      MOV(64, R(RAX), ImmPtr(&m_cycles_left));
-      MOV(16, R(ECX), MatR(RAX));
-      CMP(16, R(ECX), Imm16(m_block_size[m_start_address] + m_block_size[dest]));
-      FixupBranch notEnoughCycles = J_CC(CC_BE);
-
-      SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
-      MOV(16, MatR(RAX), R(ECX));
-      JMP(m_block_links[dest], true);
-      SetJumpTarget(notEnoughCycles);
-    }
-    else
-    {
-      // The destination has not been compiled yet.  Add it to the list
-      // of blocks that this block is waiting on.
-      m_unresolved_jumps[m_start_address].push_back(dest);
-    }
+    // The destination has not been compiled yet.  Add it to the list
+    // of blocks that this block is waiting on.
+    m_unresolved_jumps[m_start_address].push_back(dest);
   }
 }
 
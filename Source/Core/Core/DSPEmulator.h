@@ -20,6 +20,8 @@ public:
 
   virtual void DoState(PointerWrap& p) = 0;
   virtual void PauseAndLock(bool do_lock, bool unpause_on_unlock = true) = 0;
+  // Completes work that was handed to another thread and brings its results into memory.
+  virtual void FinishAsyncWork() = 0;
 
   virtual void DSP_WriteMailBoxHigh(bool cpu_mailbox, u16 value) = 0;
   virtual void DSP_WriteMailBoxLow(bool cpu_mailbox, u16 value) = 0;
@@ -152,8 +152,8 @@ std::array<int, 21> CalculateVertexElementSizes(int vatIndex, const CPMemory& cp
 }
 }  // Anonymous namespace
 
-bool s_DrawingObject;
-FifoAnalyzer::CPMemory s_CpMem;
+thread_local bool s_DrawingObject;
+thread_local FifoAnalyzer::CPMemory s_CpMem;
 
 u32 AnalyzeCommand(const u8* data, DecodeMode mode)
 {
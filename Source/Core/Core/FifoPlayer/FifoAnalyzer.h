@@ -29,6 +29,7 @@ struct CPMemory
 
 void LoadCPReg(u32 subCmd, u32 value, CPMemory& cpMem);
 
-extern bool s_DrawingObject;
-extern FifoAnalyzer::CPMemory s_CpMem;
+// Thread local, so that frames can be analyzed on several threads at once.
+extern thread_local bool s_DrawingObject;
+extern thread_local FifoAnalyzer::CPMemory s_CpMem;
 }  // namespace FifoAnalyzer
@@ -4,11 +4,18 @@
 
 #include "Core/FifoPlayer/FifoPlaybackAnalyzer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Swap.h"
 #include "Core/FifoPlayer/FifoAnalyzer.h"
 #include "Core/FifoPlayer/FifoDataFile.h"
+#include "VideoCommon/OpcodeDecoding.h"
 
 using namespace FifoAnalyzer;
 
@@ -21,82 +28,349 @@ struct CmdData
   const u8* ptr;
 };
 
-void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
-                                         std::vector<AnalyzedFrameInfo>& frameInfo)
+namespace
 {
-  u32* cpMem = file->GetCPMem();
-  FifoAnalyzer::LoadCPReg(0x50, cpMem[0x50], s_CpMem);
-  FifoAnalyzer::LoadCPReg(0x60, cpMem[0x60], s_CpMem);
+// The CP registers that determine the size of vertices, as bits of a mask: the two halves of the
+// vertex descriptor, followed by the three groups of each of the 8 vertex attribute tables.
+constexpr u32 VTXDESC_LOW_BIT = 1 << 0;
+constexpr u32 VTXDESC_HIGH_BIT = 1 << 1;
+constexpr int NUM_VERTEX_STATE_REGS = 2 + 8 * 3;
 
-  for (int i = 0; i < 8; ++i)
+int GetVatRegIndex(u32 vat, u32 group)
+{
+  return 2 + vat * 3 + group;
+}
+
+u32 GetVertexStateBit(u32 subCmd)
+{
+  switch (subCmd & 0xF0)
   {
-    FifoAnalyzer::LoadCPReg(0x70 + i, cpMem[0x70 + i], s_CpMem);
-    FifoAnalyzer::LoadCPReg(0x80 + i, cpMem[0x80 + i], s_CpMem);
-    FifoAnalyzer::LoadCPReg(0x90 + i, cpMem[0x90 + i], s_CpMem);
+  case 0x50:
+    return VTXDESC_LOW_BIT;
+  case 0x60:
+    return VTXDESC_HIGH_BIT;
+  case 0x70:
+  case 0x80:
+  case 0x90:
+    return 1u << GetVatRegIndex(subCmd & 7, ((subCmd & 0xF0) - 0x70) >> 4);
+  default:
+    return 0;
   }
+}
 
-  frameInfo.clear();
-  frameInfo.resize(file->GetFrameCount());
+u32 GetVertexStateReg(const CPMemory& cpMem, int index)
+{
+  if (index == 0)
+    return cpMem.vtxDesc.Hex & 0x1FFFF;
+  if (index == 1)
+    return static_cast<u32>(cpMem.vtxDesc.Hex >> 17);
+
+  const VAT& vat = cpMem.vtxAttr[(index - 2) / 3];
+  switch ((index - 2) % 3)
+  {
+  case 0:
+    return vat.g0.Hex;
+  case 1:
+    return vat.g1.Hex;
+  default:
+    return vat.g2.Hex;
+  }
+}
+
+bool HaveSameVertexState(const CPMemory& a, const CPMemory& b, u32 mask)
+{
+  for (int i = 0; i < NUM_VERTEX_STATE_REGS; ++i)
+  {
+    if ((mask & (1u << i)) && GetVertexStateReg(a, i) != GetVertexStateReg(b, i))
+      return false;
+  }
+  return true;
+}
+
+// Returns the number of bytes of a command that AnalyzeCommand reads before it knows its size, or 0
+// if the opcode can't appear in a fifo log.
+u32 GetCommandHeaderSize(u8 cmd)
+{
+  switch (cmd)
+  {
+  case OpcodeDecoder::GX_NOP:
+  case 0x44:
+  case OpcodeDecoder::GX_CMD_INVL_VC:
+    return 1;
+
+  case OpcodeDecoder::GX_LOAD_CP_REG:
+    return 6;
+
+  case OpcodeDecoder::GX_LOAD_XF_REG:
+  case OpcodeDecoder::GX_LOAD_INDX_A:
+  case OpcodeDecoder::GX_LOAD_INDX_B:
+  case OpcodeDecoder::GX_LOAD_INDX_C:
+  case OpcodeDecoder::GX_LOAD_INDX_D:
+  case OpcodeDecoder::GX_LOAD_BP_REG:
+    return 5;
+
+  default:
+    return (cmd & 0x80) ? 3 : 0;
+  }
+}
+
+CPMemory GetInitialCPMemory(FifoDataFile* file)
+{
+  CPMemory cpMem{};
+  u32* cpRegs = file->GetCPMem();
+  LoadCPReg(0x50, cpRegs[0x50], cpMem);
+  LoadCPReg(0x60, cpRegs[0x60], cpMem);
 
-  for (u32 frameIdx = 0; frameIdx < file->GetFrameCount(); ++frameIdx)
+  for (int i = 0; i < 8; ++i)
   {
-    const FifoFrameInfo& frame = file->GetFrame(frameIdx);
-    AnalyzedFrameInfo& analyzed = frameInfo[frameIdx];
+    LoadCPReg(0x70 + i, cpRegs[0x70 + i], cpMem);
+    LoadCPReg(0x80 + i, cpRegs[0x80 + i], cpMem);
+    LoadCPReg(0x90 + i, cpRegs[0x90 + i], cpMem);
+  }
 
-    s_DrawingObject = false;
+  return cpMem;
+}
 
-    u32 cmdStart = 0;
-    u32 nextMemUpdate = 0;
+enum class AnalysisResult
+{
+  Success,
+  Error,
+  // A speculative analysis ran into something that might not be a command.
+  Aborted,
+};
+
+struct FrameAnalysis
+{
+  AnalysisResult result = AnalysisResult::Success;
+  // The vertex state registers that a draw used before the frame loaded them.
+  u32 dependencies = 0;
+  // The vertex state registers loaded by the frame, in order.
+  std::vector<std::pair<u32, u32>> cpLoads;
+};
+
+// Finds the objects of a frame, starting with the given CP state. If speculative, the state may be
+// wrong, so the analysis stops at anything that might not be a valid command instead of reporting
+// an error.
+FrameAnalysis AnalyzeFrame(const FifoFrameInfo& frame, const CPMemory& startState, bool speculative,
+                           AnalyzedFrameInfo& analyzed)
+{
+  FrameAnalysis analysis;
+  u32 loadedRegs = 0;
+
+  analyzed.objectStarts.clear();
+  analyzed.objectEnds.clear();
+
+  s_CpMem = startState;
+  s_DrawingObject = false;
+
+  u32 cmdStart = 0;
 
 #if LOG_FIFO_CMDS
-    // Debugging
-    std::vector<CmdData> prevCmds;
+  // Debugging
+  std::vector<CmdData> prevCmds;
 #endif
 
-    while (cmdStart < frame.fifoData.size())
+  while (cmdStart < frame.fifoData.size())
+  {
+    const u8* const data = &frame.fifoData[cmdStart];
+    const u8 cmd = data[0];
+
+    if (speculative)
     {
-      // Add memory updates that have occurred before this point in the frame
-      while (nextMemUpdate < frame.memoryUpdates.size() &&
-             frame.memoryUpdates[nextMemUpdate].fifoPosition <= cmdStart)
+      const u32 headerSize = GetCommandHeaderSize(cmd);
+      if (headerSize == 0 || cmdStart + headerSize > frame.fifoData.size())
       {
-        analyzed.memoryUpdates.push_back(frame.memoryUpdates[nextMemUpdate]);
-        ++nextMemUpdate;
+        analysis.result = AnalysisResult::Aborted;
+        return analysis;
       }
+    }
 
-      const bool wasDrawing = s_DrawingObject;
-      const u32 cmdSize =
-          FifoAnalyzer::AnalyzeCommand(&frame.fifoData[cmdStart], DecodeMode::Playback);
+    if (cmd == OpcodeDecoder::GX_LOAD_CP_REG)
+    {
+      const u32 bit = GetVertexStateBit(data[1]);
+      if (bit != 0)
+      {
+        loadedRegs |= bit;
+        analysis.cpLoads.emplace_back(data[1], Common::swap32(data + 2));
+      }
+    }
+    else if (cmd & 0x80)
+    {
+      const u32 vat = cmd & OpcodeDecoder::GX_VAT_MASK;
+      const u32 usedRegs = VTXDESC_LOW_BIT | VTXDESC_HIGH_BIT | (7u << GetVatRegIndex(vat, 0));
+      analysis.dependencies |= usedRegs & ~loadedRegs;
+    }
+
+    const bool wasDrawing = s_DrawingObject;
+    const u32 cmdSize = FifoAnalyzer::AnalyzeCommand(data, DecodeMode::Playback);
 
 #if LOG_FIFO_CMDS
-      CmdData cmdData;
-      cmdData.offset = cmdStart;
-      cmdData.ptr = &frame.fifoData[cmdStart];
-      cmdData.size = cmdSize;
-      prevCmds.push_back(cmdData);
+    CmdData cmdData;
+    cmdData.offset = cmdStart;
+    cmdData.ptr = &frame.fifoData[cmdStart];
+    cmdData.size = cmdSize;
+    prevCmds.push_back(cmdData);
 #endif
 
-      // Check for error
-      if (cmdSize == 0)
-      {
-        // Clean up frame analysis
-        analyzed.objectStarts.clear();
-        analyzed.objectEnds.clear();
+    // Check for error
+    if (cmdSize == 0)
+    {
+      // Clean up frame analysis
+      analyzed.objectStarts.clear();
+      analyzed.objectEnds.clear();
 
-        return;
+      analysis.result = speculative ? AnalysisResult::Aborted : AnalysisResult::Error;
+      return analysis;
+    }
+
+    if (wasDrawing != s_DrawingObject)
+    {
+      if (s_DrawingObject)
+        analyzed.objectStarts.push_back(cmdStart);
+      else
+        analyzed.objectEnds.push_back(cmdStart);
+    }
+
+    cmdStart += cmdSize;
+  }
+
+  if (analyzed.objectEnds.size() < analyzed.objectStarts.size())
+    analyzed.objectEnds.push_back(cmdStart);
+
+  return analysis;
+}
+}  // Anonymous namespace
+
+void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
+                                         std::vector<AnalyzedFrameInfo>& frameInfo)
+{
+  const CPMemory initialState = GetInitialCPMemory(file);
+  const u32 frameCount = file->GetFrameCount();
+
+  frameInfo.clear();
+  frameInfo.resize(frameCount);
+
+  // The size of vertices depends on the CP state left behind by the previous frames, but the state
+  // that matters is usually loaded again by every frame or never changes. So all frames are first
+  // analyzed in parallel, assuming the state at the start of the log, and the frames that used a
+  // different state are analyzed again in order afterwards.
+  std::vector<FrameAnalysis> analyses(frameCount);
+  std::atomic<u32> nextFrame{0};
+  const auto worker = [&] {
+    for (u32 frameIdx = nextFrame++; frameIdx < frameCount; frameIdx = nextFrame++)
+    {
+      const FifoFrameInfo& frame = file->GetFrame(frameIdx);
+      frameInfo[frameIdx].memoryUpdates = MergeMemoryUpdates(frame.memoryUpdates);
+      analyses[frameIdx] = AnalyzeFrame(frame, initialState, true, frameInfo[frameIdx]);
+    }
+  };
+
+  const u32 numThreads = std::min(std::max(std::thread::hardware_concurrency(), 1u), frameCount);
+  std::vector<std::thread> threads;
+  for (u32 i = 1; i < numThreads; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (std::thread& thread : threads)
+    thread.join();
+
+  CPMemory state = initialState;
+  for (u32 frameIdx = 0; frameIdx < frameCount; ++frameIdx)
+  {
+    FrameAnalysis& analysis = analyses[frameIdx];
+    if (analysis.result != AnalysisResult::Success ||
+        !HaveSameVertexState(state, initialState, analysis.dependencies))
+    {
+      analysis = AnalyzeFrame(file->GetFrame(frameIdx), state, false, frameInfo[frameIdx]);
+    }
+
+    if (analysis.result == AnalysisResult::Error)
+    {
+      // The objects of the following frames can't be found without the state of this one.
+      for (u32 i = frameIdx + 1; i < frameCount; ++i)
+      {
+        frameInfo[i].objectStarts.clear();
+        frameInfo[i].objectEnds.clear();
       }
+      return;
+    }
+
+    for (const auto& [subCmd, value] : analysis.cpLoads)
+      LoadCPReg(subCmd, value, state);
+  }
+}
+
+std::vector<MemoryUpdate>
+FifoPlaybackAnalyzer::MergeMemoryUpdates(const std::vector<MemoryUpdate>& updates)
+{
+  std::vector<MemoryUpdate> merged;
+  merged.reserve(updates.size());
+
+  std::vector<size_t> order;
+  std::vector<size_t> mergedIndices;
 
-      if (wasDrawing != s_DrawingObject)
+  size_t groupStart = 0;
+  while (groupStart < updates.size())
+  {
+    // Updates at the same fifo position are applied together, so only those can be merged.
+    size_t groupEnd = groupStart + 1;
+    while (groupEnd < updates.size() &&
+           updates[groupEnd].fifoPosition == updates[groupStart].fifoPosition)
+    {
+      ++groupEnd;
+    }
+
+    order.resize(groupEnd - groupStart);
+    std::iota(order.begin(), order.end(), groupStart);
+    std::sort(order.begin(), order.end(), [&updates](size_t a, size_t b) {
+      return updates[a].address < updates[b].address;
+    });
+
+    // Find the ranges of memory covered by the updates, joining ranges that touch.
+    const size_t firstMerged = merged.size();
+    mergedIndices.resize(groupEnd - groupStart);
+    for (const size_t i : order)
+    {
+      const MemoryUpdate& update = updates[i];
+      if (update.data.empty())
+        continue;
+
+      const u64 updateEnd = u64(update.address) + update.data.size();
+      if (merged.size() > firstMerged)
       {
-        if (s_DrawingObject)
-          analyzed.objectStarts.push_back(cmdStart);
-        else
-          analyzed.objectEnds.push_back(cmdStart);
+        MemoryUpdate& range = merged.back();
+        const u64 rangeEnd = u64(range.address) + range.data.size();
+        if ((range.address & 0x10000000) == (update.address & 0x10000000) &&
+            update.address <= rangeEnd)
+        {
+          range.data.resize(std::max(rangeEnd, updateEnd) - range.address);
+          range.type = static_cast<MemoryUpdate::Type>(range.type | update.type);
+          mergedIndices[i - groupStart] = merged.size() - 1;
+          continue;
+        }
       }
 
-      cmdStart += cmdSize;
+      MemoryUpdate& range = merged.emplace_back();
+      range.fifoPosition = update.fifoPosition;
+      range.address = update.address;
+      range.data.resize(update.data.size());
+      range.type = update.type;
+      mergedIndices[i - groupStart] = merged.size() - 1;
+    }
+
+    // Fill in the data in the original order, so that later updates still win where they overlap.
+    for (size_t i = groupStart; i < groupEnd; ++i)
+    {
+      const MemoryUpdate& update = updates[i];
+      if (update.data.empty())
+        continue;
+
+      MemoryUpdate& range = merged[mergedIndices[i - groupStart]];
+      std::copy(update.data.begin(), update.data.end(),
+                range.data.begin() + (update.address - range.address));
     }
 
-    if (analyzed.objectEnds.size() < analyzed.objectStarts.size())
-      analyzed.objectEnds.push_back(cmdStart);
+    groupStart = groupEnd;
   }
+
+  return merged;
 }
@@ -13,10 +13,16 @@ struct AnalyzedFrameInfo
 {
   std::vector<u32> objectStarts;
   std::vector<u32> objectEnds;
+  // The memory updates of the frame, with updates that are applied at the same fifo position
+  // merged into one update per contiguous range of memory.
   std::vector<MemoryUpdate> memoryUpdates;
 };
 
 namespace FifoPlaybackAnalyzer
 {
 void AnalyzeFrames(FifoDataFile* file, std::vector<AnalyzedFrameInfo>& frameInfo);
+
+// Merges memory updates at the same fifo position that overlap or are adjacent. Where updates
+// overlap, the data of the later one is kept. Expects the updates to be sorted by fifo position.
+std::vector<MemoryUpdate> MergeMemoryUpdates(const std::vector<MemoryUpdate>& updates);
 }  // namespace FifoPlaybackAnalyzer
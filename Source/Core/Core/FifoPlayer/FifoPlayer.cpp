@@ -257,7 +257,7 @@ void FifoPlayer::WriteFrame(const FifoFrameInfo& frame, const AnalyzedFrameInfo&
   // Skip memory updates during frame if true
   if (m_EarlyMemoryUpdates)
   {
-    memoryUpdate = (u32)(frame.memoryUpdates.size());
+    memoryUpdate = (u32)(info.memoryUpdates.size());
   }
 
   if (numObjects > 0)
@@ -310,7 +310,7 @@ void FifoPlayer::WriteFramePart(u32 dataStart, u32 dataEnd, u32& nextMemUpdate,
 {
   const u8* const data = frame.fifoData.data();
 
-  while (nextMemUpdate < frame.memoryUpdates.size() && dataStart < dataEnd)
+  while (nextMemUpdate < info.memoryUpdates.size() && dataStart < dataEnd)
   {
     const MemoryUpdate& memUpdate = info.memoryUpdates[nextMemUpdate];
 
@@ -354,13 +354,21 @@ void FifoPlayer::WriteAllMemoryUpdates()
 void FifoPlayer::WriteMemory(const MemoryUpdate& memUpdate)
 {
   u8* mem = nullptr;
+  u32 address;
 
   if (memUpdate.address & 0x10000000)
+  {
+    address = 0x10000000 | (memUpdate.address & Memory::GetExRamMask());
     mem = &Memory::m_pEXRAM[memUpdate.address & Memory::GetExRamMask()];
+  }
   else
-    mem = &Memory::m_pRAM[memUpdate.address & Memory::GetRamMask()];
+  {
+    address = memUpdate.address & Memory::GetRamMask();
+    mem = &Memory::m_pRAM[address];
+  }
 
   std::copy(memUpdate.data.begin(), memUpdate.data.end(), mem);
+  Memory::NotifyWrite(address, static_cast<u32>(memUpdate.data.size()));
 }
 
 void FifoPlayer::WriteFifo(const u8* data, u32 start, u32 end)
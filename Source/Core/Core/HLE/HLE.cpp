@@ -10,8 +10,10 @@
 
 #include "Common/CommonTypes.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/GeckoCode.h"
+#include "Core/HLE/HLE_Libc.h"
 #include "Core/HLE/HLE_Misc.h"
 #include "Core/HLE/HLE_OS.h"
 #include "Core/HW/Memmap.h"
@@ -36,7 +38,7 @@ struct SPatch
 };
 
 // clang-format off
-constexpr std::array<SPatch, 23> OSPatches{{
+constexpr std::array<SPatch, 27> OSPatches{{
     // Placeholder, OSPatches[0] is the "non-existent function" index
     {"FAKE_TO_SKIP_0",               HLE_Misc::UnimplementedFunction,       HookType::Replace, HookFlag::Generic},
 
@@ -68,7 +70,13 @@ constexpr std::array<SPatch, 23> OSPatches{{
 
     {"GeckoCodehandler",             HLE_Misc::GeckoCodeHandlerICacheFlush, HookType::Start,   HookFlag::Fixed},
     {"GeckoHandlerReturnTrampoline", HLE_Misc::GeckoReturnTrampoline,       HookType::Replace, HookFlag::Fixed},
-    {"AppLoaderReport",              HLE_OS::HLE_GeneralDebugPrint,         HookType::Replace, HookFlag::Fixed} // apploader needs OSReport-like function
+    {"AppLoaderReport",              HLE_OS::HLE_GeneralDebugPrint,         HookType::Replace, HookFlag::Fixed}, // apploader needs OSReport-like function
+
+    // Hot C library functions
+    {"memcpy",                       HLE_Libc::HLE_memcpy,                  HookType::Replace, HookFlag::Libc},
+    {"memmove",                      HLE_Libc::HLE_memmove,                 HookType::Replace, HookFlag::Libc},
+    {"memset",                       HLE_Libc::HLE_memset,                  HookType::Replace, HookFlag::Libc},
+    {"strlen",                       HLE_Libc::HLE_strlen,                  HookType::Replace, HookFlag::Libc},
 }};
 
 constexpr std::array<SPatch, 1> OSBreakPoints{{
@@ -209,6 +217,11 @@ HookFlag GetFunctionFlagsByIndex(u32 index)
 
 bool IsEnabled(HookFlag flag)
 {
+  // The libc replacements access memory through BAT translation only,
+  // so they must not be used when full MMU emulation is required.
+  if (flag == HookFlag::Libc)
+    return Config::Get(Config::MAIN_HLE_LIBC_FUNCTIONS) && !SConfig::GetInstance().bMMU;
+
   return flag != HLE::HookFlag::Debug || SConfig::GetInstance().bEnableDebugging ||
          PowerPC::GetMode() == PowerPC::CoreMode::Interpreter;
 }
@@ -22,6 +22,7 @@ enum class HookFlag
   Generic,  // Miscellaneous function
   Debug,    // Debug output function
   Fixed,    // An arbitrary hook mapped to a fixed address instead of a symbol
+  Libc,     // Native replacement for a hot C library function (opt-in)
 };
 
 void PatchFixedFunctions();
@@ -0,0 +1,170 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/HLE/HLE_Libc.h"
+
+#include <cstring>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+
+namespace HLE_Libc
+{
+// Rough costs of the SDK implementations of these functions. Games still have to see time pass
+// while they run, otherwise replacing them would change timing much more than necessary.
+constexpr s32 CALL_CYCLES = 16;
+// lwz + stw per word in the unrolled copy loop
+constexpr s32 COPY_BYTES_PER_CYCLE = 2;
+// stw per word in the unrolled fill loop
+constexpr s32 FILL_BYTES_PER_CYCLE = 4;
+// lbzu + cmpwi + bne per character
+constexpr s32 STRLEN_CYCLES_PER_BYTE = 3;
+
+static void AddCycles(s32 cycles)
+{
+  PowerPC::ppcState.downcount -= CALL_CYCLES + cycles;
+}
+
+// Returns a host pointer to the given range of emulated memory if the whole range is backed
+// by contiguous RAM and can be accessed without going through the slow memory path
+// (no MMIO, no memchecks, BAT translation only). Returns nullptr otherwise.
+static u8* GetContiguousRAMPointer(u32 address, u32 size, u32* physical_address_out = nullptr)
+{
+  if (size == 0)
+    return nullptr;
+
+  const u32 last_address = address + size - 1;
+  if (last_address < address)
+    return nullptr;
+
+  u32 physical_address = address;
+  if (!PowerPC::IsOptimizableRAMAddress(address) ||
+      !PowerPC::TranslateBatAddess(PowerPC::dbat_table, &physical_address))
+  {
+    return nullptr;
+  }
+
+  // BAT pages are 128 KiB, so large ranges may span several of them.
+  for (u32 page = (address >> PowerPC::BAT_INDEX_SHIFT) + 1;
+       page <= (last_address >> PowerPC::BAT_INDEX_SHIFT); ++page)
+  {
+    const u32 page_address = page << PowerPC::BAT_INDEX_SHIFT;
+    u32 physical_page_address = page_address;
+    if (!PowerPC::IsOptimizableRAMAddress(page_address) ||
+        !PowerPC::TranslateBatAddess(PowerPC::dbat_table, &physical_page_address) ||
+        physical_page_address != physical_address + (page_address - address))
+    {
+      return nullptr;
+    }
+  }
+
+  if (physical_address_out)
+    *physical_address_out = physical_address;
+  return Memory::GetPointer(physical_address);
+}
+
+static void Move(u32 dest, u32 src, u32 size)
+{
+  u32 physical_dest;
+  u8* const dest_ptr = GetContiguousRAMPointer(dest, size, &physical_dest);
+  const u8* const src_ptr = GetContiguousRAMPointer(src, size);
+  if (dest_ptr && src_ptr)
+  {
+    std::memmove(dest_ptr, src_ptr, size);
+    Memory::NotifyWrite(physical_dest, size);
+    return;
+  }
+
+  // Slow path: go through the regular memory access functions byte by byte,
+  // in the same direction memmove would use.
+  if (dest <= src)
+  {
+    for (u32 i = 0; i < size; ++i)
+      PowerPC::Write_U8(PowerPC::Read_U8(src + i), dest + i);
+  }
+  else
+  {
+    for (u32 i = size; i > 0; --i)
+      PowerPC::Write_U8(PowerPC::Read_U8(src + i - 1), dest + i - 1);
+  }
+}
+
+// void* memcpy(void* dest, const void* src, size_t n);
+void HLE_memcpy()
+{
+  const u32 dest = GPR(3);
+  const u32 src = GPR(4);
+  const u32 size = GPR(5);
+
+  Move(dest, src, size);
+
+  AddCycles(size / COPY_BYTES_PER_CYCLE);
+  NPC = LR;
+}
+
+// void* memmove(void* dest, const void* src, size_t n);
+void HLE_memmove()
+{
+  HLE_memcpy();
+}
+
+// void* memset(void* dest, int c, size_t n);
+void HLE_memset()
+{
+  const u32 dest = GPR(3);
+  const u8 value = static_cast<u8>(GPR(4));
+  const u32 size = GPR(5);
+
+  u32 physical_dest;
+  if (u8* const dest_ptr = GetContiguousRAMPointer(dest, size, &physical_dest))
+  {
+    std::memset(dest_ptr, value, size);
+    Memory::NotifyWrite(physical_dest, size);
+  }
+  else
+  {
+    for (u32 i = 0; i < size; ++i)
+      PowerPC::Write_U8(value, dest + i);
+  }
+
+  AddCycles(size / FILL_BYTES_PER_CYCLE);
+  NPC = LR;
+}
+
+// size_t strlen(const char* str);
+void HLE_strlen()
+{
+  const u32 str = GPR(3);
+
+  u32 length = 0;
+  while (true)
+  {
+    const u32 address = str + length;
+    const u32 bytes_left_in_page =
+        PowerPC::BAT_PAGE_SIZE - (address & (PowerPC::BAT_PAGE_SIZE - 1));
+    if (const u8* const ptr = GetContiguousRAMPointer(address, bytes_left_in_page))
+    {
+      const void* const terminator = std::memchr(ptr, 0, bytes_left_in_page);
+      if (terminator)
+      {
+        length += static_cast<u32>(static_cast<const u8*>(terminator) - ptr);
+        break;
+      }
+      length += bytes_left_in_page;
+    }
+    else
+    {
+      if (PowerPC::Read_U8(address) == 0)
+        break;
+      ++length;
+    }
+  }
+
+  GPR(3) = length;
+  AddCycles(length * STRLEN_CYCLES_PER_BYTE);
+  NPC = LR;
+}
+}  // namespace HLE_Libc
@@ -0,0 +1,13 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+namespace HLE_Libc
+{
+void HLE_memcpy();
+void HLE_memmove();
+void HLE_memset();
+void HLE_strlen();
+}  // namespace HLE_Libc
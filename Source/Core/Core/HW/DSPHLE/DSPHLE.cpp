@@ -7,6 +7,8 @@
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
+#include "Common/Thread.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 #include "Core/HW/SystemTimers.h"
@@ -15,10 +17,15 @@ namespace DSP::HLE
 {
 DSPHLE::DSPHLE() = default;
 
-DSPHLE::~DSPHLE() = default;
+DSPHLE::~DSPHLE()
+{
+  StopAsyncThread();
+}
 
 bool DSPHLE::Initialize(bool wii, bool dsp_thread)
 {
+  StopAsyncThread();
+
   m_wii = wii;
   m_ucode = nullptr;
   m_last_ucode = nullptr;
@@ -31,6 +38,9 @@ bool DSPHLE::Initialize(bool wii, bool dsp_thread)
 
   m_dsp_state.Reset();
 
+  if (Config::Get(Config::MAIN_DSP_HLE_THREAD))
+    StartAsyncThread();
+
   return true;
 }
 
@@ -40,9 +50,85 @@ void DSPHLE::DSP_StopSoundStream()
 
 void DSPHLE::Shutdown()
 {
+  StopAsyncThread();
   m_ucode = nullptr;
 }
 
+void DSPHLE::StartAsyncThread()
+{
+  m_async_shutdown.Clear();
+  m_async_thread = std::thread(&DSPHLE::AsyncThreadLoop, this);
+}
+
+void DSPHLE::StopAsyncThread()
+{
+  if (!m_async_thread.joinable())
+    return;
+
+  WaitForAsyncWork();
+  m_async_done = nullptr;
+  m_async_shutdown.Set();
+  m_async_work_available.Set();
+  m_async_thread.join();
+}
+
+void DSPHLE::AsyncThreadLoop()
+{
+  Common::SetCurrentThreadName("DSP HLE thread");
+
+  while (true)
+  {
+    m_async_work_available.Wait();
+    if (m_async_shutdown.IsSet())
+      break;
+
+    m_async_work();
+    m_async_work_done.Set();
+  }
+}
+
+void DSPHLE::RunAsync(std::function<void()> work, std::function<void()> done)
+{
+  FinishAsyncWork();
+
+  // Movies and netplay need the work to happen at a fixed point relative to the emulated CPU,
+  // as the guest could look at the memory it touches at any time.
+  if (!m_async_thread.joinable() || Core::WantsDeterminism())
+  {
+    work();
+    done();
+    return;
+  }
+
+  m_async_work = std::move(work);
+  m_async_done = std::move(done);
+  m_async_work_pending = true;
+  m_async_work_available.Set();
+}
+
+// Only waits for the DSP HLE thread. PauseAndLock calls this from the host thread, where the
+// completion can't run; it is left to the next FinishAsyncWork on the CPU thread instead.
+void DSPHLE::WaitForAsyncWork()
+{
+  if (!m_async_work_pending)
+    return;
+
+  m_async_work_done.Wait();
+  m_async_work_pending = false;
+}
+
+void DSPHLE::FinishAsyncWork()
+{
+  WaitForAsyncWork();
+
+  if (m_async_done)
+  {
+    auto done = std::move(m_async_done);
+    m_async_done = nullptr;
+    done();
+  }
+}
+
 void DSPHLE::DSP_Update(int cycles)
 {
   if (m_ucode != nullptr)
@@ -58,6 +144,7 @@ u32 DSPHLE::DSP_UpdateRate()
 
 void DSPHLE::SendMailToDSP(u32 mail)
 {
+  FinishAsyncWork();
   if (m_ucode != nullptr)
   {
     DEBUG_LOG(DSP_MAIL, "CPU writes 0x%08x", mail);
@@ -67,6 +154,7 @@ void DSPHLE::SendMailToDSP(u32 mail)
 
 void DSPHLE::SetUCode(u32 crc)
 {
+  FinishAsyncWork();
   m_mail_handler.Clear();
   m_ucode = UCodeFactory(crc, this, m_wii);
   m_ucode->Initialize();
@@ -77,6 +165,7 @@ void DSPHLE::SetUCode(u32 crc)
 // Even callers are deleted.
 void DSPHLE::SwapUCode(u32 crc)
 {
+  FinishAsyncWork();
   m_mail_handler.Clear();
 
   if (m_last_ucode == nullptr)
@@ -93,6 +182,8 @@ void DSPHLE::SwapUCode(u32 crc)
 
 void DSPHLE::DoState(PointerWrap& p)
 {
+  FinishAsyncWork();
+
   bool is_hle = true;
   p.Do(is_hle);
   if (!is_hle && p.GetMode() == PointerWrap::MODE_READ)
@@ -142,6 +233,7 @@ u16 DSPHLE::DSP_ReadMailBoxHigh(bool cpu_mailbox)
   }
   else
   {
+    FinishAsyncWork();
     return AccessMailHandler().ReadDSPMailboxHigh();
   }
 }
@@ -154,6 +246,7 @@ u16 DSPHLE::DSP_ReadMailBoxLow(bool cpu_mailbox)
   }
   else
   {
+    FinishAsyncWork();
     return AccessMailHandler().ReadDSPMailboxLow();
   }
 }
@@ -188,6 +281,8 @@ void DSPHLE::DSP_WriteMailBoxLow(bool cpu_mailbox, u16 value)
 // Other DSP functions
 u16 DSPHLE::DSP_WriteControlRegister(u16 value)
 {
+  FinishAsyncWork();
+
   DSP::UDSPControl temp(value);
 
   if (temp.DSPReset)
@@ -208,10 +303,15 @@ u16 DSPHLE::DSP_WriteControlRegister(u16 value)
 
 u16 DSPHLE::DSP_ReadControlRegister()
 {
+  // This is the first thing the DSP interrupt handler looks at, so results of the last command
+  // list have to be in memory by now.
+  FinishAsyncWork();
   return m_dsp_control.Hex;
 }
 
 void DSPHLE::PauseAndLock(bool do_lock, bool unpause_on_unlock)
 {
+  if (do_lock)
+    WaitForAsyncWork();
 }
 }  // namespace DSP::HLE
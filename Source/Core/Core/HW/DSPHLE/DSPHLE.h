@@ -4,9 +4,13 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <thread>
 
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Core/DSPEmulator.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/MailHandler.h"
@@ -43,9 +47,21 @@ public:
   void SetUCode(u32 crc);
   void SwapUCode(u32 crc);
 
+  // Runs ucode work on the DSP HLE thread if it is enabled, or right away otherwise. The work
+  // must only touch ucode state, and is waited for before the CPU can observe any of its
+  // results. done is then called on the CPU thread, so anything that talks to the CPU (mails,
+  // reads and writes of emulated memory) goes there or happens before RunAsync.
+  void RunAsync(std::function<void()> work, std::function<void()> done);
+  void FinishAsyncWork() override;
+
 private:
   void SendMailToDSP(u32 mail);
 
+  void StartAsyncThread();
+  void StopAsyncThread();
+  void AsyncThreadLoop();
+  void WaitForAsyncWork();
+
   // Fake mailbox utility
   struct DSPState
   {
@@ -70,5 +86,14 @@ private:
 
   bool m_halt;
   bool m_assert_interrupt;
+
+  std::thread m_async_thread;
+  std::function<void()> m_async_work;
+  // Only accessed from the CPU thread.
+  std::function<void()> m_async_done;
+  Common::Event m_async_work_available;
+  Common::Event m_async_work_done;
+  Common::Flag m_async_shutdown;
+  bool m_async_work_pending = false;
 };
 }  // namespace DSP::HLE
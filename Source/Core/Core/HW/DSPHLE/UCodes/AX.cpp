@@ -14,6 +14,7 @@
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Common/Trace.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/DSPHLE.h"
 #include "Core/HW/DSPHLE/MailHandler.h"
@@ -96,8 +97,47 @@ void AXUCode::SignalWorkEnd()
   m_mail_handler.PushMail(DSP_YIELD, true, AX_EMPTY_COMMAND_LIST_CYCLES);
 }
 
+void AXUCode::RunCommands()
+{
+  TRACE_SCOPE("AXUCode::RunCommands");
+
+  for (const auto& command : m_commands)
+    command();
+  m_commands.clear();
+  m_input_data.clear();
+}
+
+size_t AXUCode::CopyInput(u32 addr, u32 size)
+{
+  const size_t offset = m_input_data.size();
+  m_input_data.resize(offset + (size + sizeof(u32) - 1) / sizeof(u32));
+  HLEMemory_Read_Block(m_input_data.data() + offset, addr, size);
+  return offset;
+}
+
+void AXUCode::QueueOutput(u32 addr, const void* data, u32 size)
+{
+  const u8* bytes = static_cast<const u8*>(data);
+  m_outputs.push_back({addr, size});
+  m_output_data.insert(m_output_data.end(), bytes, bytes + size);
+}
+
+void AXUCode::WriteOutputs()
+{
+  const u8* data = m_output_data.data();
+  for (const PendingOutput& output : m_outputs)
+  {
+    HLEMemory_Write_Block(output.addr, data, output.size);
+    data += output.size;
+  }
+  m_outputs.clear();
+  m_output_data.clear();
+}
+
 void AXUCode::HandleCommandList()
 {
+  TRACE_SCOPE("AXUCode::HandleCommandList");
+
   // Temp variables for addresses computation
   u16 addr_hi, addr_lo;
   u16 addr2_hi, addr2_lo;
@@ -124,10 +164,13 @@ void AXUCode::HandleCommandList()
       // We still need to skip their arguments using "curr_idx += N".
 
     case CMD_SETUP:
+    {
       addr_hi = m_cmdlist[curr_idx++];
       addr_lo = m_cmdlist[curr_idx++];
-      SetupProcessing(HILO_TO_32(addr));
+      const size_t init_data = CopyInput(HILO_TO_32(addr), 0x20 * sizeof(u16));
+      m_commands.emplace_back([=] { SetupProcessing(GetInput<u16>(init_data)); });
       break;
+    }
 
     case CMD_DL_AND_VOL_MIX:
     {
@@ -136,7 +179,10 @@ void AXUCode::HandleCommandList()
       u16 vol_main = m_cmdlist[curr_idx++];
       u16 vol_auxa = m_cmdlist[curr_idx++];
       u16 vol_auxb = m_cmdlist[curr_idx++];
-      DownloadAndMixWithVolume(HILO_TO_32(addr), vol_main, vol_auxa, vol_auxb);
+      const size_t src = CopyInput(HILO_TO_32(addr), 3 * 5 * 32 * sizeof(int));
+      m_commands.emplace_back([=] {
+        DownloadAndMixWithVolume(GetInput<int>(src), vol_main, vol_auxa, vol_auxb);
+      });
       break;
     }
 
@@ -147,40 +193,52 @@ void AXUCode::HandleCommandList()
       break;
 
     case CMD_PROCESS:
-      ProcessPBList(pb_addr);
+      m_commands.emplace_back(
+          [this, pb_list = CopyPBList(pb_addr)] { ProcessPBList(pb_list); });
       break;
 
     case CMD_MIX_AUXA:
     case CMD_MIX_AUXB:
+    {
       // These two commands are handled almost the same internally.
       addr_hi = m_cmdlist[curr_idx++];
       addr_lo = m_cmdlist[curr_idx++];
       addr2_hi = m_cmdlist[curr_idx++];
       addr2_lo = m_cmdlist[curr_idx++];
-      MixAUXSamples(cmd - CMD_MIX_AUXA, HILO_TO_32(addr), HILO_TO_32(addr2));
+      const size_t src = CopyInput(HILO_TO_32(addr2), 3 * 5 * 32 * sizeof(int));
+      m_commands.emplace_back([=] {
+        MixAUXSamples(cmd - CMD_MIX_AUXA, HILO_TO_32(addr), GetInput<int>(src));
+      });
       break;
+    }
 
     case CMD_UPLOAD_LRS:
       addr_hi = m_cmdlist[curr_idx++];
       addr_lo = m_cmdlist[curr_idx++];
-      UploadLRS(HILO_TO_32(addr));
+      m_commands.emplace_back([=] { UploadLRS(HILO_TO_32(addr)); });
       break;
 
     case CMD_SET_LR:
+    {
       addr_hi = m_cmdlist[curr_idx++];
       addr_lo = m_cmdlist[curr_idx++];
-      SetMainLR(HILO_TO_32(addr));
+      const size_t src = CopyInput(HILO_TO_32(addr), 5 * 32 * sizeof(int));
+      m_commands.emplace_back([=] { SetMainLR(GetInput<int>(src)); });
       break;
+    }
 
     case CMD_UNK_08:
       curr_idx += 10;
       break;  // TODO: check
 
     case CMD_MIX_AUXB_NOWRITE:
+    {
       addr_hi = m_cmdlist[curr_idx++];
       addr_lo = m_cmdlist[curr_idx++];
-      MixAUXSamples(1, 0, HILO_TO_32(addr));
+      const size_t src = CopyInput(HILO_TO_32(addr), 3 * 5 * 32 * sizeof(int));
+      m_commands.emplace_back([=] { MixAUXSamples(1, 0, GetInput<int>(src)); });
       break;
+    }
 
     case CMD_COMPRESSOR_TABLE_ADDR:
       curr_idx += 2;
@@ -204,7 +262,7 @@ void AXUCode::HandleCommandList()
       addr_lo = m_cmdlist[curr_idx++];
       addr2_hi = m_cmdlist[curr_idx++];
       addr2_lo = m_cmdlist[curr_idx++];
-      OutputSamples(HILO_TO_32(addr2), HILO_TO_32(addr));
+      m_commands.emplace_back([=] { OutputSamples(HILO_TO_32(addr2), HILO_TO_32(addr)); });
       break;
 
     case CMD_END:
@@ -212,18 +270,24 @@ void AXUCode::HandleCommandList()
       break;
 
     case CMD_MIX_AUXB_LR:
+    {
       addr_hi = m_cmdlist[curr_idx++];
       addr_lo = m_cmdlist[curr_idx++];
       addr2_hi = m_cmdlist[curr_idx++];
       addr2_lo = m_cmdlist[curr_idx++];
-      MixAUXBLR(HILO_TO_32(addr), HILO_TO_32(addr2));
+      const size_t src = CopyInput(HILO_TO_32(addr2), 2 * 5 * 32 * sizeof(int));
+      m_commands.emplace_back([=] { MixAUXBLR(HILO_TO_32(addr), GetInput<int>(src)); });
       break;
+    }
 
     case CMD_SET_OPPOSITE_LR:
+    {
       addr_hi = m_cmdlist[curr_idx++];
       addr_lo = m_cmdlist[curr_idx++];
-      SetOppositeLR(HILO_TO_32(addr));
+      const size_t src = CopyInput(HILO_TO_32(addr), 5 * 32 * sizeof(int));
+      m_commands.emplace_back([=] { SetOppositeLR(GetInput<int>(src)); });
       break;
+    }
 
     case CMD_UNK_12:
     {
@@ -266,8 +330,16 @@ void AXUCode::HandleCommandList()
       u16 auxb_r_dl_hi = m_cmdlist[curr_idx++];
       u16 auxb_r_dl_lo = m_cmdlist[curr_idx++];
 
-      SendAUXAndMix(HILO_TO_32(main_auxa_up), HILO_TO_32(auxb_s_up), HILO_TO_32(main_l_dl),
-                    HILO_TO_32(main_r_dl), HILO_TO_32(auxb_l_dl), HILO_TO_32(auxb_r_dl));
+      constexpr u32 dl_size = 5 * 32 * sizeof(int);
+      const size_t main_l_src = CopyInput(HILO_TO_32(main_l_dl), dl_size);
+      const size_t main_r_src = CopyInput(HILO_TO_32(main_r_dl), dl_size);
+      const size_t auxb_l_src = CopyInput(HILO_TO_32(auxb_l_dl), dl_size);
+      const size_t auxb_r_src = CopyInput(HILO_TO_32(auxb_r_dl), dl_size);
+      m_commands.emplace_back([=] {
+        SendAUXAndMix(HILO_TO_32(main_auxa_up), HILO_TO_32(auxb_s_up), GetInput<int>(main_l_src),
+                      GetInput<int>(main_r_src), GetInput<int>(auxb_l_src),
+                      GetInput<int>(auxb_r_src));
+      });
       break;
     }
 
@@ -349,13 +421,8 @@ AXMixControl AXUCode::ConvertMixerControl(u32 mixer_control)
   return (AXMixControl)ret;
 }
 
-void AXUCode::SetupProcessing(u32 init_addr)
+void AXUCode::SetupProcessing(const u16* init_data)
 {
-  u16 init_data[0x20];
-
-  for (u32 i = 0; i < 0x20; ++i)
-    init_data[i] = HLEMemory_Read_U16(init_addr + 2 * i);
-
   // List of all buffers we have to initialize
   int* buffers[] = {m_samples_left,      m_samples_right,      m_samples_surround,
                     m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
@@ -364,8 +431,9 @@ void AXUCode::SetupProcessing(u32 init_addr)
   u32 init_idx = 0;
   for (auto& buffer : buffers)
   {
-    s32 init_val = (s32)((init_data[init_idx] << 16) | init_data[init_idx + 1]);
-    s16 delta = (s16)init_data[init_idx + 2];
+    s32 init_val = (s32)((Common::swap16(init_data[init_idx]) << 16) |
+                         Common::swap16(init_data[init_idx + 1]));
+    s16 delta = (s16)Common::swap16(init_data[init_idx + 2]);
 
     init_idx += 3;
 
@@ -384,7 +452,7 @@ void AXUCode::SetupProcessing(u32 init_addr)
   }
 }
 
-void AXUCode::DownloadAndMixWithVolume(u32 addr, u16 vol_main, u16 vol_auxa, u16 vol_auxb)
+void AXUCode::DownloadAndMixWithVolume(const int* src, u16 vol_main, u16 vol_auxa, u16 vol_auxb)
 {
   int* buffers_main[3] = {m_samples_left, m_samples_right, m_samples_surround};
   int* buffers_auxa[3] = {m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround};
@@ -394,7 +462,7 @@ void AXUCode::DownloadAndMixWithVolume(u32 addr, u16 vol_main, u16 vol_auxa, u16
 
   for (u32 i = 0; i < 3; ++i)
   {
-    int* ptr = (int*)HLEMemory_Get_Pointer(addr);
+    const int* ptr = src;
     u16 volume = volumes[i];
     for (u32 j = 0; j < 3; ++j)
     {
@@ -409,24 +477,52 @@ void AXUCode::DownloadAndMixWithVolume(u32 addr, u16 vol_main, u16 vol_auxa, u16
   }
 }
 
-void AXUCode::ProcessPBList(u32 pb_addr)
+std::vector<AXUCode::PBListEntry> AXUCode::CopyPBList(u32 pb_addr)
+{
+  std::vector<PBListEntry> pb_list;
+
+  while (pb_addr)
+  {
+    // Reuse the copy if an earlier list of this command list already processes the PB, so that
+    // this list sees its results like it would in memory.
+    auto it = std::find_if(m_pbs.begin(), m_pbs.end(),
+                           [pb_addr](const auto& copy) { return copy.first == pb_addr; });
+    if (it == m_pbs.end())
+    {
+      AXPB pb;
+      ReadPB(pb_addr, pb, m_crc);
+      it = m_pbs.emplace(m_pbs.end(), pb_addr, pb);
+    }
+    const AXPB& pb = it->second;
+
+    u32 updates_count = 0;
+    for (u16 num_updates : pb.updates.num_updates)
+      updates_count += num_updates;
+    const size_t updates =
+        CopyInput(HILO_TO_32(pb.updates.data), updates_count * 2 * sizeof(u16));
+
+    pb_list.push_back({static_cast<size_t>(it - m_pbs.begin()), updates});
+    pb_addr = HILO_TO_32(pb.next_pb);
+  }
+
+  return pb_list;
+}
+
+void AXUCode::ProcessPBList(const std::vector<PBListEntry>& pb_list)
 {
   // Samples per millisecond. In theory DSP sampling rate can be changed from
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPB pb;
-
-  while (pb_addr)
+  for (const PBListEntry& entry : pb_list)
   {
+    AXPB& pb = m_pbs[entry.pb_index].second;
+
     AXBuffers buffers = {{m_samples_left, m_samples_right, m_samples_surround, m_samples_auxA_left,
                           m_samples_auxA_right, m_samples_auxA_surround, m_samples_auxB_left,
                           m_samples_auxB_right, m_samples_auxB_surround}};
 
-    ReadPB(pb_addr, pb, m_crc);
-
-    u32 updates_addr = HILO_TO_32(pb.updates.data);
-    u16* updates = (u16*)HLEMemory_Get_Pointer(updates_addr);
+    const u16* updates = GetInput<u16>(entry.updates_offset);
 
     for (int curr_ms = 0; curr_ms < 5; ++curr_ms)
     {
@@ -439,13 +535,17 @@ void AXUCode::ProcessPBList(u32 pb_addr)
       for (auto& ptr : buffers.ptrs)
         ptr += spms;
     }
+  }
+}
 
+void AXUCode::WritePBs()
+{
+  for (const auto& [pb_addr, pb] : m_pbs)
     WritePB(pb_addr, pb, m_crc);
-    pb_addr = HILO_TO_32(pb.next_pb);
-  }
+  m_pbs.clear();
 }
 
-void AXUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr)
+void AXUCode::MixAUXSamples(int aux_id, u32 write_addr, const int* src)
 {
   int* buffers[3] = {nullptr};
 
@@ -467,15 +567,17 @@ void AXUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr)
   // First, we need to send the contents of our AUX buffers to the CPU.
   if (write_addr)
   {
-    int* ptr = (int*)HLEMemory_Get_Pointer(write_addr);
+    int upload_buffer[3 * 5 * 32];
+    int* ptr = upload_buffer;
     for (auto& buffer : buffers)
       for (u32 j = 0; j < 5 * 32; ++j)
         *ptr++ = Common::swap32(buffer[j]);
+    QueueOutput(write_addr, upload_buffer, sizeof(upload_buffer));
   }
 
   // Then, we read the new temp from the CPU and add to our current
   // temp.
-  int* ptr = (int*)HLEMemory_Get_Pointer(read_addr);
+  const int* ptr = src;
   for (auto& sample : m_samples_left)
     sample += (int)Common::swap32(*ptr++);
   for (auto& sample : m_samples_right)
@@ -494,12 +596,12 @@ void AXUCode::UploadLRS(u32 dst_addr)
     buffers[1][i] = Common::swap32(m_samples_right[i]);
     buffers[2][i] = Common::swap32(m_samples_surround[i]);
   }
-  memcpy(HLEMemory_Get_Pointer(dst_addr), buffers, sizeof(buffers));
+  QueueOutput(dst_addr, buffers, sizeof(buffers));
 }
 
-void AXUCode::SetMainLR(u32 src_addr)
+void AXUCode::SetMainLR(const int* src)
 {
-  int* ptr = (int*)HLEMemory_Get_Pointer(src_addr);
+  const int* ptr = src;
   for (u32 i = 0; i < 5 * 32; ++i)
   {
     int samp = (int)Common::swap32(*ptr++);
@@ -515,7 +617,7 @@ void AXUCode::OutputSamples(u32 lr_addr, u32 surround_addr)
 
   for (u32 i = 0; i < 5 * 32; ++i)
     surround_buffer[i] = Common::swap32(m_samples_surround[i]);
-  memcpy(HLEMemory_Get_Pointer(surround_addr), surround_buffer, sizeof(surround_buffer));
+  QueueOutput(surround_addr, surround_buffer, sizeof(surround_buffer));
 
   // 32 samples per ms, 5 ms, 2 channels
   short buffer[5 * 32 * 2];
@@ -530,20 +632,22 @@ void AXUCode::OutputSamples(u32 lr_addr, u32 surround_addr)
     buffer[2 * i + 1] = Common::swap16(left);
   }
 
-  memcpy(HLEMemory_Get_Pointer(lr_addr), buffer, sizeof(buffer));
+  QueueOutput(lr_addr, buffer, sizeof(buffer));
 }
 
-void AXUCode::MixAUXBLR(u32 ul_addr, u32 dl_addr)
+void AXUCode::MixAUXBLR(u32 ul_addr, const int* src)
 {
   // Upload AUXB L/R
-  int* ptr = (int*)HLEMemory_Get_Pointer(ul_addr);
+  int upload_buffer[2 * 5 * 32];
+  int* up_ptr = upload_buffer;
   for (auto& sample : m_samples_auxB_left)
-    *ptr++ = Common::swap32(sample);
+    *up_ptr++ = Common::swap32(sample);
   for (auto& sample : m_samples_auxB_right)
-    *ptr++ = Common::swap32(sample);
+    *up_ptr++ = Common::swap32(sample);
+  QueueOutput(ul_addr, upload_buffer, sizeof(upload_buffer));
 
   // Mix AUXB L/R to MAIN L/R, and replace AUXB L/R
-  ptr = (int*)HLEMemory_Get_Pointer(dl_addr);
+  const int* ptr = src;
   for (u32 i = 0; i < 5 * 32; ++i)
   {
     int samp = Common::swap32(*ptr++);
@@ -558,9 +662,9 @@ void AXUCode::MixAUXBLR(u32 ul_addr, u32 dl_addr)
   }
 }
 
-void AXUCode::SetOppositeLR(u32 src_addr)
+void AXUCode::SetOppositeLR(const int* src)
 {
-  int* ptr = (int*)HLEMemory_Get_Pointer(src_addr);
+  const int* ptr = src;
   for (u32 i = 0; i < 5 * 32; ++i)
   {
     int inp = Common::swap32(*ptr++);
@@ -570,8 +674,8 @@ void AXUCode::SetOppositeLR(u32 src_addr)
   }
 }
 
-void AXUCode::SendAUXAndMix(u32 main_auxa_up, u32 auxb_s_up, u32 main_l_dl, u32 main_r_dl,
-                            u32 auxb_l_dl, u32 auxb_r_dl)
+void AXUCode::SendAUXAndMix(u32 main_auxa_up, u32 auxb_s_up, const int* main_l_src,
+                            const int* main_r_src, const int* auxb_l_src, const int* auxb_r_src)
 {
   // Buffers to upload first
   const std::array<const int*, 3> up_buffers{
@@ -581,36 +685,39 @@ void AXUCode::SendAUXAndMix(u32 main_auxa_up, u32 auxb_s_up, u32 main_l_dl, u32
   };
 
   // Upload AUXA LRS
-  int* ptr = (int*)HLEMemory_Get_Pointer(main_auxa_up);
+  int upload_buffer[3 * 32 * 5];
+  int* ptr = upload_buffer;
   for (const auto& up_buffer : up_buffers)
   {
     for (u32 j = 0; j < 32 * 5; ++j)
       *ptr++ = Common::swap32(up_buffer[j]);
   }
+  QueueOutput(main_auxa_up, upload_buffer, sizeof(upload_buffer));
 
   // Upload AUXB S
-  ptr = (int*)HLEMemory_Get_Pointer(auxb_s_up);
+  ptr = upload_buffer;
   for (auto& sample : m_samples_auxB_surround)
     *ptr++ = Common::swap32(sample);
+  QueueOutput(auxb_s_up, upload_buffer, sizeof(m_samples_auxB_surround));
 
-  // Download buffers and addresses
+  // Download buffers and sources
   const std::array<int*, 4> dl_buffers{
       m_samples_left,
       m_samples_right,
       m_samples_auxB_left,
       m_samples_auxB_right,
   };
-  const std::array<u32, 4> dl_addrs{
-      main_l_dl,
-      main_r_dl,
-      auxb_l_dl,
-      auxb_r_dl,
+  const std::array<const int*, 4> dl_srcs{
+      main_l_src,
+      main_r_src,
+      auxb_l_src,
+      auxb_r_src,
   };
 
   // Download and mix
   for (size_t i = 0; i < dl_buffers.size(); ++i)
   {
-    const int* dl_src = (int*)HLEMemory_Get_Pointer(dl_addrs[i]);
+    const int* dl_src = dl_srcs[i];
     for (size_t j = 0; j < 32 * 5; ++j)
       dl_buffers[i][j] += (int)Common::swap32(*dl_src++);
   }
@@ -626,9 +733,17 @@ void AXUCode::HandleMail(u32 mail)
 
   if (next_is_cmdlist)
   {
+    // The command list is parsed here, which also copies the PBs and queues any mails, so the
+    // DSP HLE thread only runs the queued commands. The end of work is still signalled right
+    // away so that interrupt timing doesn't depend on the host.
     CopyCmdList(mail, cmdlist_size);
     HandleCommandList();
     m_cmdlist_size = 0;
+    m_dsphle->RunAsync([this] { RunCommands(); },
+                       [this] {
+                         WriteOutputs();
+                         WritePBs();
+                       });
     SignalWorkEnd();
   }
   else if (m_upload_setup_in_progress)
@@ -12,9 +12,14 @@
 
 #pragma once
 
+#include <functional>
+#include <utility>
+#include <vector>
+
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Swap.h"
+#include "Core/HW/DSPHLE/UCodes/AXStructs.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 
 namespace DSP::HLE
@@ -93,6 +98,36 @@ protected:
   u16 m_cmdlist[512];
   u32 m_cmdlist_size;
 
+  // HandleCommandList parses the command list on the CPU thread and queues the work here, so
+  // that only RunCommands can end up on the DSP HLE thread.
+  std::vector<std::function<void()>> m_commands;
+
+  // Copies of the PBs used by the queued commands, taken while parsing and written back to
+  // memory by WritePBs once the commands have run. A PB is only copied once per command list,
+  // even if several lists process it.
+  std::vector<std::pair<u32, AXPB>> m_pbs;
+
+  // A PB processed by a queued command: the index of its copy, and the offset of the copy of its
+  // updates in m_input_data.
+  struct PBListEntry
+  {
+    size_t pb_index;
+    size_t updates_offset;
+  };
+
+  // Guest memory read by the queued commands. Like the PBs, it is copied while parsing so that
+  // the commands never access RAM; they find their copy by offset.
+  std::vector<u32> m_input_data;
+
+  // Guest memory written by the queued commands, in order, and copied to RAM by WriteOutputs.
+  struct PendingOutput
+  {
+    u32 addr;
+    u32 size;
+  };
+  std::vector<PendingOutput> m_outputs;
+  std::vector<u8> m_output_data;
+
   // Table of coefficients for polyphase sample rate conversion.
   // The coefficients aren't always available (they are part of the DSP DROM)
   // so we also need to know if they are valid or not.
@@ -111,7 +146,7 @@ protected:
 
   // Apply updates to a PB. Generic, used in AX GC and AX Wii.
   template <typename PBType>
-  void ApplyUpdatesForMs(int curr_ms, PBType& pb, u16* num_updates, u16* updates)
+  void ApplyUpdatesForMs(int curr_ms, PBType& pb, const u16* num_updates, const u16* updates)
   {
     auto pb_mem = Common::BitCastToArray<u16>(pb);
 
@@ -131,19 +166,34 @@ protected:
   }
 
   virtual void HandleCommandList();
+  void RunCommands();
+  virtual void WritePBs();
   void SignalWorkEnd();
 
-  void SetupProcessing(u32 init_addr);
-  void DownloadAndMixWithVolume(u32 addr, u16 vol_main, u16 vol_auxa, u16 vol_auxb);
-  void ProcessPBList(u32 pb_addr);
-  void MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr);
+  // Copies size bytes of guest memory for a queued command and returns the offset of the copy.
+  size_t CopyInput(u32 addr, u32 size);
+  template <typename T>
+  const T* GetInput(size_t offset) const
+  {
+    return reinterpret_cast<const T*>(m_input_data.data() + offset);
+  }
+
+  // Queues a write to guest memory from a command.
+  void QueueOutput(u32 addr, const void* data, u32 size);
+  void WriteOutputs();
+
+  void SetupProcessing(const u16* init_data);
+  void DownloadAndMixWithVolume(const int* src, u16 vol_main, u16 vol_auxa, u16 vol_auxb);
+  std::vector<PBListEntry> CopyPBList(u32 pb_addr);
+  void ProcessPBList(const std::vector<PBListEntry>& pb_list);
+  void MixAUXSamples(int aux_id, u32 write_addr, const int* src);
   void UploadLRS(u32 dst_addr);
-  void SetMainLR(u32 src_addr);
+  void SetMainLR(const int* src);
   void OutputSamples(u32 out_addr, u32 surround_addr);
-  void MixAUXBLR(u32 ul_addr, u32 dl_addr);
-  void SetOppositeLR(u32 src_addr);
-  void SendAUXAndMix(u32 main_auxa_up, u32 auxb_s_up, u32 main_l_dl, u32 main_r_dl, u32 auxb_l_dl,
-                     u32 auxb_r_dl);
+  void MixAUXBLR(u32 ul_addr, const int* src);
+  void SetOppositeLR(const int* src);
+  void SendAUXAndMix(u32 main_auxa_up, u32 auxb_s_up, const int* main_l_src,
+                     const int* main_r_src, const int* auxb_l_src, const int* auxb_r_src);
 
   // Handle save states for main AX.
   void DoAXState(PointerWrap& p);
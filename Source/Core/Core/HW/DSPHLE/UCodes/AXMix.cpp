@@ -0,0 +1,132 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
+
+#include <algorithm>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
+
+namespace DSP::HLE
+{
+#ifdef _M_X86
+// Mixes samples eight at a time and returns how many were mixed, like MixAddSSE41.
+FUNCTION_TARGET_AVX2
+static u32 MixAddAVX2(int* out, const s16* input, u32 count, u16& volume, u16 volume_delta,
+                      s16* dpop)
+{
+  const u32 vector_count = count & ~7u;
+  if (vector_count == 0)
+    return 0;
+
+  const __m256i volume_mask = _mm256_set1_epi32(0xFFFF);
+  const __m256i min_sample = _mm256_set1_epi32(-32767);
+  const __m256i max_sample = _mm256_set1_epi32(32767);
+  const __m256i volume_step = _mm256_set1_epi32(volume_delta * 8);
+  const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  __m256i volumes = _mm256_set1_epi32(volume);
+  volumes = _mm256_add_epi32(volumes, _mm256_mullo_epi32(_mm256_set1_epi32(volume_delta), lanes));
+  __m256i samples = _mm256_setzero_si256();
+
+  for (u32 i = 0; i < vector_count; i += 8)
+  {
+    const __m256i in =
+        _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)));
+    samples = _mm256_mullo_epi32(in, _mm256_and_si256(volumes, volume_mask));
+    samples = _mm256_srai_epi32(samples, 15);
+    samples = _mm256_min_epi32(_mm256_max_epi32(samples, min_sample), max_sample);
+
+    __m256i* const dst = reinterpret_cast<__m256i*>(out + i);
+    _mm256_storeu_si256(dst, _mm256_add_epi32(_mm256_loadu_si256(dst), samples));
+    volumes = _mm256_add_epi32(volumes, volume_step);
+  }
+
+  volume += static_cast<u16>(volume_delta * vector_count);
+  *dpop = static_cast<s16>(_mm256_extract_epi32(samples, 7));
+  return vector_count;
+}
+
+// Mixes samples four at a time and returns how many were mixed. The products of a sample and a
+// volume always fit in 32 bits, so this matches the scalar path exactly.
+FUNCTION_TARGET_SSR41
+static u32 MixAddSSE41(int* out, const s16* input, u32 count, u16& volume, u16 volume_delta,
+                       s16* dpop)
+{
+  const u32 vector_count = count & ~3u;
+  if (vector_count == 0)
+    return 0;
+
+  const __m128i volume_mask = _mm_set1_epi32(0xFFFF);
+  const __m128i min_sample = _mm_set1_epi32(-32767);
+  const __m128i max_sample = _mm_set1_epi32(32767);
+  const __m128i volume_step = _mm_set1_epi32(volume_delta * 4);
+  __m128i volumes = _mm_setr_epi32(volume, volume + volume_delta, volume + 2 * volume_delta,
+                                   volume + 3 * volume_delta);
+  __m128i samples = _mm_setzero_si128();
+
+  for (u32 i = 0; i < vector_count; i += 4)
+  {
+    const __m128i in =
+        _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + i)));
+    samples = _mm_mullo_epi32(in, _mm_and_si128(volumes, volume_mask));
+    samples = _mm_srai_epi32(samples, 15);
+    samples = _mm_min_epi32(_mm_max_epi32(samples, min_sample), max_sample);
+
+    __m128i* const dst = reinterpret_cast<__m128i*>(out + i);
+    _mm_storeu_si128(dst, _mm_add_epi32(_mm_loadu_si128(dst), samples));
+    volumes = _mm_add_epi32(volumes, volume_step);
+  }
+
+  volume += static_cast<u16>(volume_delta * vector_count);
+  *dpop = static_cast<s16>(_mm_extract_epi32(samples, 3));
+  return vector_count;
+}
+#endif
+
+void MixAddScalar(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ramp)
+{
+  u16& volume = pvol[0];
+  u16 volume_delta = pvol[1];
+
+  // If volume ramping is disabled, set volume_delta to 0. That way, the
+  // mixing loop can avoid testing if volume ramping is enabled at each step,
+  // and just add volume_delta.
+  if (!ramp)
+    volume_delta = 0;
+
+  for (u32 i = 0; i < count; ++i)
+  {
+    s64 sample = input[i];
+    sample *= volume;
+    sample >>= 15;
+    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
+
+    out[i] += (s16)sample;
+    volume += volume_delta;
+
+    *dpop = (s16)sample;
+  }
+}
+
+void MixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ramp)
+{
+  u32 mixed = 0;
+
+#ifdef _M_X86
+  const u16 volume_delta = ramp ? pvol[1] : 0;
+  if (cpu_info.bAVX2)
+    mixed = MixAddAVX2(out, input, count, pvol[0], volume_delta, dpop);
+  if (cpu_info.bSSE4_1)
+  {
+    mixed += MixAddSSE41(out + mixed, input + mixed, count - mixed, pvol[0], volume_delta,
+                         dpop);
+  }
+#endif
+
+  // Mix whatever is left over.
+  MixAddScalar(out + mixed, input + mixed, count - mixed, pvol, dpop, ramp);
+}
+}  // namespace DSP::HLE
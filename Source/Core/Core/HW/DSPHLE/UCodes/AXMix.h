@@ -0,0 +1,18 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace DSP::HLE
+{
+// Add samples to an output buffer, with optional volume ramping. pvol points to the volume and
+// volume delta of the mixer, the volume is updated in place. The last mixed sample is stored to
+// dpop. Uses a SIMD implementation when the host supports it.
+void MixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ramp);
+
+// Reference implementation of MixAdd. The SIMD implementations must match it exactly.
+void MixAddScalar(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ramp);
+}  // namespace DSP::HLE
@@ -20,6 +20,7 @@
 #include "Core/DSP/DSPAccelerator.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/UCodes/AX.h"
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
 #include "Core/HW/Memmap.h"
 
@@ -394,32 +395,6 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
   pb.adpcm.pred_scale = s_accelerator->GetPredScale();
 }
 
-// Add samples to an output buffer, with optional volume ramping.
-void MixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ramp)
-{
-  u16& volume = pvol[0];
-  u16 volume_delta = pvol[1];
-
-  // If volume ramping is disabled, set volume_delta to 0. That way, the
-  // mixing loop can avoid testing if volume ramping is enabled at each step,
-  // and just add volume_delta.
-  if (!ramp)
-    volume_delta = 0;
-
-  for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
-
-    out[i] += (s16)sample;
-    volume += volume_delta;
-
-    *dpop = (s16)sample;
-  }
-}
-
 // Execute a low pass filter on the samples using one history value. Returns
 // the new history value.
 s16 LowPassFilter(s16* samples, u32 count, s16 yn1, u16 a0, u16 b0)
@@ -13,6 +13,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Common/Trace.h"
 #include "Core/HW/DSPHLE/DSPHLE.h"
 #include "Core/HW/DSPHLE/MailHandler.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
@@ -37,6 +38,8 @@ AXWiiUCode::~AXWiiUCode()
 
 void AXWiiUCode::HandleCommandList()
 {
+  TRACE_SCOPE("AXWiiUCode::HandleCommandList");
+
   // Temp variables for addresses computation
   u16 addr_hi, addr_lo;
   u16 addr2_hi, addr2_lo;
@@ -63,23 +66,32 @@ void AXWiiUCode::HandleCommandList()
         // We still need to skip their arguments using "curr_idx += N".
 
       case CMD_SETUP_OLD:
+      {
         addr_hi = m_cmdlist[curr_idx++];
         addr_lo = m_cmdlist[curr_idx++];
-        SetupProcessing(HILO_TO_32(addr));
+        const size_t init_data = CopyInput(HILO_TO_32(addr), 60 * sizeof(u16));
+        m_commands.emplace_back([=] { SetupProcessing(GetInput<u16>(init_data)); });
         break;
+      }
 
       case CMD_ADD_TO_LR_OLD:
       case CMD_SUB_TO_LR_OLD:
+      {
         addr_hi = m_cmdlist[curr_idx++];
         addr_lo = m_cmdlist[curr_idx++];
-        AddToLR(HILO_TO_32(addr), cmd == CMD_SUB_TO_LR_OLD);
+        const size_t src = CopyInput(HILO_TO_32(addr), 32 * 3 * sizeof(int));
+        m_commands.emplace_back([=] { AddToLR(GetInput<int>(src), cmd == CMD_SUB_TO_LR_OLD); });
         break;
+      }
 
       case CMD_ADD_SUB_TO_LR_OLD:
+      {
         addr_hi = m_cmdlist[curr_idx++];
         addr_lo = m_cmdlist[curr_idx++];
-        AddSubToLR(HILO_TO_32(addr));
+        const size_t src = CopyInput(HILO_TO_32(addr), 2 * 32 * 3 * sizeof(int));
+        m_commands.emplace_back([=] { AddSubToLR(GetInput<int>(src)); });
         break;
+      }
 
       case CMD_PB_ADDR_OLD:
         addr_hi = m_cmdlist[curr_idx++];
@@ -88,19 +100,25 @@ void AXWiiUCode::HandleCommandList()
         break;
 
       case CMD_PROCESS_OLD:
-        ProcessPBList(pb_addr);
+        m_commands.emplace_back(
+            [this, pb_list = CopyPBList(pb_addr)] { ProcessPBList(pb_list); });
         break;
 
       case CMD_MIX_AUXA_OLD:
       case CMD_MIX_AUXB_OLD:
       case CMD_MIX_AUXC_OLD:
+      {
         volume = m_cmdlist[curr_idx++];
         addr_hi = m_cmdlist[curr_idx++];
         addr_lo = m_cmdlist[curr_idx++];
         addr2_hi = m_cmdlist[curr_idx++];
         addr2_lo = m_cmdlist[curr_idx++];
-        MixAUXSamples(cmd - CMD_MIX_AUXA_OLD, HILO_TO_32(addr), HILO_TO_32(addr2), volume);
+        const size_t src = CopyInput(HILO_TO_32(addr2), 3 * 32 * 3 * sizeof(int));
+        m_commands.emplace_back([=] {
+          MixAUXSamples(cmd - CMD_MIX_AUXA_OLD, HILO_TO_32(addr), GetInput<int>(src), volume);
+        });
         break;
+      }
 
       case CMD_UPL_AUXA_MIX_LRSC_OLD:
       case CMD_UPL_AUXB_MIX_LRSC_OLD:
@@ -115,7 +133,13 @@ void AXWiiUCode::HandleCommandList()
             (u32)(m_cmdlist[curr_idx + 10] << 16) | m_cmdlist[curr_idx + 11],
         };
         curr_idx += 12;
-        UploadAUXMixLRSC(cmd == CMD_UPL_AUXB_MIX_LRSC_OLD, addresses, volume);
+        const size_t src = CopyInput(addresses[2], 32 * 3 * sizeof(int));
+        for (int i = 3; i < 6; ++i)
+          CopyInput(addresses[i], 32 * 3 * sizeof(int));
+        m_commands.emplace_back([=] {
+          UploadAUXMixLRSC(cmd == CMD_UPL_AUXB_MIX_LRSC_OLD, addresses, GetInput<int>(src),
+                           volume);
+        });
         break;
       }
 
@@ -131,7 +155,10 @@ void AXWiiUCode::HandleCommandList()
         addr_lo = m_cmdlist[curr_idx++];
         addr2_hi = m_cmdlist[curr_idx++];
         addr2_lo = m_cmdlist[curr_idx++];
-        OutputSamples(HILO_TO_32(addr2), HILO_TO_32(addr), 0x8000, cmd == CMD_OUTPUT_DPL2_OLD);
+        m_commands.emplace_back([=] {
+          OutputSamples(HILO_TO_32(addr2), HILO_TO_32(addr), 0x8000, cmd == CMD_OUTPUT_DPL2_OLD);
+        });
+        m_mail_handler.PushMail(DSP_SYNC, true);
         break;
 
       case CMD_WM_OUTPUT_OLD:
@@ -143,7 +170,7 @@ void AXWiiUCode::HandleCommandList()
             (u32)(m_cmdlist[curr_idx + 6] << 16) | m_cmdlist[curr_idx + 7],
         };
         curr_idx += 8;
-        OutputWMSamples(addresses);
+        m_commands.emplace_back([=] { OutputWMSamples(addresses); });
         break;
       }
 
@@ -160,40 +187,57 @@ void AXWiiUCode::HandleCommandList()
         // We still need to skip their arguments using "curr_idx += N".
 
       case CMD_SETUP:
+      {
         addr_hi = m_cmdlist[curr_idx++];
         addr_lo = m_cmdlist[curr_idx++];
-        SetupProcessing(HILO_TO_32(addr));
+        const size_t init_data = CopyInput(HILO_TO_32(addr), 60 * sizeof(u16));
+        m_commands.emplace_back([=] { SetupProcessing(GetInput<u16>(init_data)); });
         break;
+      }
 
       case CMD_ADD_TO_LR:
       case CMD_SUB_TO_LR:
+      {
         addr_hi = m_cmdlist[curr_idx++];
         addr_lo = m_cmdlist[curr_idx++];
-        AddToLR(HILO_TO_32(addr), cmd == CMD_SUB_TO_LR);
+        const size_t src = CopyInput(HILO_TO_32(addr), 32 * 3 * sizeof(int));
+        m_commands.emplace_back([=] { AddToLR(GetInput<int>(src), cmd == CMD_SUB_TO_LR); });
         break;
+      }
 
       case CMD_ADD_SUB_TO_LR:
+      {
         addr_hi = m_cmdlist[curr_idx++];
         addr_lo = m_cmdlist[curr_idx++];
-        AddSubToLR(HILO_TO_32(addr));
+        const size_t src = CopyInput(HILO_TO_32(addr), 2 * 32 * 3 * sizeof(int));
+        m_commands.emplace_back([=] { AddSubToLR(GetInput<int>(src)); });
         break;
+      }
 
       case CMD_PROCESS:
+      {
         addr_hi = m_cmdlist[curr_idx++];
         addr_lo = m_cmdlist[curr_idx++];
-        ProcessPBList(HILO_TO_32(addr));
+        m_commands.emplace_back(
+            [this, pb_list = CopyPBList(HILO_TO_32(addr))] { ProcessPBList(pb_list); });
         break;
+      }
 
       case CMD_MIX_AUXA:
       case CMD_MIX_AUXB:
       case CMD_MIX_AUXC:
+      {
         volume = m_cmdlist[curr_idx++];
         addr_hi = m_cmdlist[curr_idx++];
         addr_lo = m_cmdlist[curr_idx++];
         addr2_hi = m_cmdlist[curr_idx++];
         addr2_lo = m_cmdlist[curr_idx++];
-        MixAUXSamples(cmd - CMD_MIX_AUXA, HILO_TO_32(addr), HILO_TO_32(addr2), volume);
+        const size_t src = CopyInput(HILO_TO_32(addr2), 3 * 32 * 3 * sizeof(int));
+        m_commands.emplace_back([=] {
+          MixAUXSamples(cmd - CMD_MIX_AUXA, HILO_TO_32(addr), GetInput<int>(src), volume);
+        });
         break;
+      }
 
       case CMD_UPL_AUXA_MIX_LRSC:
       case CMD_UPL_AUXB_MIX_LRSC:
@@ -208,7 +252,13 @@ void AXWiiUCode::HandleCommandList()
             (u32)(m_cmdlist[curr_idx + 10] << 16) | m_cmdlist[curr_idx + 11],
         };
         curr_idx += 12;
-        UploadAUXMixLRSC(cmd == CMD_UPL_AUXB_MIX_LRSC, addresses, volume);
+        const size_t src = CopyInput(addresses[2], 32 * 3 * sizeof(int));
+        for (int i = 3; i < 6; ++i)
+          CopyInput(addresses[i], 32 * 3 * sizeof(int));
+        m_commands.emplace_back([=] {
+          UploadAUXMixLRSC(cmd == CMD_UPL_AUXB_MIX_LRSC, addresses, GetInput<int>(src),
+                           volume);
+        });
         break;
       }
 
@@ -225,7 +275,10 @@ void AXWiiUCode::HandleCommandList()
         addr_lo = m_cmdlist[curr_idx++];
         addr2_hi = m_cmdlist[curr_idx++];
         addr2_lo = m_cmdlist[curr_idx++];
-        OutputSamples(HILO_TO_32(addr2), HILO_TO_32(addr), volume, cmd == CMD_OUTPUT_DPL2);
+        m_commands.emplace_back([=] {
+          OutputSamples(HILO_TO_32(addr2), HILO_TO_32(addr), volume, cmd == CMD_OUTPUT_DPL2);
+        });
+        m_mail_handler.PushMail(DSP_SYNC, true);
         break;
 
       case CMD_WM_OUTPUT:
@@ -237,7 +290,7 @@ void AXWiiUCode::HandleCommandList()
             (u32)(m_cmdlist[curr_idx + 6] << 16) | m_cmdlist[curr_idx + 7],
         };
         curr_idx += 8;
-        OutputWMSamples(addresses);
+        m_commands.emplace_back([=] { OutputWMSamples(addresses); });
         break;
       }
 
@@ -249,14 +302,9 @@ void AXWiiUCode::HandleCommandList()
   }
 }
 
-void AXWiiUCode::SetupProcessing(u32 init_addr)
+void AXWiiUCode::SetupProcessing(const u16* init_data)
 {
   // TODO: should be easily factorizable with AX
-  s16 init_data[60];
-
-  for (u32 i = 0; i < 60; ++i)
-    init_data[i] = HLEMemory_Read_U16(init_addr + 2 * i);
-
   // List of all buffers we have to initialize
   struct
   {
@@ -275,8 +323,9 @@ void AXWiiUCode::SetupProcessing(u32 init_addr)
   u32 init_idx = 0;
   for (auto& buffer : buffers)
   {
-    s32 init_val = (s32)((init_data[init_idx] << 16) | init_data[init_idx + 1]);
-    s16 delta = (s16)init_data[init_idx + 2];
+    s32 init_val = (s32)((Common::swap16(init_data[init_idx]) << 16) |
+                         Common::swap16(init_data[init_idx + 1]));
+    s16 delta = (s16)Common::swap16(init_data[init_idx + 2]);
 
     init_idx += 3;
 
@@ -295,9 +344,9 @@ void AXWiiUCode::SetupProcessing(u32 init_addr)
   }
 }
 
-void AXWiiUCode::AddToLR(u32 val_addr, bool neg)
+void AXWiiUCode::AddToLR(const int* src, bool neg)
 {
-  int* ptr = (int*)HLEMemory_Get_Pointer(val_addr);
+  const int* ptr = src;
   for (int i = 0; i < 32 * 3; ++i)
   {
     int val = (int)Common::swap32(*ptr++);
@@ -309,9 +358,9 @@ void AXWiiUCode::AddToLR(u32 val_addr, bool neg)
   }
 }
 
-void AXWiiUCode::AddSubToLR(u32 val_addr)
+void AXWiiUCode::AddSubToLR(const int* src)
 {
-  int* ptr = (int*)HLEMemory_Get_Pointer(val_addr);
+  const int* ptr = src;
   for (int i = 0; i < 32 * 3; ++i)
   {
     int val = (int)Common::swap32(*ptr++);
@@ -382,8 +431,8 @@ void AXWiiUCode::GenerateVolumeRamp(u16* output, u16 vol1, u16 vol2, size_t nval
   }
 }
 
-bool AXWiiUCode::ExtractUpdatesFields(AXPBWii& pb, u16* num_updates, u16* updates,
-                                      u32* updates_addr)
+bool AXWiiUCode::ExtractUpdatesFields(AXPBWii& pb, const u16* updates_data, u16* num_updates,
+                                      u16* updates, u32* updates_addr)
 {
   auto pb_mem = Common::BitCastToArray<u16>(pb);
 
@@ -397,7 +446,7 @@ bool AXWiiUCode::ExtractUpdatesFields(AXPBWii& pb, u16* num_updates, u16* update
   u16 addr_hi = pb_mem[44];
   u16 addr_lo = pb_mem[45];
   u32 addr = HILO_TO_32(addr);
-  u16* ptr = (u16*)HLEMemory_Get_Pointer(addr);
+  const u16* ptr = updates_data;
 
   *updates_addr = addr;
 
@@ -441,16 +490,51 @@ void AXWiiUCode::ReinjectUpdatesFields(AXPBWii& pb, u16* num_updates, u32 update
   Common::BitCastFromArray<u16>(pb_mem, pb);
 }
 
-void AXWiiUCode::ProcessPBList(u32 pb_addr)
+std::vector<AXUCode::PBListEntry> AXWiiUCode::CopyPBList(u32 pb_addr)
+{
+  std::vector<PBListEntry> pb_list;
+
+  while (pb_addr)
+  {
+    // See AXUCode::CopyPBList.
+    auto it = std::find_if(m_wii_pbs.begin(), m_wii_pbs.end(),
+                           [pb_addr](const auto& copy) { return copy.first == pb_addr; });
+    if (it == m_wii_pbs.end())
+    {
+      AXPBWii pb;
+      ReadPB(pb_addr, pb, m_crc);
+      it = m_wii_pbs.emplace(m_wii_pbs.end(), pb_addr, pb);
+    }
+    const AXPBWii& pb = it->second;
+
+    // Only the old AXWii has updates, see ExtractUpdatesFields for their layout.
+    size_t updates = 0;
+    if (m_old_axwii)
+    {
+      const auto pb_mem = Common::BitCastToArray<u16>(pb);
+      const u32 updates_count = pb_mem[41] + pb_mem[42] + pb_mem[43];
+      const u16 addr_hi = pb_mem[44];
+      const u16 addr_lo = pb_mem[45];
+      updates = CopyInput(HILO_TO_32(addr), updates_count * 2 * sizeof(u16));
+    }
+
+    pb_list.push_back({static_cast<size_t>(it - m_wii_pbs.begin()), updates});
+    pb_addr = HILO_TO_32(pb.next_pb);
+  }
+
+  return pb_list;
+}
+
+void AXWiiUCode::ProcessPBList(const std::vector<PBListEntry>& pb_list)
 {
   // Samples per millisecond. In theory DSP sampling rate can be changed from
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPBWii pb;
-
-  while (pb_addr)
+  for (const PBListEntry& entry : pb_list)
   {
+    AXPBWii& pb = m_wii_pbs[entry.pb_index].second;
+
     AXBuffers buffers = {{m_samples_left,      m_samples_right,      m_samples_surround,
                           m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
                           m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
@@ -459,12 +543,11 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
                           m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
                           m_samples_wm3,       m_samples_aux3}};
 
-    ReadPB(pb_addr, pb, m_crc);
-
     u16 num_updates[3];
     u16 updates[1024];
     u32 updates_addr;
-    if (ExtractUpdatesFields(pb, num_updates, updates, &updates_addr))
+    if (ExtractUpdatesFields(pb, GetInput<u16>(entry.updates_offset), num_updates, updates,
+                             &updates_addr))
     {
       for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
       {
@@ -483,13 +566,17 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
       ProcessVoice(pb, buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
                    m_coeffs_available ? m_coeffs : nullptr);
     }
+  }
+}
 
+void AXWiiUCode::WritePBs()
+{
+  for (const auto& [pb_addr, pb] : m_wii_pbs)
     WritePB(pb_addr, pb, m_crc);
-    pb_addr = HILO_TO_32(pb.next_pb);
-  }
+  m_wii_pbs.clear();
 }
 
-void AXWiiUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 volume)
+void AXWiiUCode::MixAUXSamples(int aux_id, u32 write_addr, const int* src, u16 volume)
 {
   std::array<u16, 96> volume_ramp;
   GenerateVolumeRamp(volume_ramp.data(), m_last_aux_volumes[aux_id], volume, volume_ramp.size());
@@ -532,16 +619,18 @@ void AXWiiUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 vo
   // Send the content of AUX buffers to the CPU
   if (write_addr)
   {
-    int* ptr = (int*)HLEMemory_Get_Pointer(write_addr);
+    std::array<int, 3 * 3 * 32> upload_buffer;
+    int* ptr = upload_buffer.data();
     for (const auto& buffer : buffers)
     {
       for (u32 j = 0; j < 3 * 32; ++j)
         *ptr++ = Common::swap32(buffer[j]);
     }
+    QueueOutput(write_addr, upload_buffer.data(), sizeof(upload_buffer));
   }
 
   // Then read the buffers from the CPU and add to our main buffers.
-  const int* ptr = (int*)HLEMemory_Get_Pointer(read_addr);
+  const int* ptr = src;
   for (auto& main_buffer : main_buffers)
   {
     for (u32 j = 0; j < 3 * 32; ++j)
@@ -553,24 +642,27 @@ void AXWiiUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 vo
   }
 }
 
-void AXWiiUCode::UploadAUXMixLRSC(int aux_id, u32* addresses, u16 volume)
+void AXWiiUCode::UploadAUXMixLRSC(int aux_id, const u32* addresses, const int* src, u16 volume)
 {
   int* aux_left = aux_id ? m_samples_auxB_left : m_samples_auxA_left;
   int* aux_right = aux_id ? m_samples_auxB_right : m_samples_auxA_right;
   int* aux_surround = aux_id ? m_samples_auxB_surround : m_samples_auxA_surround;
   int* auxc_buffer = aux_id ? m_samples_auxC_surround : m_samples_auxC_right;
 
-  int* upload_ptr = (int*)HLEMemory_Get_Pointer(addresses[0]);
+  int upload_buffer[3 * 96];
+  int* upload_ptr = upload_buffer;
   for (u32 i = 0; i < 96; ++i)
     *upload_ptr++ = Common::swap32(aux_left[i]);
   for (u32 i = 0; i < 96; ++i)
     *upload_ptr++ = Common::swap32(aux_right[i]);
   for (u32 i = 0; i < 96; ++i)
     *upload_ptr++ = Common::swap32(aux_surround[i]);
+  QueueOutput(addresses[0], upload_buffer, sizeof(upload_buffer));
 
-  upload_ptr = (int*)HLEMemory_Get_Pointer(addresses[1]);
+  upload_ptr = upload_buffer;
   for (u32 i = 0; i < 96; ++i)
     *upload_ptr++ = Common::swap32(auxc_buffer[i]);
+  QueueOutput(addresses[1], upload_buffer, 96 * sizeof(int));
 
   u16 volume_ramp[96];
   GenerateVolumeRamp(volume_ramp, m_last_aux_volumes[aux_id], volume, 96);
@@ -579,7 +671,8 @@ void AXWiiUCode::UploadAUXMixLRSC(int aux_id, u32* addresses, u16 volume)
   int* mix_dest[4] = {m_samples_left, m_samples_right, m_samples_surround, m_samples_auxC_left};
   for (u32 mix_i = 0; mix_i < 4; ++mix_i)
   {
-    int* dl_ptr = (int*)HLEMemory_Get_Pointer(addresses[2 + mix_i]);
+    // The four download buffers were copied one after the other.
+    const int* dl_ptr = src + 96 * mix_i;
     for (u32 i = 0; i < 96; ++i)
       aux_left[i] = Common::swap32(dl_ptr[i]);
 
@@ -602,14 +695,14 @@ void AXWiiUCode::OutputSamples(u32 lr_addr, u32 surround_addr, u16 volume, bool
 
   for (size_t i = 0; i < upload_buffer.size(); ++i)
     upload_buffer[i] = Common::swap32(m_samples_surround[i]);
-  memcpy(HLEMemory_Get_Pointer(surround_addr), upload_buffer.data(), sizeof(upload_buffer));
+  QueueOutput(surround_addr, upload_buffer.data(), sizeof(upload_buffer));
 
   if (upload_auxc)
   {
     surround_addr += sizeof(upload_buffer);
     for (size_t i = 0; i < upload_buffer.size(); ++i)
       upload_buffer[i] = Common::swap32(m_samples_auxC_left[i]);
-    memcpy(HLEMemory_Get_Pointer(surround_addr), upload_buffer.data(), sizeof(upload_buffer));
+    QueueOutput(surround_addr, upload_buffer.data(), sizeof(upload_buffer));
   }
 
   // Clamp internal buffers to 16 bits.
@@ -633,23 +726,23 @@ void AXWiiUCode::OutputSamples(u32 lr_addr, u32 surround_addr, u16 volume, bool
     buffer[2 * i + 1] = Common::swap16(m_samples_left[i]);
   }
 
-  memcpy(HLEMemory_Get_Pointer(lr_addr), buffer.data(), sizeof(buffer));
-  m_mail_handler.PushMail(DSP_SYNC, true);
+  QueueOutput(lr_addr, buffer.data(), sizeof(buffer));
 }
 
-void AXWiiUCode::OutputWMSamples(u32* addresses)
+void AXWiiUCode::OutputWMSamples(const u32* addresses)
 {
   int* buffers[] = {m_samples_wm0, m_samples_wm1, m_samples_wm2, m_samples_wm3};
 
   for (u32 i = 0; i < 4; ++i)
   {
     int* in = buffers[i];
-    u16* out = (u16*)HLEMemory_Get_Pointer(addresses[i]);
+    u16 out[3 * 6];
     for (u32 j = 0; j < 3 * 6; ++j)
     {
       int sample = std::clamp(in[j], -32767, 32767);
       out[j] = Common::swap16((u16)sample);
     }
+    QueueOutput(addresses[i], out, sizeof(out));
   }
 }
 
@@ -4,12 +4,15 @@
 
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Core/HW/DSPHLE/UCodes/AX.h"
+#include "Core/HW/DSPHLE/UCodes/AXStructs.h"
 
 namespace DSP::HLE
 {
-struct AXPBWii;
 class DSPHLE;
 
 class AXWiiUCode : public AXUCode
@@ -44,9 +47,13 @@ protected:
   u16 m_last_main_volume;
   u16 m_last_aux_volumes[3];
 
+  // Copies of the PBs used by the queued commands, see AXUCode::m_pbs.
+  std::vector<std::pair<u32, AXPBWii>> m_wii_pbs;
+
   // If needed, extract the updates related fields from a PB. We need to
   // reinject them afterwards so that the correct PB typs is written to RAM.
-  bool ExtractUpdatesFields(AXPBWii& pb, u16* num_updates, u16* updates, u32* updates_addr);
+  bool ExtractUpdatesFields(AXPBWii& pb, const u16* updates_data, u16* num_updates, u16* updates,
+                            u32* updates_addr);
   void ReinjectUpdatesFields(AXPBWii& pb, u16* num_updates, u32 updates_addr);
 
   // Convert a mixer_control bitfield to our internal representation for that
@@ -61,14 +68,16 @@ protected:
 
   void HandleCommandList() override;
 
-  void SetupProcessing(u32 init_addr);
-  void AddToLR(u32 val_addr, bool neg);
-  void AddSubToLR(u32 val_addr);
-  void ProcessPBList(u32 pb_addr);
-  void MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 volume);
-  void UploadAUXMixLRSC(int aux_id, u32* addresses, u16 volume);
+  void SetupProcessing(const u16* init_data);
+  void AddToLR(const int* src, bool neg);
+  void AddSubToLR(const int* src);
+  std::vector<PBListEntry> CopyPBList(u32 pb_addr);
+  void ProcessPBList(const std::vector<PBListEntry>& pb_list);
+  void WritePBs() override;
+  void MixAUXSamples(int aux_id, u32 write_addr, const int* src, u16 volume);
+  void UploadAUXMixLRSC(int aux_id, const u32* addresses, const int* src, u16 volume);
   void OutputSamples(u32 lr_addr, u32 surround_addr, u16 volume, bool upload_auxc);
-  void OutputWMSamples(u32* addresses);  // 4 addresses
+  void OutputWMSamples(const u32* addresses);  // 4 addresses
 
 private:
   enum CmdType
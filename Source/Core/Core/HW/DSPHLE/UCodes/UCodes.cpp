@@ -36,6 +36,15 @@ constexpr bool ExramRead(u32 address)
   return (address & 0x10000000) != 0;
 }
 
+// Writes through the RAM pointers bypass Memory's write tracking, so they report themselves.
+static void NotifyHLEMemoryWrite(u32 address, u32 size)
+{
+  if (ExramRead(address))
+    Memory::NotifyWrite(0x10000000 | (address & Memory::GetExRamMask()), size);
+  else
+    Memory::NotifyWrite(address & Memory::GetRamMask(), size);
+}
+
 u8 HLEMemory_Read_U8(u32 address)
 {
   if (ExramRead(address))
@@ -50,6 +59,7 @@ void HLEMemory_Write_U8(u32 address, u8 value)
     Memory::m_pEXRAM[address & Memory::GetExRamMask()] = value;
   else
     Memory::m_pRAM[address & Memory::GetRamMask()] = value;
+  NotifyHLEMemoryWrite(address, sizeof(u8));
 }
 
 u16 HLEMemory_Read_U16LE(u32 address)
@@ -75,6 +85,7 @@ void HLEMemory_Write_U16LE(u32 address, u16 value)
     std::memcpy(&Memory::m_pEXRAM[address & Memory::GetExRamMask()], &value, sizeof(u16));
   else
     std::memcpy(&Memory::m_pRAM[address & Memory::GetRamMask()], &value, sizeof(u16));
+  NotifyHLEMemoryWrite(address, sizeof(u16));
 }
 
 void HLEMemory_Write_U16(u32 address, u16 value)
@@ -105,6 +116,7 @@ void HLEMemory_Write_U32LE(u32 address, u32 value)
     std::memcpy(&Memory::m_pEXRAM[address & Memory::GetExRamMask()], &value, sizeof(u32));
   else
     std::memcpy(&Memory::m_pRAM[address & Memory::GetRamMask()], &value, sizeof(u32));
+  NotifyHLEMemoryWrite(address, sizeof(u32));
 }
 
 void HLEMemory_Write_U32(u32 address, u32 value)
@@ -120,6 +132,17 @@ void* HLEMemory_Get_Pointer(u32 address)
   return &Memory::m_pRAM[address & Memory::GetRamMask()];
 }
 
+void HLEMemory_Read_Block(void* dst, u32 address, u32 size)
+{
+  std::memcpy(dst, HLEMemory_Get_Pointer(address), size);
+}
+
+void HLEMemory_Write_Block(u32 address, const void* src, u32 size)
+{
+  std::memcpy(HLEMemory_Get_Pointer(address), src, size);
+  NotifyHLEMemoryWrite(address, size);
+}
+
 UCodeInterface::UCodeInterface(DSPHLE* dsphle, u32 crc)
     : m_mail_handler(dsphle->AccessMailHandler()), m_dsphle(dsphle), m_crc(crc)
 {
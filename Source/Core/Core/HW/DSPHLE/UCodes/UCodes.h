@@ -37,6 +37,9 @@ void HLEMemory_Write_U32(u32 address, u32 value);
 
 void* HLEMemory_Get_Pointer(u32 address);
 
+void HLEMemory_Read_Block(void* dst, u32 address, u32 size);
+void HLEMemory_Write_Block(u32 address, const void* src, u32 size);
+
 class UCodeInterface
 {
 public:
@@ -16,6 +16,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
 #include "Common/Thread.h"
+#include "Common/Trace.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/DSP/DSPAccelerator.h"
@@ -101,6 +102,7 @@ void DSPLLE::DSPThread(DSPLLE* dsp_lle)
       std::unique_lock dsp_thread_lock(dsp_lle->m_dsp_thread_mutex, std::try_to_lock);
       if (dsp_thread_lock)
       {
+        TRACE_SCOPE("DSPLLE::RunCycles");
         if (g_dsp_jit)
         {
           DSPCore_RunCycles(cycles);
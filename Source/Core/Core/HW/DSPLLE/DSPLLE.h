@@ -27,6 +27,7 @@ public:
   bool IsLLE() const override { return true; }
   void DoState(PointerWrap& p) override;
   void PauseAndLock(bool do_lock, bool unpause_on_unlock = true) override;
+  void FinishAsyncWork() override {}
 
   void DSP_WriteMailBoxHigh(bool cpu_mailbox, u16 value) override;
   void DSP_WriteMailBoxLow(bool cpu_mailbox, u16 value) override;
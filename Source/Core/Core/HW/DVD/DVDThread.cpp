@@ -22,6 +22,7 @@
 #include "Common/SPSCQueue.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/Trace.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -382,6 +383,7 @@ static void DVDThread()
     ReadRequest request;
     while (s_request_queue.Pop(request))
     {
+      TRACE_SCOPE("DVDThread::Read");
       FileMonitor::Log(*s_disc, request.partition, request.dvd_offset);
 
       std::vector<u8> buffer(request.length);
@@ -533,6 +533,7 @@ IEXIDevice* CEXIMemoryCard::FindDevice(TEXIDevices device_type, int customIndex)
 void CEXIMemoryCard::DMARead(u32 _uAddr, u32 _uSize)
 {
   memorycard->Read(address, _uSize, Memory::GetPointer(_uAddr));
+  Memory::NotifyWrite(_uAddr, _uSize);
 
   if ((address + _uSize) % Memcard::BLOCK_SIZE == 0)
   {
@@ -4,6 +4,7 @@
 
 #include "Core/HW/GPFifo.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 
@@ -70,31 +71,43 @@ void ResetGatherPipe()
 void UpdateGatherPipe()
 {
   size_t pipe_count = GetGatherPipeCount();
-  size_t processed;
-  u8* cur_mem = Memory::GetPointer(ProcessorInterface::Fifo_CPUWritePointer);
-  for (processed = 0; pipe_count >= GATHER_PIPE_SIZE; processed += GATHER_PIPE_SIZE)
+  size_t processed = 0;
+  while (pipe_count >= GATHER_PIPE_SIZE)
   {
-    // copy the GatherPipe
-    memcpy(cur_mem, s_gather_pipe + processed, GATHER_PIPE_SIZE);
-    pipe_count -= GATHER_PIPE_SIZE;
-
-    // increase the CPUWritePointer
-    if (ProcessorInterface::Fifo_CPUWritePointer == ProcessorInterface::Fifo_CPUEnd)
+    const u32 write_pointer = ProcessorInterface::Fifo_CPUWritePointer;
+    const u32 end = ProcessorInterface::Fifo_CPUEnd;
+    u8* const dest = Memory::GetPointer(write_pointer);
+    u32 size = GATHER_PIPE_SIZE;
+    if (pipe_count < GATHER_PIPE_SIZE * 2 || write_pointer == end)
     {
-      ProcessorInterface::Fifo_CPUWritePointer = ProcessorInterface::Fifo_CPUBase;
-      cur_mem = Memory::GetPointer(ProcessorInterface::Fifo_CPUWritePointer);
+      // Most flushes are a single burst, which doesn't need the span calculation below.
+      memcpy(dest, s_gather_pipe + processed, GATHER_PIPE_SIZE);
     }
     else
     {
-      cur_mem += GATHER_PIPE_SIZE;
-      ProcessorInterface::Fifo_CPUWritePointer += GATHER_PIPE_SIZE;
+      // Copy as many bursts as fit before the FIFO wraps around in one go. The burst at
+      // Fifo_CPUEnd is still written, the one after it goes to Fifo_CPUBase.
+      size_t bursts = pipe_count / GATHER_PIPE_SIZE;
+      if (write_pointer < end)
+        bursts = std::min<size_t>(bursts, (end - write_pointer) / GATHER_PIPE_SIZE + 1);
+      size = static_cast<u32>(bursts * GATHER_PIPE_SIZE);
+      memcpy(dest, s_gather_pipe + processed, size);
     }
+    processed += size;
+    pipe_count -= size;
+
+    // increase the CPUWritePointer
+    if (write_pointer + size - GATHER_PIPE_SIZE == end)
+      ProcessorInterface::Fifo_CPUWritePointer = ProcessorInterface::Fifo_CPUBase;
+    else
+      ProcessorInterface::Fifo_CPUWritePointer += size;
 
-    CommandProcessor::GatherPipeBursted();
+    CommandProcessor::GatherPipeBursted(size);
   }
 
   // move back the spill bytes
-  memmove(s_gather_pipe, s_gather_pipe + processed, pipe_count);
+  if (pipe_count != 0)
+    memmove(s_gather_pipe, s_gather_pipe + processed, pipe_count);
   SetGatherPipeCount(pipe_count);
 }
 
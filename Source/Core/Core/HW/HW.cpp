@@ -10,6 +10,7 @@
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
+#include "Core/DSPEmulator.h"
 #include "Core/HW/AddressSpace.h"
 #include "Core/HW/AudioInterface.h"
 #include "Core/HW/CPU.h"
@@ -81,6 +82,9 @@ void Shutdown()
 
 void DoState(PointerWrap& p)
 {
+  // Results of DSP work that is still in flight belong in the saved memory.
+  DSP::GetDSPEmulator()->FinishAsyncWork();
+
   Memory::DoState(p);
   p.DoMarker("Memory");
   VideoInterface::DoState(p);
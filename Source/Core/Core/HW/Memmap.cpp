@@ -11,14 +11,25 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
+#include <map>
 #include <memory>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/Swap.h"
+#include "Core/Config/GraphicsSettings.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/AudioInterface.h"
@@ -180,6 +191,8 @@ struct LogicalMemoryView
 {
   void* mapped_pointer;
   u32 mapped_size;
+  u32 physical_address;
+  bool writable;
 };
 
 // Dolphin allocates memory to represent four regions:
@@ -226,6 +239,19 @@ static std::array<PhysicalMemoryRegion, 4> physical_regions;
 
 static std::vector<LogicalMemoryView> logical_mapped_entries;
 
+// Single pages mapped through the page table (see MapLogicalPage), by logical address.
+static std::map<u32, LogicalMemoryView> logical_mapped_pages;
+
+// Write tracking (see WatchForWrites). There is one entry per hardware page of MEM1, followed by
+// MEM2. s_watch_lock protects changes to which pages are watched and to the logical mappings, so
+// that protection is applied to every view of a page.
+static bool s_track_writes = false;
+static u32 s_watch_page_count = 0;
+static std::unique_ptr<std::atomic<bool>[]> s_page_watched;
+static std::unique_ptr<std::atomic<u64>[]> s_page_write_stamps;
+static std::atomic<u64> s_write_stamp{1};
+static std::mutex s_watch_lock;
+
 static u32 GetFlags()
 {
   bool wii = SConfig::GetInstance().bWii;
@@ -247,6 +273,121 @@ static u32 GetFlags()
   return flags;
 }
 
+static u32 GetHostPageSize()
+{
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwPageSize;
+#else
+  return static_cast<u32>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+// Returns s_watch_page_count for physical addresses outside of MEM1 and MEM2.
+static u32 GetWatchPageIndex(u32 physical_address)
+{
+  if (physical_address < GetRamSize())
+    return physical_address / PowerPC::HW_PAGE_SIZE;
+
+  const u32 ram_pages = GetRamSize() / PowerPC::HW_PAGE_SIZE;
+  if ((physical_address >> 28) == 0x1 && (physical_address & 0x0FFFFFFF) < GetExRamSize() &&
+      ram_pages + (physical_address & 0x0FFFFFFF) / PowerPC::HW_PAGE_SIZE < s_watch_page_count)
+  {
+    return ram_pages + (physical_address & 0x0FFFFFFF) / PowerPC::HW_PAGE_SIZE;
+  }
+
+  return s_watch_page_count;
+}
+
+static u32 GetWatchPagePhysicalAddress(u32 index)
+{
+  const u32 offset = index * PowerPC::HW_PAGE_SIZE;
+  if (offset < GetRamSize())
+    return offset;
+  return 0x10000000 + offset - GetRamSize();
+}
+
+// Calls func for every writable view of a physical range in the fastmem arena.
+template <typename Func>
+static void ForEachWritableView(u32 physical_address, u32 size, Func func)
+{
+  if (!is_fastmem_arena_initialized)
+    return;
+
+  func(physical_base + physical_address, size);
+
+  const auto visit = [&](const LogicalMemoryView& view) {
+    if (!view.writable)
+      return;
+    const u32 start = std::max(physical_address, view.physical_address);
+    const u32 end = std::min(physical_address + size, view.physical_address + view.mapped_size);
+    if (start < end)
+      func(static_cast<u8*>(view.mapped_pointer) + (start - view.physical_address), end - start);
+  };
+  for (const LogicalMemoryView& view : logical_mapped_entries)
+    visit(view);
+  for (const auto& entry : logical_mapped_pages)
+    visit(entry.second);
+}
+
+// s_watch_lock must be held.
+static void UnwatchPage(u32 index)
+{
+  if (!s_page_watched[index].load(std::memory_order_relaxed))
+    return;
+
+  s_page_write_stamps[index].store(s_write_stamp.fetch_add(1) + 1, std::memory_order_release);
+  s_page_watched[index].store(false, std::memory_order_relaxed);
+  ForEachWritableView(GetWatchPagePhysicalAddress(index), PowerPC::HW_PAGE_SIZE,
+                      [](u8* pointer, u32 size) { Common::UnWriteProtectMemory(pointer, size); });
+}
+
+static void UnwatchAllPages()
+{
+  if (!s_track_writes)
+    return;
+
+  std::lock_guard lk(s_watch_lock);
+  for (u32 i = 0; i < s_watch_page_count; ++i)
+    UnwatchPage(i);
+}
+
+// Applies the write protection of watched pages to a view that was just mapped.
+// s_watch_lock must be held.
+static void ProtectWatchedPages(const LogicalMemoryView& view)
+{
+  if (!s_track_writes || !view.writable)
+    return;
+
+  for (u32 offset = 0; offset < view.mapped_size; offset += PowerPC::HW_PAGE_SIZE)
+  {
+    const u32 index = GetWatchPageIndex(view.physical_address + offset);
+    if (index < s_watch_page_count && s_page_watched[index].load(std::memory_order_relaxed))
+    {
+      Common::WriteProtectMemory(static_cast<u8*>(view.mapped_pointer) + offset,
+                                 PowerPC::HW_PAGE_SIZE);
+    }
+  }
+}
+
+static void UnmapLogicalPageInternal(u32 logical_address)
+{
+  auto it = logical_mapped_pages.find(logical_address);
+  if (it == logical_mapped_pages.end())
+    return;
+
+  g_arena.ReleaseView(it->second.mapped_pointer, it->second.mapped_size);
+  logical_mapped_pages.erase(it);
+}
+
+static void UnmapLogicalPagesInternal()
+{
+  for (auto& entry : logical_mapped_pages)
+    g_arena.ReleaseView(entry.second.mapped_pointer, entry.second.mapped_size);
+  logical_mapped_pages.clear();
+}
+
 void Init()
 {
   const auto get_mem1_size = [] {
@@ -309,6 +450,16 @@ void Init()
   else
     mmio_mapping = InitMMIO();
 
+  // Protection works on host pages, so it can only be used if they match the hardware pages.
+  s_track_writes = Config::Get(Config::GFX_HACK_TRACK_TEXTURE_WRITES) &&
+                   GetHostPageSize() == PowerPC::HW_PAGE_SIZE;
+  if (s_track_writes)
+  {
+    s_watch_page_count = (GetRamSize() + (wii ? GetExRamSize() : 0)) / PowerPC::HW_PAGE_SIZE;
+    s_page_watched = std::make_unique<std::atomic<bool>[]>(s_watch_page_count);
+    s_page_write_stamps = std::make_unique<std::atomic<u64>[]>(s_watch_page_count);
+  }
+
   Clear();
 
   INFO_LOG(MEMMAP, "Memory system initialized. RAM at %p", m_pRAM);
@@ -350,6 +501,12 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
   if (!is_fastmem_arena_initialized)
     return;
 
+  std::lock_guard lk(s_watch_lock);
+
+  // BAT mappings take priority over the page table, so drop the single pages first instead of
+  // releasing a view that has been mapped over later.
+  UnmapLogicalPagesInternal();
+
   for (auto& entry : logical_mapped_entries)
   {
     g_arena.ReleaseView(entry.mapped_pointer, entry.mapped_size);
@@ -382,15 +539,74 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
             PanicAlert("MemoryMap_Setup: Failed finding a memory base.");
             exit(0);
           }
-          logical_mapped_entries.push_back({mapped_pointer, mapped_size});
+          logical_mapped_entries.push_back(
+              {mapped_pointer, mapped_size, intersection_start, true});
+          ProtectWatchedPages(logical_mapped_entries.back());
         }
       }
     }
   }
 }
 
+bool MapLogicalPage(u32 logical_address, u32 physical_address, bool writable)
+{
+  if (!is_fastmem_arena_initialized)
+    return false;
+
+  std::lock_guard lk(s_watch_lock);
+
+  const u32 flags = GetFlags();
+  for (const PhysicalMemoryRegion& region : physical_regions)
+  {
+    if ((flags & region.flags) != region.flags)
+      continue;
+    if (physical_address < region.physical_address ||
+        physical_address - region.physical_address >= region.size)
+    {
+      continue;
+    }
+
+    UnmapLogicalPageInternal(logical_address);
+
+    u32 position = region.shm_position + physical_address - region.physical_address;
+    u8* base = logical_base + logical_address;
+    void* mapped_pointer = g_arena.CreateView(position, PowerPC::HW_PAGE_SIZE, base);
+    if (mapped_pointer != base)
+    {
+      if (mapped_pointer)
+        g_arena.ReleaseView(mapped_pointer, PowerPC::HW_PAGE_SIZE);
+      return false;
+    }
+
+    if (!writable)
+      Common::WriteProtectMemory(mapped_pointer, PowerPC::HW_PAGE_SIZE);
+
+    const LogicalMemoryView view{mapped_pointer, PowerPC::HW_PAGE_SIZE, physical_address, writable};
+    logical_mapped_pages[logical_address] = view;
+    ProtectWatchedPages(view);
+    return true;
+  }
+
+  return false;
+}
+
+void UnmapLogicalPage(u32 logical_address)
+{
+  std::lock_guard lk(s_watch_lock);
+  UnmapLogicalPageInternal(logical_address);
+}
+
+void UnmapLogicalPages()
+{
+  std::lock_guard lk(s_watch_lock);
+  UnmapLogicalPagesInternal();
+}
+
 void DoState(PointerWrap& p)
 {
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    UnwatchAllPages();
+
   bool wii = SConfig::GetInstance().bWii;
   p.DoArray(m_pRAM, GetRamSize());
   p.DoArray(m_pL1Cache, GetL1CacheSize());
@@ -418,6 +634,11 @@ void Shutdown()
   }
   g_arena.ReleaseSHMSegment();
   mmio_mapping.reset();
+
+  s_track_writes = false;
+  s_watch_page_count = 0;
+  s_page_watched.reset();
+  s_page_write_stamps.reset();
   INFO_LOG(MEMMAP, "Memory system shut down.");
 }
 
@@ -426,6 +647,9 @@ void ShutdownFastmemArena()
   if (!is_fastmem_arena_initialized)
     return;
 
+  UnwatchAllPages();
+  std::lock_guard lk(s_watch_lock);
+
   u32 flags = GetFlags();
   for (PhysicalMemoryRegion& region : physical_regions)
   {
@@ -436,6 +660,8 @@ void ShutdownFastmemArena()
     g_arena.ReleaseView(base, region.size);
   }
 
+  UnmapLogicalPagesInternal();
+
   for (auto& entry : logical_mapped_entries)
   {
     g_arena.ReleaseView(entry.mapped_pointer, entry.mapped_size);
@@ -458,6 +684,7 @@ void Clear()
     memset(m_pFakeVMEM, 0, GetFakeVMemSize());
   if (m_pEXRAM)
     memset(m_pEXRAM, 0, GetExRamSize());
+  UnwatchAllPages();
 }
 
 static inline u8* GetPointerForRange(u32 address, size_t size)
@@ -500,6 +727,7 @@ void CopyToEmu(u32 address, const void* data, size_t size)
     return;
   }
   memcpy(pointer, data, size);
+  NotifyWrite(address, static_cast<u32>(size));
 }
 
 void Memset(u32 address, u8 value, size_t size)
@@ -514,6 +742,7 @@ void Memset(u32 address, u8 value, size_t size)
     return;
   }
   memset(pointer, value, size);
+  NotifyWrite(address, static_cast<u32>(size));
 }
 
 std::string GetString(u32 em_address, size_t size)
@@ -575,34 +804,176 @@ u64 Read_U64(u32 address)
 void Write_U8(u8 value, u32 address)
 {
   *GetPointer(address) = value;
+  NotifyWrite(address, sizeof(u8));
 }
 
 void Write_U16(u16 value, u32 address)
 {
   u16 swapped_value = Common::swap16(value);
   std::memcpy(GetPointer(address), &swapped_value, sizeof(u16));
+  NotifyWrite(address, sizeof(u16));
 }
 
 void Write_U32(u32 value, u32 address)
 {
   u32 swapped_value = Common::swap32(value);
   std::memcpy(GetPointer(address), &swapped_value, sizeof(u32));
+  NotifyWrite(address, sizeof(u32));
 }
 
 void Write_U64(u64 value, u32 address)
 {
   u64 swapped_value = Common::swap64(value);
   std::memcpy(GetPointer(address), &swapped_value, sizeof(u64));
+  NotifyWrite(address, sizeof(u64));
 }
 
 void Write_U32_Swap(u32 value, u32 address)
 {
   std::memcpy(GetPointer(address), &value, sizeof(u32));
+  NotifyWrite(address, sizeof(u32));
 }
 
 void Write_U64_Swap(u64 value, u32 address)
 {
   std::memcpy(GetPointer(address), &value, sizeof(u64));
+  NotifyWrite(address, sizeof(u64));
+}
+
+// Converts a range given like for GetPointer into page indices. Returns false if the range
+// isn't entirely in MEM1 or MEM2.
+static bool GetWatchPageRange(u32 address, u32 size, u32* first, u32* last)
+{
+  if (!s_track_writes || size == 0)
+    return false;
+
+  address &= 0x3FFFFFFF;
+  *first = GetWatchPageIndex(address);
+  *last = GetWatchPageIndex(address + size - 1);
+  return *first < s_watch_page_count && *last < s_watch_page_count && *first <= *last &&
+         (address >> 28) == ((address + size - 1) >> 28);
 }
 
+u64 WatchForWrites(u32 address, u32 size)
+{
+  u32 first, last;
+  if (!GetWatchPageRange(address, size, &first, &last))
+    return 0;
+
+  {
+    std::lock_guard lk(s_watch_lock);
+
+    u32 index = first;
+    while (index <= last)
+    {
+      if (s_page_watched[index].load(std::memory_order_relaxed))
+      {
+        ++index;
+        continue;
+      }
+
+      // Protect runs of pages at once, as a texture usually spans many of them.
+      const u32 run_start = index;
+      for (; index <= last && !s_page_watched[index].load(std::memory_order_relaxed); ++index)
+        s_page_watched[index].store(true, std::memory_order_relaxed);
+
+      ForEachWritableView(GetWatchPagePhysicalAddress(run_start),
+                          (index - run_start) * PowerPC::HW_PAGE_SIZE,
+                          [](u8* pointer, u32 view_size) {
+                            Common::WriteProtectMemory(pointer, view_size);
+                          });
+    }
+  }
+
+  // Pairs with the fence in NotifyWrite: either the writer sees that the page is watched, or
+  // its write is visible to whatever the caller reads after this.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return s_write_stamp.load();
+}
+
+bool HasBeenWrittenSince(u32 address, u32 size, u64 stamp)
+{
+  u32 first, last;
+  if (stamp == 0 || !GetWatchPageRange(address, size, &first, &last))
+    return true;
+
+  for (u32 index = first; index <= last; ++index)
+  {
+    if (s_page_write_stamps[index].load(std::memory_order_acquire) > stamp)
+      return true;
+  }
+  return false;
+}
+
+void NotifyWrite(u32 address, u32 size)
+{
+  if (!s_track_writes)
+    return;
+
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  u32 first, last;
+  if (!GetWatchPageRange(address, size, &first, &last))
+    return;
+
+  for (u32 index = first; index <= last; ++index)
+  {
+    if (s_page_watched[index].load(std::memory_order_relaxed))
+    {
+      std::lock_guard lk(s_watch_lock);
+      UnwatchPage(index);
+    }
+  }
+}
+
+bool HandleWriteWatchFault(uintptr_t fault_address)
+{
+  if (!s_track_writes || !is_fastmem_arena_initialized)
+    return false;
+
+  std::lock_guard lk(s_watch_lock);
+
+  u32 physical_address;
+  const uintptr_t physical_base_ptr = reinterpret_cast<uintptr_t>(physical_base);
+  const uintptr_t logical_base_ptr = reinterpret_cast<uintptr_t>(logical_base);
+  if (fault_address - physical_base_ptr < 0x100000000)
+  {
+    physical_address = static_cast<u32>(fault_address - physical_base_ptr);
+  }
+  else if (logical_base && fault_address - logical_base_ptr < 0x100000000)
+  {
+    const u32 logical_address = static_cast<u32>(fault_address - logical_base_ptr);
+    const auto page = logical_mapped_pages.find(logical_address & ~(PowerPC::HW_PAGE_SIZE - 1));
+    if (page != logical_mapped_pages.end())
+    {
+      physical_address =
+          page->second.physical_address + (logical_address & (PowerPC::HW_PAGE_SIZE - 1));
+    }
+    else
+    {
+      const auto view = std::find_if(
+          logical_mapped_entries.begin(), logical_mapped_entries.end(),
+          [fault_address](const LogicalMemoryView& entry) {
+            const uintptr_t start = reinterpret_cast<uintptr_t>(entry.mapped_pointer);
+            return fault_address - start < entry.mapped_size;
+          });
+      if (view == logical_mapped_entries.end())
+        return false;
+      physical_address = view->physical_address +
+                         static_cast<u32>(fault_address -
+                                          reinterpret_cast<uintptr_t>(view->mapped_pointer));
+    }
+  }
+  else
+  {
+    return false;
+  }
+
+  const u32 index = GetWatchPageIndex(physical_address);
+  if (index >= s_watch_page_count || !s_page_watched[index].load(std::memory_order_relaxed))
+    return false;
+
+  UnwatchPage(index);
+  return true;
+}
 }  // namespace Memory
@@ -69,6 +69,25 @@ void DoState(PointerWrap& p);
 
 void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
+// Maps a single page that is translated through the page table into the logical memory
+// arena. Returns false if the page isn't backed by memory or the host can't map pages this
+// small. Write protected pages still fault on stores.
+bool MapLogicalPage(u32 logical_address, u32 physical_address, bool writable);
+void UnmapLogicalPage(u32 logical_address);
+void UnmapLogicalPages();
+
+// Write tracking for the texture cache, enabled by GFX_HACK_TRACK_TEXTURE_WRITES.
+// Watched pages of RAM are write protected in the fastmem arena, so the first store to one
+// faults and marks the page as written. Writes that don't go through the arena have to be
+// reported with NotifyWrite; the MMU and the copy/write functions below do that, and so must
+// everything that writes through a raw pointer from GetPointer.
+//
+// Returns a stamp to pass to HasBeenWrittenSince, or 0 if the range can't be watched.
+u64 WatchForWrites(u32 address, u32 size);
+bool HasBeenWrittenSince(u32 address, u32 size, u64 stamp);
+void NotifyWrite(u32 address, u32 size);
+bool HandleWriteWatchFault(uintptr_t fault_address);
+
 void Clear();
 
 // Routines to access physically addressed memory, designed for use by
@@ -112,5 +131,7 @@ void CopyToEmuSwapped(u32 address, const T* data, size_t size)
 
   for (size_t i = 0; i < size / sizeof(T); i++)
     dest[i] = Common::FromBigEndian(data[i]);
+
+  NotifyWrite(address, static_cast<u32>(size));
 }
 }  // namespace Memory
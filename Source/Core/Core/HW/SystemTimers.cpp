@@ -55,6 +55,7 @@ IPC_HLE_PERIOD: For the Wii Remote this is the call schedule:
 #include "Common/Logging/Log.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/Trace.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -199,6 +200,7 @@ void ThrottleCallback(u64 last_time, s64 cyclesLate)
     }
     else if (diff > 1000)
     {
+      TRACE_SCOPE("Throttle");
       Common::SleepCurrentThread(diff / 1000);
       s_time_spent_sleeping += Common::Timer::GetTimeUs() - time;
     }
@@ -109,7 +109,10 @@ IPCCommandResult ES::ReadContent(u32 uid, const IOCtlVRequest& request)
   const u32 size = request.io_vectors[0].size;
   const u32 addr = request.io_vectors[0].address;
 
-  return GetDefaultReply(ReadContent(cfd, Memory::GetPointer(addr), size, uid));
+  const s32 result = ReadContent(cfd, Memory::GetPointer(addr), size, uid);
+  if (result > 0)
+    Memory::NotifyWrite(addr, result);
+  return GetDefaultReply(result);
 }
 
 ReturnCode ES::CloseContent(u32 cfd, u32 uid)
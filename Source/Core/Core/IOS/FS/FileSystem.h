@@ -189,6 +189,9 @@ public:
 
   virtual void DoState(PointerWrap& p) = 0;
 
+  /// Write any metadata changes that have not been persisted yet to the backing storage.
+  virtual void Flush() = 0;
+
   /// Format the file system.
   virtual ResultCode Format(Uid uid) = 0;
 
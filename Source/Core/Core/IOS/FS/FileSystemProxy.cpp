@@ -36,6 +36,10 @@ constexpr u64 CLUSTER_WRITE_TICKS = 300000;
 constexpr u64 CLUSTER_READ_TICKS = 115000;
 constexpr size_t CLUSTER_DATA_SIZE = 0x4000;
 
+/// Number of device updates (which happen several times per frame) without any ioctl
+/// after which pending metadata changes are written to the host filesystem.
+constexpr u32 IDLE_UPDATES_BEFORE_FLUSH = 60;
+
 FS::FS(Kernel& ios, const std::string& device_name) : Device(ios, device_name)
 {
   if (ios.GetFS()->Delete(PID_KERNEL, PID_KERNEL, "/tmp") == ResultCode::Success)
@@ -53,6 +57,15 @@ void FS::DoState(PointerWrap& p)
   p.Do(m_dirty_cache);
 }
 
+void FS::Update()
+{
+  if (m_idle_update_count >= IDLE_UPDATES_BEFORE_FLUSH)
+    return;
+
+  if (++m_idle_update_count == IDLE_UPDATES_BEFORE_FLUSH)
+    m_ios.GetFS()->Flush();
+}
+
 template <typename... Args>
 static void LogResult(ResultCode code, std::string_view format, Args&&... args)
 {
@@ -243,6 +256,8 @@ IPCCommandResult FS::Read(const ReadWriteRequest& request)
   if (!result)
     return GetFSReply(ConvertResult(result.Error()));
 
+  Memory::NotifyWrite(request.buffer, *result);
+
   return GetFSReply(*result, ticks);
 }
 
@@ -323,6 +338,7 @@ IPCCommandResult FS::IOCtl(const IOCtlRequest& request)
   if (it == m_fd_map.end())
     return GetDefaultReply(ConvertResult(ResultCode::Invalid));
 
+  m_idle_update_count = 0;
   switch (request.request)
   {
   case ISFS_IOCTL_FORMAT:
@@ -358,6 +374,7 @@ IPCCommandResult FS::IOCtlV(const IOCtlVRequest& request)
   if (it == m_fd_map.end())
     return GetDefaultReply(ConvertResult(ResultCode::Invalid));
 
+  m_idle_update_count = 0;
   switch (request.request)
   {
   case ISFS_IOCTLV_READDIR:
@@ -587,6 +604,7 @@ IPCCommandResult FS::GetUsage(const Handle& handle, const IOCtlVRequest& request
 IPCCommandResult FS::Shutdown(const Handle& handle, const IOCtlRequest& request)
 {
   INFO_LOG(IOS_FS, "Shutdown");
+  m_ios.GetFS()->Flush();
   return GetFSReply(IPC_SUCCESS);
 }
 }  // namespace IOS::HLE::Device
@@ -25,6 +25,7 @@ public:
   FS(Kernel& ios, const std::string& device_name);
 
   void DoState(PointerWrap& p) override;
+  void Update() override;
 
   IPCCommandResult Open(const OpenRequest& request) override;
   IPCCommandResult Close(u32 fd) override;
@@ -85,5 +86,7 @@ private:
   u32 m_cache_fd = INVALID_FD;
   u16 m_cache_chain_index = 0;
   bool m_dirty_cache = false;
+  /// Host-side only (not savestated): used to flush metadata to disk once FS is idle.
+  u32 m_idle_update_count = 0;
 };
 }  // namespace IOS::HLE::Device
@@ -109,7 +109,10 @@ HostFileSystem::HostFileSystem(const std::string& root_path) : m_root_path{root_
   LoadFst();
 }
 
-HostFileSystem::~HostFileSystem() = default;
+HostFileSystem::~HostFileSystem()
+{
+  Flush();
+}
 
 std::string HostFileSystem::GetFstFilePath() const
 {
@@ -190,6 +193,39 @@ void HostFileSystem::SaveFst()
     PanicAlert("IOS_FS: Failed to rename temporary FST file");
 }
 
+void HostFileSystem::MarkFstDirty()
+{
+  m_fst_dirty = true;
+}
+
+void HostFileSystem::Flush()
+{
+  // Flush is called once the FS has been idle for a while. Dropping the cached stats here picks up
+  // changes made to the NAND on the host since they were computed.
+  m_directory_stats_cache.clear();
+
+  if (!m_fst_dirty)
+    return;
+
+  m_fst_dirty = false;
+  SaveFst();
+}
+
+void HostFileSystem::InvalidateDirectoryStats(const std::string& path)
+{
+  for (auto it = m_directory_stats_cache.begin(); it != m_directory_stats_cache.end();)
+  {
+    const std::string& cached_path = it->first;
+    const bool is_parent_or_self =
+        cached_path == "/" || cached_path == path || StringBeginsWith(path, cached_path + '/');
+    const bool is_child = StringBeginsWith(cached_path, path + '/');
+    if (is_parent_or_self || is_child)
+      it = m_directory_stats_cache.erase(it);
+    else
+      ++it;
+  }
+}
+
 HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string& path)
 {
   if (path == "/")
@@ -237,6 +273,9 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
 
 void HostFileSystem::DoState(PointerWrap& p)
 {
+  // Make sure that the FST on disk matches the files that are being saved or loaded.
+  Flush();
+
   // Temporarily close the file, to prevent any issues with the savestating of /tmp
   for (Handle& handle : m_handles)
     handle.host_file.reset();
@@ -245,6 +284,7 @@ void HostFileSystem::DoState(PointerWrap& p)
   std::string Path = BuildFilename("/tmp");
   if (p.GetMode() == PointerWrap::MODE_READ)
   {
+    InvalidateDirectoryStats("/tmp");
     File::DeleteDirRecursively(Path);
     File::CreateDir(Path);
 
@@ -351,6 +391,8 @@ ResultCode HostFileSystem::Format(Uid uid)
   if (!File::DeleteDirRecursively(root) || !File::CreateDir(root))
     return ResultCode::UnknownError;
   ResetFst();
+  m_directory_stats_cache.clear();
+  m_fst_dirty = false;
   SaveFst();
   // Reset and close all handles.
   m_handles = {};
@@ -394,7 +436,8 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
   child->data.uid = uid;
   child->data.gid = gid;
   child->data.attribute = attr;
-  SaveFst();
+  MarkFstDirty();
+  InvalidateDirectoryStats(path);
   return ResultCode::Success;
 }
 
@@ -453,7 +496,8 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
                                GetNamePredicate(split_path.file_name));
   if (it != parent->children.end())
     parent->children.erase(it);
-  SaveFst();
+  MarkFstDirty();
+  InvalidateDirectoryStats(path);
 
   return ResultCode::Success;
 }
@@ -524,7 +568,9 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
     old_parent->children.erase(it);
   }
   new_entry->name = split_new_path.file_name;
-  SaveFst();
+  MarkFstDirty();
+  InvalidateDirectoryStats(old_path);
+  InvalidateDirectoryStats(new_path);
 
   return ResultCode::Success;
 }
@@ -640,7 +686,7 @@ ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path,
   entry->data.uid = uid;
   entry->data.attribute = attr;
   entry->data.modes = modes;
-  SaveFst();
+  MarkFstDirty();
 
   return ResultCode::Success;
 }
@@ -667,6 +713,10 @@ Result<DirectoryStats> HostFileSystem::GetDirectoryStats(const std::string& wii_
   if (!IsValidPath(wii_path))
     return ResultCode::Invalid;
 
+  const auto cached = m_directory_stats_cache.find(wii_path);
+  if (cached != m_directory_stats_cache.end())
+    return cached->second;
+
   DirectoryStats stats{};
   std::string path(BuildFilename(wii_path));
   if (File::IsDirectory(path))
@@ -678,6 +728,7 @@ Result<DirectoryStats> HostFileSystem::GetDirectoryStats(const std::string& wii_
     u64 total_size = ComputeTotalFileSize(parent_dir);  // "Real" size to convert to nand blocks
 
     stats.used_clusters = (u32)(total_size / (16 * 1024));  // one block is 16kb
+    m_directory_stats_cache.emplace(wii_path, stats);
   }
   else
   {
@@ -28,6 +28,8 @@ public:
 
   void DoState(PointerWrap& p) override;
 
+  void Flush() override;
+
   ResultCode Format(Uid uid) override;
 
   Result<FileHandle> OpenFile(Uid uid, Gid gid, const std::string& path, Mode mode) override;
@@ -96,6 +98,12 @@ private:
   void ResetFst();
   void LoadFst();
   void SaveFst();
+  /// Mark the FST as modified. Writing the FST to disk is deferred until Flush() is called,
+  /// so that sequences of many small metadata changes only result in a single write.
+  void MarkFstDirty();
+  /// Drop cached directory stats for every directory that contains the given path,
+  /// as well as for the path itself and any of its subdirectories.
+  void InvalidateDirectoryStats(const std::string& path);
   /// Get the FST entry for a file (or directory).
   /// Automatically creates fallback entries for parents if they do not exist.
   /// Returns nullptr if the path is invalid or the file does not exist.
@@ -110,6 +118,11 @@ private:
   /// and we do not want FS to break if the user adds or removes files in their
   /// filesystem root manually.
   FstEntry m_root_entry{};
+  bool m_fst_dirty = false;
+  /// Cached results of GetDirectoryStats, keyed by Wii path. Computing them requires walking
+  /// the host directory tree, so they are only recomputed after something inside changed.
+  /// The cache only lives until the next Flush(), as it can't see changes made on the host.
+  std::map<std::string, DirectoryStats> m_directory_stats_cache;
   std::string m_root_path;
   std::map<std::string, std::weak_ptr<File::IOFile>> m_open_files;
   std::array<Handle, 16> m_handles{};
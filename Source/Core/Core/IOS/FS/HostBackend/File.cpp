@@ -155,6 +155,7 @@ Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
     return ResultCode::AccessDenied;
 
   handle->file_offset += count;
+  InvalidateDirectoryStats(handle->wii_path);
   return count;
 }
 
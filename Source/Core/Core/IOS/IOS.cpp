@@ -19,6 +19,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Timer.h"
+#include "Common/Trace.h"
 #include "Core/Boot/DolReader.h"
 #include "Core/Boot/ElfReader.h"
 #include "Core/CommonTitles.h"
@@ -239,6 +240,9 @@ Kernel::~Kernel()
     m_device_map.clear();
   }
 
+  if (m_fs)
+    m_fs->Flush();
+
   if (m_is_responsible_for_nand_root)
     Core::ShutdownWiiRoot();
 }
@@ -561,6 +565,8 @@ IPCCommandResult Kernel::OpenDevice(OpenRequest& request)
 
 IPCCommandResult Kernel::HandleIPCCommand(const Request& request)
 {
+  TRACE_SCOPE("IOS::HandleIPCCommand");
+
   if (request.command < IPC_CMD_OPEN || request.command > IPC_CMD_IOCTLV)
     return IPCCommandResult{IPC_EINVAL, true, 978 * SystemTimers::TIMER_RATIO};
 
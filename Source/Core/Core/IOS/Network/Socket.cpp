@@ -22,6 +22,7 @@
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/IOS.h"
 
@@ -265,6 +266,7 @@ void WiiSocket::Update(bool read, bool write, bool except)
           ret = static_cast<s32>(accept(fd, (sockaddr*)&local_name, &addrlen));
 
           WiiSockMan::Convert(local_name, *wii_name, addrlen);
+          Memory::NotifyWrite(ioctl.buffer_out, sizeof(WiiSockAddrIn));
         }
         else
         {
@@ -447,6 +449,8 @@ void WiiSocket::Update(bool read, bool write, bool except)
           {
             int ret = mbedtls_ssl_read(&Device::NetSSL::_SSL[sslID].ctx,
                                        Memory::GetPointer(BufferIn2), BufferInSize2);
+            if (ret > 0)
+              Memory::NotifyWrite(BufferIn2, ret);
 
             if (Config::Get(Config::MAIN_NETWORK_SSL_DUMP_READ) && ret > 0)
             {
@@ -564,6 +568,8 @@ void WiiSocket::Update(bool read, bool write, bool except)
                              BufferOutSize2 ? &addrlen : nullptr);
           ReturnValue =
               WiiSockMan::GetNetErrorCode(ret, BufferOutSize2 ? "SO_RECVFROM" : "SO_RECV", true);
+          if (ret > 0)
+            Memory::NotifyWrite(BufferOut, ret);
 
           INFO_LOG(IOS_NET,
                    "%s(%d, %p) Socket: %08X, Flags: %08X, "
@@ -577,6 +583,7 @@ void WiiSocket::Update(bool read, bool write, bool except)
           {
             WiiSockAddrIn* wii_name = (WiiSockAddrIn*)Memory::GetPointer(BufferOut2);
             WiiSockMan::Convert(local_name, *wii_name, addrlen);
+            Memory::NotifyWrite(BufferOut2, sizeof(WiiSockAddrIn));
           }
           break;
         }
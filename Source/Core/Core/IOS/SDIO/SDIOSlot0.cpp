@@ -257,6 +257,7 @@ s32 SDIOSlot0::ExecuteCommand(const Request& request, u32 buffer_in, u32 buffer_
 
       if (m_card.ReadBytes(Memory::GetPointer(req.addr), size))
       {
+        Memory::NotifyWrite(req.addr, size);
         DEBUG_LOG(IOS_SD, "Outbuffer size %i got %i", rw_buffer_size, size);
       }
       else
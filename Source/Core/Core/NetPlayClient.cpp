@@ -669,6 +669,7 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
       packet >> m_net_settings.m_JITFollowBranch;
       packet >> m_net_settings.m_FastDiscSpeed;
       packet >> m_net_settings.m_MMU;
+      packet >> m_net_settings.m_HLELibcFunctions;
       packet >> m_net_settings.m_Fastmem;
       packet >> m_net_settings.m_SkipIPL;
       packet >> m_net_settings.m_LoadIPLDump;
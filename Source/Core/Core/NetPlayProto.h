@@ -56,6 +56,7 @@ struct NetSettings
   bool m_JITFollowBranch;
   bool m_FastDiscSpeed;
   bool m_MMU;
+  bool m_HLELibcFunctions;
   bool m_Fastmem;
   bool m_SkipIPL;
   bool m_LoadIPLDump;
@@ -1315,6 +1315,7 @@ bool NetPlayServer::StartGame()
   spac << m_settings.m_JITFollowBranch;
   spac << m_settings.m_FastDiscSpeed;
   spac << m_settings.m_MMU;
+  spac << m_settings.m_HLELibcFunctions;
   spac << m_settings.m_Fastmem;
   spac << m_settings.m_SkipIPL;
   spac << m_settings.m_LoadIPLDump;
@@ -4,6 +4,9 @@
 
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 
+#include <cstring>
+
+#include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
@@ -12,13 +15,30 @@
 #include "Core/HW/CPU.h"
 #include "Core/PowerPC/Gekko.h"
 #include "Core/PowerPC/Jit64Common/Jit64Constants.h"
+#include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
+using Operands = CachedInterpreter::Operands;
+
+// Operands of the predecoded and fused instructions, extracted from the guest instruction(s) when
+// the block is compiled. They are stored in the slot following the instruction.
+struct CachedInterpreter::Operands
+{
+  u32 imm = 0;
+  u32 target = 0;
+  u32 next = 0;
+  u8 rd = 0;
+  u8 ra = 0;
+  u8 rb = 0;
+  u8 cr_bit = 0;
+};
+
 struct CachedInterpreter::Instruction
 {
   using CommonCallback = void (*)(UGeckoInstruction);
   using ConditionalCallback = bool (*)(u32);
+  using FusedCallback = void (*)(const Operands&);
 
   Instruction() {}
   Instruction(const CommonCallback c, UGeckoInstruction i)
@@ -31,17 +51,21 @@ struct CachedInterpreter::Instruction
   {
   }
 
+  explicit Instruction(const FusedCallback c) : fused_callback(c), type(Type::Fused) {}
+
   enum class Type
   {
     Abort,
     Common,
     Conditional,
+    Fused,
   };
 
   union
   {
     const CommonCallback common_callback;
     const ConditionalCallback conditional_callback;
+    const FusedCallback fused_callback;
   };
 
   u32 data = 0;
@@ -100,6 +124,11 @@ void CachedInterpreter::ExecuteOneBlock()
         return;
       break;
 
+    case Instruction::Type::Fused:
+      code->fused_callback(*reinterpret_cast<const Operands*>(code + 1));
+      ++code;
+      break;
+
     default:
       ERROR_LOG(POWERPC, "Unknown CachedInterpreter Instruction: %d", static_cast<int>(code->type));
       break;
@@ -190,6 +219,70 @@ static bool CheckIdle(u32 idle_pc)
   return false;
 }
 
+// The following replace common instructions with versions that don't have to decode the guest
+// instruction again every time they run. They must behave exactly like their Interpreter
+// counterparts.
+
+static void LoadImmediate(const Operands& o)
+{
+  rGPR[o.rd] = o.imm;
+}
+
+static void AddImmediate(const Operands& o)
+{
+  rGPR[o.rd] = rGPR[o.ra] + o.imm;
+}
+
+static void RotateAndMask(const Operands& o)
+{
+  rGPR[o.ra] = Common::RotateLeft(rGPR[o.rd], o.rb) & o.imm;
+}
+
+template <u32 (*read)(u32)>
+static void LoadWithUpdate(const Operands& o)
+{
+  const u32 address = rGPR[o.ra] + o.imm;
+  const u32 value = read(address);
+
+  if (!(PowerPC::ppcState.Exceptions & EXCEPTION_DSI))
+  {
+    rGPR[o.rd] = value;
+    rGPR[o.ra] = address;
+  }
+}
+
+// A compare followed by a conditional branch on the CR field it wrote, which doesn't touch CTR
+// or LR. The CR field still has to be written, since later code may read it.
+template <bool is_signed, bool is_register, bool branch_if>
+static void CompareAndBranch(const Operands& o)
+{
+  const u32 a = rGPR[o.ra];
+  const u32 b = is_register ? rGPR[o.rb] : o.imm;
+  u32 f;
+
+  if (is_signed ? static_cast<s32>(a) < static_cast<s32>(b) : a < b)
+    f = 0x8;
+  else if (is_signed ? static_cast<s32>(a) > static_cast<s32>(b) : a > b)
+    f = 0x4;
+  else
+    f = 0x2;  // equals
+
+  if (PowerPC::GetXER_SO())
+    f |= 0x1;
+
+  PowerPC::ppcState.cr.SetField(o.cr_bit >> 2, f);
+
+  const bool condition = ((f >> (3 - (o.cr_bit & 3))) & 1) == u32(branch_if);
+  NPC = condition ? o.target : o.next;
+}
+
+template <bool is_signed, bool is_register>
+static auto GetCompareAndBranch(bool branch_if)
+{
+  return branch_if ? CompareAndBranch<is_signed, is_register, true> :
+                     CompareAndBranch<is_signed, is_register, false>;
+}
+
 bool CachedInterpreter::HandleFunctionHooking(u32 address)
 {
   return HLE::ReplaceFunctionIfPossible(address, [&](u32 function, HLE::HookType type) {
@@ -205,6 +298,111 @@ bool CachedInterpreter::HandleFunctionHooking(u32 address)
   });
 }
 
+void CachedInterpreter::EmitFused(void (*callback)(const Operands&), const Operands& operands)
+{
+  static_assert(sizeof(Operands) <= sizeof(Instruction),
+                "The operands have to fit in the slot following a fused instruction");
+
+  m_code.emplace_back(callback);
+  // The next slot is only used as storage for the operands, ExecuteOneBlock skips over it.
+  m_code.emplace_back();
+  std::memcpy(static_cast<void*>(&m_code.back()), &operands, sizeof(operands));
+}
+
+bool CachedInterpreter::EmitPredecodedInstruction(const PPCAnalyst::CodeOp& op)
+{
+  const UGeckoInstruction inst = op.inst;
+  Operands o;
+  o.rd = static_cast<u8>(inst.RD);
+  o.ra = static_cast<u8>(inst.RA);
+
+  switch (inst.OPCD)
+  {
+  case 14:  // addi
+  case 15:  // addis
+    o.imm = inst.OPCD == 14 ? u32(inst.SIMM_16) : u32(inst.SIMM_16) << 16;
+    if (inst.RA == 0)
+      EmitFused(LoadImmediate, o);
+    else
+      EmitFused(AddImmediate, o);
+    return true;
+
+  case 21:  // rlwinmx
+    if (inst.Rc)
+      return false;
+    o.rb = static_cast<u8>(inst.SH);
+    o.imm = MakeRotationMask(inst.MB, inst.ME);
+    EmitFused(RotateAndMask, o);
+    return true;
+
+  case 33:  // lwzu
+  case 35:  // lbzu
+  case 41:  // lhzu
+    // Leave the invalid forms to the Interpreter.
+    if (inst.RA == 0 || inst.RA == inst.RD)
+      return false;
+    o.imm = u32(inst.SIMM_16);
+    if (inst.OPCD == 33)
+      EmitFused(LoadWithUpdate<PowerPC::Read_U32>, o);
+    else if (inst.OPCD == 35)
+      EmitFused(LoadWithUpdate<PowerPC::Read_U8_ZX>, o);
+    else
+      EmitFused(LoadWithUpdate<PowerPC::Read_U16_ZX>, o);
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+bool CachedInterpreter::EmitCompareAndBranch(const PPCAnalyst::CodeOp& compare,
+                                             const PPCAnalyst::CodeOp& branch)
+{
+  const UGeckoInstruction cmp = compare.inst;
+  const UGeckoInstruction bc = branch.inst;
+
+  const bool is_cmp = cmp.OPCD == 31 && (cmp.SUBOP10 == 0 || cmp.SUBOP10 == 32);
+  if (!is_cmp && cmp.OPCD != 10 && cmp.OPCD != 11)
+    return false;
+
+  if (branch.skip || bc.OPCD != 16 || bc.LK || !(bc.BO & BO_DONT_DECREMENT_FLAG) ||
+      (bc.BO & BO_DONT_CHECK_CONDITION) || (bc.BI >> 2) != cmp.CRFD)
+  {
+    return false;
+  }
+
+  // The branch must not need anything emitted in front of it.
+  if (SConfig::GetInstance().bEnableDebugging || HLE::GetFirstFunctionIndex(branch.address) != 0)
+    return false;
+
+  Operands o;
+  o.ra = static_cast<u8>(cmp.RA);
+  o.rb = static_cast<u8>(cmp.RB);
+  o.cr_bit = static_cast<u8>(bc.BI);
+  o.target = SignExt16(bc.BD << 2) + (bc.AA ? 0 : branch.address);
+  o.next = branch.address + 4;
+
+  const bool branch_if = (bc.BO & BO_BRANCH_IF_TRUE) != 0;
+  switch (cmp.OPCD)
+  {
+  case 11:  // cmpi
+    o.imm = u32(cmp.SIMM_16);
+    EmitFused(GetCompareAndBranch<true, false>(branch_if), o);
+    break;
+  case 10:  // cmpli
+    o.imm = cmp.UIMM;
+    EmitFused(GetCompareAndBranch<false, false>(branch_if), o);
+    break;
+  default:
+    if (cmp.SUBOP10 == 0)
+      EmitFused(GetCompareAndBranch<true, true>(branch_if), o);
+    else
+      EmitFused(GetCompareAndBranch<false, true>(branch_if), o);
+    break;
+  }
+  return true;
+}
+
 void CachedInterpreter::Jit(u32 address)
 {
   if (m_code.size() >= CODE_SIZE / sizeof(Instruction) - 0x1000 ||
@@ -235,6 +433,7 @@ void CachedInterpreter::Jit(u32 address)
   b->checkedEntry = GetCodePtr();
   b->normalEntry = GetCodePtr();
 
+  bool branch_fused = false;
   for (u32 i = 0; i < code_block.m_num_instructions; i++)
   {
     PPCAnalyst::CodeOp& op = m_code_buffer[i];
@@ -246,6 +445,10 @@ void CachedInterpreter::Jit(u32 address)
 
     if (!op.skip)
     {
+      // A branch that was fused with the compare in front of it has already set NPC.
+      const bool fused = branch_fused;
+      branch_fused = false;
+
       const bool breakpoint = SConfig::GetInstance().bEnableDebugging &&
                               PowerPC::breakpoints.IsAddressBreakPoint(op.address);
       const bool check_fpu = (op.opinfo->flags & FL_USE_FPU) && !js.firstFPInstructionFound;
@@ -266,9 +469,21 @@ void CachedInterpreter::Jit(u32 address)
         js.firstFPInstructionFound = true;
       }
 
-      if (endblock || memcheck)
+      if ((endblock || memcheck) && !fused)
         m_code.emplace_back(WritePC, op.address);
-      m_code.emplace_back(PPCTables::GetInterpreterOp(op.inst), op.inst);
+
+      if (!fused)
+      {
+        if (i + 1 < code_block.m_num_instructions &&
+            EmitCompareAndBranch(op, m_code_buffer[i + 1]))
+        {
+          branch_fused = true;
+        }
+        else if (!EmitPredecodedInstruction(op))
+        {
+          m_code.emplace_back(PPCTables::GetInterpreterOp(op.inst), op.inst);
+        }
+      }
       if (memcheck)
         m_code.emplace_back(CheckDSI, js.downcountAmount);
       if (idle_loop)
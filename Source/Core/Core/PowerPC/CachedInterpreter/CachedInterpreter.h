@@ -32,6 +32,9 @@ public:
   const char* GetName() const override { return "Cached Interpreter"; }
   const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
 
+  // Defined in CachedInterpreter.cpp. Public so that the instruction callbacks there can use it.
+  struct Operands;
+
 private:
   struct Instruction;
 
@@ -39,6 +42,9 @@ private:
   void ExecuteOneBlock();
 
   bool HandleFunctionHooking(u32 address);
+  bool EmitPredecodedInstruction(const PPCAnalyst::CodeOp& op);
+  bool EmitCompareAndBranch(const PPCAnalyst::CodeOp& compare, const PPCAnalyst::CodeOp& branch);
+  void EmitFused(void (*callback)(const Operands&), const Operands& operands);
 
   BlockCache m_block_cache{*this};
   std::vector<Instruction> m_code;
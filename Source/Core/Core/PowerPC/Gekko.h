@@ -878,11 +878,15 @@ enum
   SPR_L2CR = 1017,
 
   SPR_UMMCR0 = 936,
+  SPR_UPMC1 = 937,
+  SPR_UPMC2 = 938,
   SPR_MMCR0 = 952,
   SPR_PMC1 = 953,
   SPR_PMC2 = 954,
 
   SPR_UMMCR1 = 940,
+  SPR_UPMC3 = 941,
+  SPR_UPMC4 = 942,
   SPR_MMCR1 = 956,
   SPR_PMC3 = 957,
   SPR_PMC4 = 958,
@@ -4,6 +4,7 @@
 
 #include "Core/PowerPC/Jit64/Jit.h"
 
+#include <algorithm>
 #include <map>
 #include <sstream>
 #include <string>
@@ -16,6 +17,7 @@
 #include <windows.h>
 #endif
 
+#include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
 #include "Common/GekkoDisassembler.h"
@@ -25,6 +27,7 @@
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Common/x64ABI.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HLE/HLE.h"
@@ -155,6 +158,9 @@ enum
   GUARD_OFFSET = STACK_SIZE - SAFE_STACK_SIZE - GUARD_SIZE,
 };
 
+// Number of runs after which a first-tier block is recompiled with the full set of optimizations.
+constexpr u32 TIER_UP_THRESHOLD = 1000;
+
 Jit64::Jit64() : QuantizedMemoryRoutines(*this)
 {
 }
@@ -233,11 +239,27 @@ bool Jit64::HandleFault(uintptr_t access_address, SContext* ctx)
 
   const auto logical_base_ptr = reinterpret_cast<uintptr_t>(Memory::logical_base);
   if (access_address >= logical_base_ptr && access_address < logical_base_ptr + 0x100010000)
-    return BackPatch(static_cast<u32>(access_address - logical_base_ptr), ctx);
+  {
+    const u32 em_address = static_cast<u32>(access_address - logical_base_ptr);
+    if (access_address < logical_base_ptr + 0x100000000)
+      RequestFastmemPage(em_address, ctx);
+    return BackPatch(em_address, ctx);
+  }
 
   return false;
 }
 
+// With the MMU enabled, pages that are translated through the page table aren't part of the
+// logical memory arena until they are first accessed. Mapping a page isn't safe from the fault
+// handler, so the faulting access is backpatched as usual and the page is mapped afterwards for
+// the instructions that access it later.
+void Jit64::RequestFastmemPage(u32 emAddress, SContext* ctx)
+{
+  auto it = m_back_patch_info.find(reinterpret_cast<u8*>(ctx->CTX_PC));
+  if (it != m_back_patch_info.end())
+    PowerPC::RequestFastmemPage(emAddress, !it->second.read);
+}
+
 bool Jit64::BackPatch(u32 emAddress, SContext* ctx)
 {
   u8* codePtr = reinterpret_cast<u8*>(ctx->CTX_PC);
@@ -335,6 +357,10 @@ void Jit64::Init()
   jo.fastmem_arena = SConfig::GetInstance().bFastmem && Memory::InitFastmemArena();
   jo.optimizeGatherPipe = true;
   jo.accurateSinglePrecision = true;
+  // The hot tier differs from the first one mostly by following more branches, so without branch
+  // following a tier-up would only cost a recompile.
+  jo.tieredCompilation = Config::Get(Config::MAIN_JIT_TIERED_COMPILATION) &&
+                         SConfig::GetInstance().bJITFollowBranch;
   UpdateMemoryOptions();
   js.fastmemLoadStore = nullptr;
   js.compilerPC = 0;
@@ -659,6 +685,22 @@ void Jit64::WriteIdleExit(u32 destination)
   WriteExceptionExit();
 }
 
+void Jit64::CountBranch(u32 address, bool taken)
+{
+  std::vector<JitBlock::BranchCounter>& counters = js.curBlock->branchCounters;
+  auto counter = std::find_if(counters.begin(), counters.end(),
+                              [address](const auto& c) { return c.address == address; });
+  if (counter == counters.end())
+  {
+    // DoJit reserved a counter for every branch, so this doesn't move the existing ones.
+    ASSERT(counters.size() < counters.capacity());
+    counter = counters.insert(counters.end(), {address, 0, 0});
+  }
+
+  MOV(64, R(RSCRATCH), ImmPtr(taken ? &counter->taken : &counter->not_taken));
+  ADD(32, MatR(RSCRATCH), Imm8(1));
+}
+
 void Jit64::WriteExceptionExit()
 {
   Cleanup();
@@ -743,7 +785,42 @@ void Jit64::Jit(u32 em_address)
     ClearCache();
   }
 
+  u64 compile_start;
+  QueryPerformanceCounter((LARGE_INTEGER*)&compile_start);
+
   std::size_t block_size = m_code_buffer.size();
+  PPCAnalyst::PPCAnalyzer::BranchProfile branch_profile;
+
+  // The hot block hint of a previous session affects the analysis, so it has to be loaded first.
+  JitInterface::LoadCachedExceptionChecks(em_address);
+
+  if (jo.tieredCompilation)
+  {
+    // Blocks start out with cheap analysis, a run counter and branch counters. Once they get hot,
+    // they are invalidated and recompiled here with larger blocks, all reordering passes and
+    // traces through the branches that were usually taken.
+    EnableOptimization();
+    if (js.hotBlockAddresses.find(em_address) != js.hotBlockAddresses.end())
+    {
+      analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW_EXTENDED);
+      analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_TRACE_HOT_BRANCHES);
+
+      const auto profile = js.branchProfiles.find(em_address);
+      if (profile != js.branchProfiles.end())
+      {
+        branch_profile = std::move(profile->second);
+        js.branchProfiles.erase(profile);
+      }
+    }
+    else
+    {
+      analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW_EXTENDED);
+      analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_TRACE_HOT_BRANCHES);
+      analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+      analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
+      analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
+    }
+  }
 
   if (SConfig::GetInstance().bEnableDebugging)
   {
@@ -773,7 +850,9 @@ void Jit64::Jit(u32 em_address)
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
+  analyzer.SetBranchProfile(&branch_profile);
   const u32 nextPC = analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
+  analyzer.SetBranchProfile(nullptr);
 
   if (code_block.m_memory_exception)
   {
@@ -785,9 +864,16 @@ void Jit64::Jit(u32 em_address)
     return;
   }
 
+  for (u32 i = 0; i < code_block.m_num_instructions; i++)
+    JitInterface::LoadCachedExceptionChecks(m_code_buffer[i].address);
+
   JitBlock* b = blocks.AllocateBlock(em_address);
   DoJit(em_address, b, nextPC);
   blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+
+  u64 compile_end;
+  QueryPerformanceCounter((LARGE_INTEGER*)&compile_end);
+  js.compileTicks += compile_end - compile_start;
 }
 
 u8* Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
@@ -824,6 +910,32 @@ u8* Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     ADD(64, MDisp(ABI_PARAM1, offset), Imm8(1));
     ABI_CallFunction(QueryPerformanceCounter);
   }
+
+  js.countBranches = jo.tieredCompilation &&
+                     js.hotBlockAddresses.find(js.blockStart) == js.hotBlockAddresses.end();
+  if (js.countBranches)
+  {
+    // Counters must not move once code refers to them, so make room for one per branch.
+    b->branchCounters.reserve(std::count_if(
+        m_code_buffer.begin(), m_code_buffer.begin() + code_block.m_num_instructions,
+        [](const PPCAnalyst::CodeOp& op) { return op.inst.OPCD == 16; }));
+
+    // Count down the runs of this first-tier block and request a recompile once it gets hot.
+    b->tierUpCountdown = TIER_UP_THRESHOLD;
+    MOV(64, R(RSCRATCH), ImmPtr(&b->tierUpCountdown));
+    SUB(32, MatR(RSCRATCH), Imm8(1));
+    FixupBranch hot = J_CC(CC_Z, true);
+
+    SwitchToFarCode();
+    SetJumpTarget(hot);
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionC(JitInterface::CompileExceptionCheck,
+                      static_cast<u32>(JitInterface::ExceptionType::HotBlock));
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    JMP(asm_routines.dispatcher_no_check, true);
+    SwitchToNearCode();
+  }
 #if defined(_DEBUG) || defined(DEBUGFAST) || defined(NAN_CHECK)
   // should help logged stack-traces become more accurate
   MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
@@ -1086,6 +1198,7 @@ u8* Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
 
   if (code_block.m_broken)
   {
+    b->eliminatedStores += gpr.Discard(code_block.m_gpr_dead_at_exit);
     gpr.Flush();
     fpr.Flush();
     WriteExit(nextPC);
@@ -1126,6 +1239,7 @@ void Jit64::EnableOptimization()
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+  analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_EXIT_LIVENESS);
 }
 
 void Jit64::IntializeSpeculativeConstants()
@@ -49,6 +49,7 @@ public:
   bool HandleFault(uintptr_t access_address, SContext* ctx) override;
   bool HandleStackFault() override;
   bool BackPatch(u32 emAddress, SContext* ctx);
+  void RequestFastmemPage(u32 emAddress, SContext* ctx);
 
   void EnableOptimization();
   void EnableBlockLink();
@@ -85,6 +86,7 @@ public:
   void WriteExternalExceptionExit();
   void WriteRfiExitDestInRSCRATCH();
   void WriteIdleExit(u32 destination);
+  void CountBranch(u32 address, bool taken);
   bool Cleanup();
 
   void GenerateConstantOverflow(bool overflow);
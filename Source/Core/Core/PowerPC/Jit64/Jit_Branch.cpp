@@ -84,6 +84,9 @@ void Jit64::bx(UGeckoInstruction inst)
     return;
   }
 
+  // The analyzer only looks past unconditional branches without LK.
+  if (!inst.LK)
+    js.curBlock->eliminatedStores += gpr.Discard(code_block.m_gpr_dead_at_exit);
   gpr.Flush();
   fpr.Flush();
 
@@ -131,6 +134,30 @@ void Jit64::bcx(UGeckoInstruction inst)
   if (inst.LK)
     MOV(32, PPCSTATE_LR, Imm32(js.compilerPC + 4));
 
+  const bool count_branch = js.countBranches && !inst.LK &&
+                            ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0 ||
+                             (inst.BO & BO_DONT_CHECK_CONDITION) == 0);
+
+  // The analyzer continued the block at the branch target, so leave it through a side exit
+  // when the branch isn't taken.
+  if (js.op->branchFollowTaken)
+  {
+    SwitchToFarCode();
+    if ((inst.BO & BO_DONT_CHECK_CONDITION) == 0)
+      SetJumpTarget(pConditionDontBranch);
+    if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
+      SetJumpTarget(pCTRDontBranch);
+    {
+      RCForkGuard gpr_guard = gpr.Fork();
+      RCForkGuard fpr_guard = fpr.Fork();
+      gpr.Flush();
+      fpr.Flush();
+      WriteExit(js.compilerPC + 4);
+    }
+    SwitchToNearCode();
+    return;
+  }
+
   // If this is not the last instruction of a block
   // and an unconditional branch, we will skip the rest process.
   // Because PPCAnalyst::Flatten() merged the blocks.
@@ -153,6 +180,9 @@ void Jit64::bcx(UGeckoInstruction inst)
     gpr.Flush();
     fpr.Flush();
 
+    if (count_branch)
+      CountBranch(js.compilerPC, true);
+
     if (js.op->branchIsIdleLoop)
     {
       WriteIdleExit(js.op->branchTo);
@@ -168,6 +198,9 @@ void Jit64::bcx(UGeckoInstruction inst)
   if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
     SetJumpTarget(pCTRDontBranch);
 
+  if (count_branch)
+    CountBranch(js.compilerPC, false);
+
   if (!analyzer.HasOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE))
   {
     gpr.Flush();
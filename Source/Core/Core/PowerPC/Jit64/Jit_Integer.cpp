@@ -349,6 +349,10 @@ bool Jit64::CheckMergedBranch(u32 crf) const
   if (!CanMergeNextInstructions(1))
     return false;
 
+  // Traced branches need their own side exit, see bcx.
+  if (js.op[1].branchFollowTaken)
+    return false;
+
   const UGeckoInstruction& next = js.op[1].inst;
   return (((next.OPCD == 16 /* bcx */) ||
            ((next.OPCD == 19) && (next.SUBOP10 == 528) /* bcctrx */) ||
@@ -374,6 +378,8 @@ void Jit64::DoMergedBranch()
   {
     if (next.LK)
       MOV(32, PPCSTATE(spr[SPR_LR]), Imm32(nextPC + 4));
+    else if (js.countBranches)
+      CountBranch(nextPC, true);
 
     u32 destination;
     if (next.AA)
@@ -438,6 +444,9 @@ void Jit64::DoMergedBranchCondition()
 
   SetJumpTarget(pDontBranch);
 
+  if (js.countBranches && next.OPCD == 16 && !next.LK)
+    CountBranch(nextPC, false);
+
   if (!analyzer.HasOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE))
   {
     gpr.Flush();
@@ -473,11 +482,17 @@ void Jit64::DoMergedBranchImmediate(s64 val)
     fpr.Flush();
     DoMergedBranch();
   }
-  else if (!analyzer.HasOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE))
+  else
   {
-    gpr.Flush();
-    fpr.Flush();
-    WriteExit(nextPC + 4);
+    if (js.countBranches && next.OPCD == 16 && !next.LK)
+      CountBranch(nextPC, false);
+
+    if (!analyzer.HasOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE))
+    {
+      gpr.Flush();
+      fpr.Flush();
+      WriteExit(nextPC + 4);
+    }
   }
 }
 
@@ -269,6 +269,17 @@ void Jit64::mtspr(UGeckoInstruction inst)
   RCOpArg Rd = gpr.BindOrImm(d, RCMode::Read);
   RegCache::Realize(Rd);
   MOV(32, PPCSTATE(spr[iIndex]), Rd);
+
+  // A GQR set from a constant is known for the rest of the block, so the quantized loads and
+  // stores after this can be specialized for it.
+  if (iIndex >= SPR_GQR0 && iIndex < SPR_GQR0 + 8)
+  {
+    const u8 gqr = static_cast<u8>(iIndex - SPR_GQR0);
+    if (Rd.IsImm())
+      js.constantGqr[gqr] = Rd.Imm32();
+    else
+      js.constantGqr.erase(gqr);
+  }
 }
 
 void Jit64::mfspr(UGeckoInstruction inst)
@@ -411,6 +411,39 @@ void RegCache::Flush(BitSet32 pregs)
   }
 }
 
+u32 RegCache::Discard(BitSet32 pregs)
+{
+  u32 skipped_stores = 0;
+  for (preg_t i : pregs)
+  {
+    ASSERT_MSG(DYNA_REC, !m_regs[i].IsLocked(), "Discarding locked PPC reg %zu", i);
+    ASSERT_MSG(DYNA_REC, !m_regs[i].IsRevertable(), "Register transaction is in progress!");
+
+    switch (m_regs[i].GetLocationType())
+    {
+    case PPCCachedReg::LocationType::Default:
+      break;
+    case PPCCachedReg::LocationType::SpeculativeImmediate:
+      m_regs[i].SetFlushed();
+      break;
+    case PPCCachedReg::LocationType::Bound:
+    {
+      const X64Reg xr = m_regs[i].Location().GetSimpleReg();
+      if (m_xregs[xr].IsDirty())
+        skipped_stores++;
+      m_xregs[xr].SetFlushed();
+      m_regs[i].SetFlushed();
+      break;
+    }
+    case PPCCachedReg::LocationType::Immediate:
+      skipped_stores++;
+      m_regs[i].SetFlushed();
+      break;
+    }
+  }
+  return skipped_stores;
+}
+
 void RegCache::Revert()
 {
   ASSERT(IsAllUnlocked());
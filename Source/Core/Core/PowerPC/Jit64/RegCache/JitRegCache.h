@@ -170,6 +170,9 @@ public:
 
   RCForkGuard Fork();
   void Flush(BitSet32 pregs = BitSet32::AllTrue(32));
+  // Forgets the values of pregs without storing them, for registers that are known to be
+  // overwritten before they are read again. Returns the number of stores skipped.
+  u32 Discard(BitSet32 pregs);
   void Revert();
   void Commit();
 
@@ -44,6 +44,20 @@ OpArg FixImmediate(int access_size, OpArg arg)
   }
   return arg;
 }
+
+// Returns the MMIO address that a write to address can be inlined for, or 0. Writes anywhere
+// in the gather pipe page go to the FIFO rather than to an MMIO handler.
+u32 GetOptimizableMMIOWrite(u32 address, int access_size)
+{
+  if (access_size == 64)
+    return 0;
+
+  const u32 mmio_address = PowerPC::IsOptimizableMMIOAccess(address, access_size);
+  if ((mmio_address & 0xFFFFF000) == 0x0C008000)
+    return 0;
+
+  return mmio_address;
+}
 }  // Anonymous namespace
 
 void EmuCodeBlock::MemoryExceptionCheck()
@@ -315,6 +329,101 @@ void EmuCodeBlock::MMIOLoadToReg(MMIO::Mapping* mmio, Gen::X64Reg reg_value,
   }
 }
 
+// Visitor that generates code to write a MMIO value.
+template <typename T>
+class MMIOWriteCodeGenerator : public MMIO::WriteHandlingMethodVisitor<T>
+{
+public:
+  MMIOWriteCodeGenerator(Gen::X64CodeBlock* code, BitSet32 registers_in_use,
+                         const Gen::OpArg& value, u32 address)
+      : m_code(code), m_registers_in_use(registers_in_use), m_value(value), m_address(address)
+  {
+  }
+
+  void VisitNop() override
+  {
+    // Do nothing
+  }
+  void VisitDirect(T* addr, u32 mask) override { WriteValueToAddr(8 * sizeof(T), addr, mask); }
+  void VisitComplex(const std::function<void(u32, T)>* lambda) override
+  {
+    CallLambda(8 * sizeof(T), lambda);
+  }
+
+private:
+  void WriteValueToAddr(int sbits, void* ptr, u32 mask)
+  {
+    const u32 all_ones = (1ULL << sbits) - 1;
+    const bool needs_mask = (all_ones & mask) != all_ones;
+
+    // Constant values are masked at compile time and stored directly.
+    if (m_value.IsImm())
+    {
+      const u32 value = m_value.AsImm32().Imm32() & mask;
+      m_code->MOV(64, R(RSCRATCH2), ImmPtr(ptr));
+      m_code->MOV(sbits, MatR(RSCRATCH2),
+                  sbits == 8 ? Imm8(value) : sbits == 16 ? Imm16(value) : Imm32(value));
+      return;
+    }
+
+    X64Reg reg = RSCRATCH;
+    if (m_value.IsSimpleReg() && !needs_mask)
+      reg = m_value.GetSimpleReg();
+    else if (!m_value.IsSimpleReg(RSCRATCH))
+      m_code->MOV(32, R(RSCRATCH), m_value);
+    if (needs_mask)
+      m_code->AND(32, R(RSCRATCH), Imm32(mask));
+
+    m_code->MOV(64, R(RSCRATCH2), ImmPtr(ptr));
+    m_code->MOV(sbits, MatR(RSCRATCH2), R(reg));
+  }
+
+  void CallLambda(int sbits, const std::function<void(u32, T)>* lambda)
+  {
+    m_code->ABI_PushRegistersAndAdjustStack(m_registers_in_use, 0);
+    // Load the value first, it may live in one of the other parameter registers.
+    if (m_value.IsImm())
+      m_code->MOV(32, R(ABI_PARAM3), Imm32(m_value.AsImm32().Imm32() & ((1ULL << sbits) - 1)));
+    else if (sbits == 32)
+      m_code->MOV(32, R(ABI_PARAM3), m_value);
+    else
+      m_code->MOVZX(32, sbits, ABI_PARAM3, m_value);
+    m_code->ABI_CallFunctionPC(&XEmitter::CallLambdaTrampoline<void, u32, T>, lambda, m_address);
+    m_code->ABI_PopRegistersAndAdjustStack(m_registers_in_use, 0);
+  }
+
+  Gen::X64CodeBlock* m_code;
+  BitSet32 m_registers_in_use;
+  Gen::OpArg m_value;
+  u32 m_address;
+};
+
+void EmuCodeBlock::MMIOWriteToAddr(MMIO::Mapping* mmio, const Gen::OpArg& value,
+                                   BitSet32 registers_in_use, u32 address, int access_size)
+{
+  switch (access_size)
+  {
+  case 8:
+  {
+    MMIOWriteCodeGenerator<u8> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u8>(address).Visit(gen);
+    break;
+  }
+  case 16:
+  {
+    MMIOWriteCodeGenerator<u16> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u16>(address).Visit(gen);
+    break;
+  }
+  case 32:
+  {
+    MMIOWriteCodeGenerator<u32> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u32>(address).Visit(gen);
+    break;
+  }
+  }
+}
+
 void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress, int accessSize,
                                  s32 offset, BitSet32 registersInUse, bool signExtend, int flags)
 {
@@ -646,6 +755,12 @@ bool EmuCodeBlock::WriteToConstAddress(int accessSize, OpArg arg, u32 address,
     WriteToConstRamAddress(accessSize, arg, address);
     return false;
   }
+  else if (const u32 mmio_address = GetOptimizableMMIOWrite(address, accessSize))
+  {
+    // If the address maps to an MMIO register, inline MMIO write code.
+    MMIOWriteToAddr(Memory::mmio_mapping.get(), arg, registersInUse, mmio_address, accessSize);
+    return false;
+  }
   else
   {
     // Helps external systems know which instruction triggered the write
@@ -69,6 +69,8 @@ public:
   // call for known addresses in MMIO range (MMIO::IsMMIOAddress).
   void MMIOLoadToReg(MMIO::Mapping* mmio, Gen::X64Reg reg_value, BitSet32 registers_in_use,
                      u32 address, int access_size, bool sign_extend);
+  void MMIOWriteToAddr(MMIO::Mapping* mmio, const Gen::OpArg& value, BitSet32 registers_in_use,
+                       u32 address, int access_size);
 
   enum SafeLoadStoreFlags
   {
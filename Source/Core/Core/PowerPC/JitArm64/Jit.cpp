@@ -586,6 +586,9 @@ void JitArm64::Jit(u32)
     return;
   }
 
+  for (u32 i = 0; i < code_block.m_num_instructions; i++)
+    JitInterface::LoadCachedExceptionChecks(m_code_buffer[i].address);
+
   JitBlock* b = blocks.AllocateBlock(em_address);
   DoJit(em_address, b, nextPC);
   blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
@@ -5,6 +5,7 @@
 #include "Core/PowerPC/JitCommon/JitBase.h"
 
 #include "Common/CommonTypes.h"
+#include "Common/Trace.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/CPU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
@@ -17,6 +18,7 @@ const u8* JitBase::Dispatch(JitBase& jit)
 
 void JitTrampoline(JitBase& jit, u32 em_address)
 {
+  TRACE_SCOPE("JitBase::Jit");
   jit.Jit(em_address);
 }
 
@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "Common/CommonTypes.h"
@@ -51,6 +53,7 @@ protected:
     bool fastmem_arena;
     bool memcheck;
     bool profile_blocks;
+    bool tieredCompilation;
   };
   struct JitState
   {
@@ -92,6 +95,17 @@ protected:
     std::unordered_set<u32> fifoWriteAddresses;
     std::unordered_set<u32> pairedQuantizeAddresses;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
+    std::unordered_set<u32> hotBlockAddresses;
+
+    // Branch counts of first-tier blocks that got hot, by block address. They are consumed when
+    // the block is recompiled for the hot tier.
+    std::unordered_map<u32, PPCAnalyst::PPCAnalyzer::BranchProfile> branchProfiles;
+    bool countBranches;
+
+    // Statistics reported alongside the block profile. The compile time can also be read from
+    // other threads while the JIT is running.
+    u64 numTierUps = 0;
+    std::atomic<u64> compileTicks{0};
   };
 
   PPCAnalyst::CodeBlock code_block;
@@ -65,6 +65,8 @@ void JitBaseBlockCache::Clear()
 #endif
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
+  m_jit.js.hotBlockAddresses.clear();
+  m_jit.js.branchProfiles.clear();
   for (auto& e : block_map)
   {
     DestroyBlock(e.second);
@@ -216,6 +218,8 @@ void JitBaseBlockCache::InvalidateICache(u32 address, u32 length, bool forced)
       {
         m_jit.js.fifoWriteAddresses.erase(i);
         m_jit.js.pairedQuantizeAddresses.erase(i);
+        m_jit.js.hotBlockAddresses.erase(i);
+        m_jit.js.branchProfiles.erase(i);
       }
     }
   }
@@ -83,6 +83,24 @@ struct JitBlock : public JitBlockData
     u64 ticStart;
     u64 ticStop;
   } profile_data = {};
+
+  // Number of runs left before a first-tier block gets recompiled with the full set of
+  // optimizations. Only used with tiered compilation.
+  u32 tierUpCountdown = 0;
+
+  // How often the conditional branches of a first-tier block went either way. The compiled code
+  // increments these in place, so no counters may be added once the block has been emitted.
+  struct BranchCounter
+  {
+    u32 address;
+    u32 taken;
+    u32 not_taken;
+  };
+  std::vector<BranchCounter> branchCounters;
+
+  // Number of GPR stores skipped at the exit of this block, because the code after it overwrites
+  // the registers. Shown in the profiler output.
+  u32 eliminatedStores = 0;
 };
 
 typedef void (*CompiledCode)();
@@ -0,0 +1,64 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/PowerPC/JitCommon/JitProfileCache.h"
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+
+class JitProfileCache::Reader final : public LinearDiskCacheReader<Key, u32>
+{
+public:
+  explicit Reader(JitProfileCache& cache) : m_cache(cache) {}
+
+  void Read(const Key& key, const u32* value, u32 value_size) override
+  {
+    // Entries of types this build doesn't know about are dropped.
+    if (value_size != 1 || key.type > JitInterface::ExceptionType::HotBlock)
+      return;
+
+    m_cache.m_recorded.emplace(key.address, key.type, *value);
+    m_cache.m_pending.emplace(key.address, std::make_pair(key.type, *value));
+  }
+
+private:
+  JitProfileCache& m_cache;
+};
+
+void JitProfileCache::Open(const std::string& game_id)
+{
+  Close();
+  if (game_id.empty())
+    return;
+
+  const std::string path = File::GetUserPath(D_CACHE_IDX) + "JIT" DIR_SEP;
+  if (!File::CreateFullPath(path))
+    return;
+
+  Reader reader(*this);
+  const u32 count = m_file.OpenAndRead(path + game_id + ".jitprofile", reader);
+  INFO_LOG(DYNA_REC, "Loaded %u cached JIT exception checks for %s", count, game_id.c_str());
+  m_is_open = true;
+}
+
+void JitProfileCache::Close()
+{
+  if (m_is_open)
+  {
+    m_file.Sync();
+    m_file.Close();
+    m_is_open = false;
+  }
+  m_pending.clear();
+  m_recorded.clear();
+}
+
+void JitProfileCache::Record(JitInterface::ExceptionType type, u32 address, u32 instruction)
+{
+  if (!m_is_open || !m_recorded.emplace(address, type, instruction).second)
+    return;
+
+  m_file.Append({address, type}, &instruction, 1);
+}
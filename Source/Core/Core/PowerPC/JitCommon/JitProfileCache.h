@@ -0,0 +1,68 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
+#include "Core/PowerPC/JitInterface.h"
+
+// Remembers the addresses at which a block had to be recompiled with an exception check (see
+// JitInterface::CompileExceptionCheck) across sessions, so that the next time the same game is
+// run these blocks are compiled correctly the first time. Each entry also stores the instruction
+// it was recorded for, entries for code that has changed since are never applied.
+class JitProfileCache final
+{
+public:
+  struct Key
+  {
+    u32 address;
+    JitInterface::ExceptionType type;
+  };
+
+  // Loads the entries recorded for game_id. New entries are appended to the same file.
+  void Open(const std::string& game_id);
+  void Close();
+
+  // Appends an entry unless one was already recorded for the same address, type and instruction.
+  void Record(JitInterface::ExceptionType type, u32 address, u32 instruction);
+
+  // Calls apply(type) for every entry recorded at address whose instruction still matches the
+  // one returned by read_instruction, and forgets all entries at address.
+  template <typename R, typename F>
+  void Load(u32 address, R read_instruction, F apply)
+  {
+    if (m_pending.empty())
+      return;
+
+    const auto range = m_pending.equal_range(address);
+    if (range.first == range.second)
+      return;
+
+    const u32 instruction = read_instruction();
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      if (it->second.second == instruction)
+        apply(it->second.first);
+    }
+    m_pending.erase(range.first, range.second);
+  }
+
+private:
+  class Reader;
+
+  LinearDiskCache<Key, u32> m_file;
+  std::unordered_multimap<u32, std::pair<JitInterface::ExceptionType, u32>> m_pending;
+  // Every (address, type, instruction) in the file, loaded or appended, so the file doesn't grow
+  // with duplicates. The instruction is part of it, so that an entry is still recorded when the
+  // code at an address has changed since the old entry was.
+  std::set<std::tuple<u32, JitInterface::ExceptionType, u32>> m_recorded;
+  bool m_is_open = false;
+};
@@ -21,10 +21,14 @@
 #include "Common/File.h"
 #include "Common/MsgHandler.h"
 
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitCommon/JitProfileCache.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
@@ -41,6 +45,7 @@
 namespace JitInterface
 {
 static JitBase* g_jit = nullptr;
+static JitProfileCache s_profile_cache;
 void SetJit(JitBase* jit)
 {
   g_jit = jit;
@@ -76,6 +81,12 @@ CPUCoreBase* InitJitCore(PowerPC::CPUCore core)
     return nullptr;
   }
   g_jit->Init();
+
+  // The cached checks change when FIFO and exception checks happen, which would make the
+  // emulation depend on the contents of the cache.
+  if (Config::Get(Config::MAIN_JIT_PROFILE_CACHE) && !Core::WantsDeterminism())
+    s_profile_cache.Open(SConfig::GetInstance().GetGameID());
+
   return g_jit;
 }
 
@@ -104,17 +115,32 @@ void WriteProfileResults(const std::string& filename)
     return;
   }
   fprintf(f.GetHandle(), "origAddr\tblkName\trunCount\tcost\ttimeCost\tpercent\ttimePercent\tOvAlli"
-                         "nBlkTime(ms)\tblkCodeSize\n");
+                         "nBlkTime(ms)\tblkCodeSize\telimStores\n");
   for (auto& stat : prof_stats.block_stats)
   {
     std::string name = g_symbolDB.GetDescription(stat.addr);
     double percent = 100.0 * (double)stat.cost / (double)prof_stats.cost_sum;
     double timePercent = 100.0 * (double)stat.tick_counter / (double)prof_stats.timecost_sum;
     fprintf(f.GetHandle(),
-            "%08x\t%s\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\t%.2f\t%.2f\t%.2f\t%i\n", stat.addr,
-            name.c_str(), stat.run_count, stat.cost, stat.tick_counter, percent, timePercent,
-            (double)stat.tick_counter * 1000.0 / (double)prof_stats.countsPerSec, stat.block_size);
+            "%08x\t%s\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\t%.2f\t%.2f\t%.2f\t%i\t%u\n",
+            stat.addr, name.c_str(), stat.run_count, stat.cost, stat.tick_counter, percent,
+            timePercent, (double)stat.tick_counter * 1000.0 / (double)prof_stats.countsPerSec,
+            stat.block_size, stat.eliminated_stores);
   }
+  fprintf(f.GetHandle(), "\nTier-ups: %" PRIu64 "\nCompile time (ms): %.2f\n",
+          prof_stats.tier_up_count,
+          (double)prof_stats.compile_ticks * 1000.0 / (double)prof_stats.countsPerSec);
+}
+
+u64 GetCompileTimeUs()
+{
+  if (!g_jit)
+    return 0;
+
+  u64 counts_per_sec;
+  QueryPerformanceFrequency((LARGE_INTEGER*)&counts_per_sec);
+  return static_cast<u64>(g_jit->js.compileTicks.load(std::memory_order_relaxed) * 1000000.0 /
+                          counts_per_sec);
 }
 
 void GetProfileResults(Profiler::ProfileStats* prof_stats)
@@ -132,6 +158,8 @@ void GetProfileResults(Profiler::ProfileStats* prof_stats)
     Core::SetState(Core::State::Paused);
 
   QueryPerformanceFrequency((LARGE_INTEGER*)&prof_stats->countsPerSec);
+  prof_stats->tier_up_count = g_jit->js.numTierUps;
+  prof_stats->compile_ticks = g_jit->js.compileTicks;
   g_jit->GetBlockCache()->RunOnBlocks([&prof_stats](const JitBlock& block) {
     const auto& data = block.profile_data;
     u64 cost = data.downcountCounter;
@@ -139,7 +167,7 @@ void GetProfileResults(Profiler::ProfileStats* prof_stats)
     // Todo: tweak.
     if (data.runCount >= 1)
       prof_stats->block_stats.emplace_back(block.effectiveAddress, cost, timecost, data.runCount,
-                                           block.codeSize);
+                                           block.codeSize, block.eliminatedStores);
     prof_stats->cost_sum += cost;
     prof_stats->timecost_sum += timecost;
   });
@@ -190,6 +218,10 @@ int GetHostCode(u32* address, const u8** code, u32* code_size)
 
 bool HandleFault(uintptr_t access_address, SContext* ctx)
 {
+  // Stores to pages that are watched for writes are let through after recording the write.
+  if (Memory::HandleWriteWatchFault(access_address))
+    return true;
+
   // Prevent nullptr dereference on a crash with no JIT present
   if (!g_jit)
   {
@@ -226,36 +258,53 @@ void InvalidateICache(u32 address, u32 size, bool forced)
     g_jit->GetBlockCache()->InvalidateICache(address, size, forced);
 }
 
-void CompileExceptionCheck(ExceptionType type)
+static std::unordered_set<u32>* GetExceptionAddresses(ExceptionType type)
 {
-  if (!g_jit)
-    return;
-
-  std::unordered_set<u32>* exception_addresses = nullptr;
-
   switch (type)
   {
   case ExceptionType::FIFOWrite:
-    exception_addresses = &g_jit->js.fifoWriteAddresses;
-    break;
+    return &g_jit->js.fifoWriteAddresses;
   case ExceptionType::PairedQuantize:
-    exception_addresses = &g_jit->js.pairedQuantizeAddresses;
-    break;
+    return &g_jit->js.pairedQuantizeAddresses;
   case ExceptionType::SpeculativeConstants:
-    exception_addresses = &g_jit->js.noSpeculativeConstantsAddresses;
-    break;
+    return &g_jit->js.noSpeculativeConstantsAddresses;
+  case ExceptionType::HotBlock:
+    return &g_jit->js.hotBlockAddresses;
   }
+  return nullptr;
+}
+
+void CompileExceptionCheck(ExceptionType type)
+{
+  if (!g_jit)
+    return;
+
+  std::unordered_set<u32>* exception_addresses = GetExceptionAddresses(type);
 
   if (PC != 0 && (exception_addresses->find(PC)) == (exception_addresses->end()))
   {
+    const u32 instruction = PowerPC::HostRead_U32(PC);
     if (type == ExceptionType::FIFOWrite)
     {
       // Check in case the code has been replaced since: do we need to do this?
-      const OpType optype = PPCTables::GetOpInfo(PowerPC::HostRead_U32(PC))->type;
+      const OpType optype = PPCTables::GetOpInfo(instruction)->type;
       if (optype != OpType::Store && optype != OpType::StoreFP && optype != OpType::StorePS)
         return;
     }
     exception_addresses->insert(PC);
+    if (type == ExceptionType::HotBlock)
+    {
+      g_jit->js.numTierUps++;
+
+      // Hand the branch counts of the first-tier block over to its recompilation.
+      if (const JitBlock* block = g_jit->GetBlockCache()->GetBlockFromStartAddress(PC, MSR.Hex))
+      {
+        auto& profile = g_jit->js.branchProfiles[PC];
+        for (const JitBlock::BranchCounter& counter : block->branchCounters)
+          profile[counter.address] = {counter.taken, counter.not_taken};
+      }
+    }
+    s_profile_cache.Record(type, PC, instruction);
 
     // Invalidate the JIT block so that it gets recompiled with the external exception check
     // included.
@@ -263,8 +312,17 @@ void CompileExceptionCheck(ExceptionType type)
   }
 }
 
+void LoadCachedExceptionChecks(u32 address)
+{
+  s_profile_cache.Load(
+      address, [address] { return PowerPC::HostRead_U32(address); },
+      [address](ExceptionType type) { GetExceptionAddresses(type)->insert(address); });
+}
+
 void Shutdown()
 {
+  s_profile_cache.Close();
+
   if (g_jit)
   {
     g_jit->Shutdown();
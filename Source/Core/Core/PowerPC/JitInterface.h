@@ -29,7 +29,8 @@ enum class ExceptionType
 {
   FIFOWrite,
   PairedQuantize,
-  SpeculativeConstants
+  SpeculativeConstants,
+  HotBlock
 };
 
 void DoState(PointerWrap& p);
@@ -47,6 +48,8 @@ enum class ProfilingState
 void SetProfilingState(ProfilingState state);
 void WriteProfileResults(const std::string& filename);
 void GetProfileResults(Profiler::ProfileStats* prof_stats);
+// Returns the total time spent compiling blocks, in microseconds. Can be called from any thread.
+u64 GetCompileTimeUs();
 int GetHostCode(u32* address, const u8** code, u32* code_size);
 
 // Memory Utilities
@@ -66,6 +69,10 @@ void InvalidateICache(u32 address, u32 size, bool forced);
 
 void CompileExceptionCheck(ExceptionType type);
 
+// Applies the exception checks a previous session of the same game recorded for the instruction
+// at address, if it is unchanged. Call before compiling a block containing it.
+void LoadCachedExceptionChecks(u32 address);
+
 /// used for the page fault unit test, don't use outside of tests!
 void SetJit(JitBase* jit);
 
@@ -4,9 +4,13 @@
 
 #include "Core/PowerPC/MMU.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstring>
 #include <string>
+#include <vector>
 
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
@@ -27,7 +31,6 @@
 
 namespace PowerPC
 {
-constexpr size_t HW_PAGE_SIZE = 4096;
 constexpr u32 HW_PAGE_INDEX_SHIFT = 12;
 constexpr u32 HW_PAGE_INDEX_MASK = 0x3f;
 
@@ -164,6 +167,26 @@ static void EFB_Write(u32 data, u32 addr)
 BatTable ibat_table;
 BatTable dbat_table;
 
+// Pages mapped into the logical fastmem arena by MapFastmemPage, grouped by the TLB entry that
+// translates them so that tlbie only has to drop the pages it invalidates.
+static std::array<std::vector<u32>, HW_PAGE_INDEX_MASK + 1> s_fastmem_pages;
+
+// A page that a JIT fault handler asked to have mapped, see RequestFastmemPage. Holds the page
+// address combined with the PENDING_PAGE_* flags, or 0.
+static std::atomic<u32> s_pending_fastmem_page;
+constexpr u32 PENDING_PAGE_VALID = 1;
+constexpr u32 PENDING_PAGE_WRITE = 2;
+
+static void MapPendingFastmemPage()
+{
+  if (s_pending_fastmem_page.load(std::memory_order_relaxed) == 0)
+    return;
+
+  const u32 pending = s_pending_fastmem_page.exchange(0, std::memory_order_relaxed);
+  if (pending != 0)
+    MapFastmemPage(pending & ~(HW_PAGE_SIZE - 1), (pending & PENDING_PAGE_WRITE) != 0);
+}
+
 static void GenerateDSIException(u32 effective_address, bool write);
 
 template <XCheckTLBFlag flag, typename T, bool never_translate = false>
@@ -171,6 +194,9 @@ static T ReadFromHardware(u32 em_address)
 {
   if (!never_translate && MSR.DR)
   {
+    if (flag == XCheckTLBFlag::Read)
+      MapPendingFastmemPage();
+
     auto translated_addr = TranslateAddress<flag>(em_address);
     if (!translated_addr.Success())
     {
@@ -259,6 +285,9 @@ static void WriteToHardware(u32 em_address, const T data)
 {
   if (!never_translate && MSR.DR)
   {
+    if (flag == XCheckTLBFlag::Write)
+      MapPendingFastmemPage();
+
     auto translated_addr = TranslateAddress<flag>(em_address);
     if (!translated_addr.Success())
     {
@@ -303,6 +332,7 @@ static void WriteToHardware(u32 em_address, const T data)
     // TODO: Only the first GetRamSizeReal() is supposed to be backed by actual memory.
     const T swapped_data = bswap(data);
     std::memcpy(&Memory::m_pRAM[em_address & Memory::GetRamMask()], &swapped_data, sizeof(T));
+    Memory::NotifyWrite(em_address & Memory::GetRamMask(), sizeof(T));
     return;
   }
 
@@ -311,6 +341,7 @@ static void WriteToHardware(u32 em_address, const T data)
   {
     const T swapped_data = bswap(data);
     std::memcpy(&Memory::m_pEXRAM[em_address & 0x0FFFFFFF], &swapped_data, sizeof(T));
+    Memory::NotifyWrite(em_address, sizeof(T));
     return;
   }
 
@@ -725,6 +756,7 @@ void DMA_LCToMemory(const u32 mem_address, const u32 cache_address, const u32 nu
     return;
 
   memcpy(dst, src, 32 * num_blocks);
+  Memory::NotifyWrite(mem_address, 32 * num_blocks);
 }
 
 void DMA_MemoryToLC(const u32 cache_address, const u32 mem_address, const u32 num_blocks)
@@ -969,6 +1001,8 @@ static void GenerateISIException(u32 effective_address)
 
 void SDRUpdated()
 {
+  UnmapFastmemPages();
+
   u32 htabmask = SDR1_HTABMASK(PowerPC::ppcState.spr[SPR_SDR]);
   if (!Common::IsValidLowMask(htabmask))
   {
@@ -1067,6 +1101,10 @@ void InvalidateTLBEntry(u32 address)
   TLBEntry& tlbe_i = ppcState.tlb[1][entry_index];
   tlbe_i.tag[0] = TLBEntry::INVALID_TAG;
   tlbe_i.tag[1] = TLBEntry::INVALID_TAG;
+
+  for (u32 page : s_fastmem_pages[entry_index])
+    Memory::UnmapLogicalPage(page);
+  s_fastmem_pages[entry_index].clear();
 }
 
 // Page Address Translation
@@ -1264,6 +1302,7 @@ void DBATUpdated()
     UpdateFakeMMUBat(dbat_table, 0x70000000);
   }
 
+  UnmapFastmemPages();
 #ifndef _ARCH_32
   Memory::UpdateLogicalMemory(dbat_table);
 #endif
@@ -1301,6 +1340,64 @@ static TranslateAddressResult TranslateAddress(u32 address)
   return TranslatePageAddress(address, flag);
 }
 
+// Whether the page table entry cached for address has its C (changed) bit set.
+static bool IsTLBPageChanged(u32 address)
+{
+  const u32 tag = address >> HW_PAGE_INDEX_SHIFT;
+  const TLBEntry& tlbe = ppcState.tlb[0][tag & HW_PAGE_INDEX_MASK];
+  for (size_t i = 0; i < TLB_WAYS; ++i)
+  {
+    if (tlbe.tag[i] == tag)
+    {
+      UPTE2 PTE2;
+      PTE2.Hex = tlbe.pte[i];
+      return PTE2.C != 0;
+    }
+  }
+  return false;
+}
+
+bool MapFastmemPage(u32 address, bool write)
+{
+  if (!SConfig::GetInstance().bMMU || !MSR.DR || PowerPC::memchecks.HasAny())
+    return false;
+
+  const TranslateAddressResult translated = write ?
+                                                TranslateAddress<XCheckTLBFlag::Write>(address) :
+                                                TranslateAddress<XCheckTLBFlag::Read>(address);
+  if (translated.result != TranslateAddressResult::PAGE_TABLE_TRANSLATED)
+    return false;
+
+  // Stores through the mapping can't set the C bit, so a page that is only being read is
+  // mapped write protected until the first store translates it for writing.
+  const bool writable = write || IsTLBPageChanged(address);
+  const u32 logical_page = address & ~(HW_PAGE_SIZE - 1);
+  const u32 physical_page = translated.address & ~(HW_PAGE_SIZE - 1);
+  if (!Memory::MapLogicalPage(logical_page, physical_page, writable))
+    return false;
+
+  std::vector<u32>& pages = s_fastmem_pages[(address >> HW_PAGE_INDEX_SHIFT) & HW_PAGE_INDEX_MASK];
+  if (std::find(pages.begin(), pages.end(), logical_page) == pages.end())
+    pages.push_back(logical_page);
+  return true;
+}
+
+void RequestFastmemPage(u32 address, bool write)
+{
+  u32 pending = (address & ~(HW_PAGE_SIZE - 1)) | PENDING_PAGE_VALID;
+  if (write)
+    pending |= PENDING_PAGE_WRITE;
+  s_pending_fastmem_page.store(pending, std::memory_order_relaxed);
+}
+
+void UnmapFastmemPages()
+{
+  s_pending_fastmem_page.store(0, std::memory_order_relaxed);
+  for (std::vector<u32>& pages : s_fastmem_pages)
+    pages.clear();
+  Memory::UnmapLogicalPages();
+}
+
 std::optional<u32> GetTranslatedAddress(u32 address)
 {
   auto result = TranslateAddress<XCheckTLBFlag::NoException>(address);
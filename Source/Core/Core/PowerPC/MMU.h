@@ -88,6 +88,16 @@ void InvalidateTLBEntry(u32 address);
 void DBATUpdated();
 void IBATUpdated();
 
+// Maps the page containing address into the logical fastmem arena if it is translated through
+// the page table, so that later fastmem accesses to it don't fault. Returns false if the page
+// can't be mapped.
+bool MapFastmemPage(u32 address, bool write);
+// Async-signal-safe version of MapFastmemPage for JIT fault handlers. The page is mapped by the
+// next slow path access of the CPU thread, which is usually the backpatched faulting access.
+void RequestFastmemPage(u32 address, bool write);
+// Drops all pages mapped by MapFastmemPage, e.g. when a segment register changes.
+void UnmapFastmemPages();
+
 // Result changes based on the BAT registers and MSR.DR.  Returns whether
 // it's safe to optimize a read or write to this address to an unguarded
 // memory access.  Does not consider page tables.
@@ -103,6 +113,8 @@ struct TranslateResult
 };
 TranslateResult JitCache_TranslateAddress(u32 address);
 
+constexpr u32 HW_PAGE_SIZE = 4096;
+
 constexpr int BAT_INDEX_SHIFT = 17;
 constexpr u32 BAT_PAGE_SIZE = 1 << BAT_INDEX_SHIFT;
 constexpr u32 BAT_MAPPED_BIT = 0x1;
@@ -17,6 +17,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 #include "Core/ConfigManager.h"
+#include "Core/HLE/HLE.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -40,6 +41,15 @@ namespace PPCAnalyst
 {
 // 0 does not perform block merging
 constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
+constexpr u32 EXTENDED_BRANCH_FOLLOWING_THRESHOLD = 6;
+
+// A conditional branch is traced through once it has run this many times and was taken in at
+// least HOT_BRANCH_TAKEN_PERCENT percent of them.
+constexpr u32 HOT_BRANCH_MIN_COUNT = 100;
+constexpr u32 HOT_BRANCH_TAKEN_PERCENT = 90;
+
+// How many instructions after a block exit are scanned for overwritten registers.
+constexpr u32 EXIT_LIVENESS_LOOKAHEAD = 32;
 
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
@@ -674,18 +684,148 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code, const Gekk
   }
 }
 
+// Scans the code starting at address, up to the next branch, and collects the GPRs and whether
+// the carry flag are written before being read. Their values at the end of the block are dead.
+// An interrupt can still be taken before the code at address runs, but the handler returns to
+// address, so the values it saves and restores are overwritten all the same.
+void PPCAnalyzer::FindDeadRegistersAtExit(CodeBlock* block, u32 address, BitSet32* gprs, bool* ca)
+{
+  // SetInstructionStats records register statistics, which must not count towards this block.
+  BlockRegStats gpa, fpa;
+  gpa.Clear();
+  fpa.Clear();
+  CodeBlock scratch;
+  scratch.m_gpa = &gpa;
+  scratch.m_fpa = &fpa;
+
+  BitSet32 read, written;
+  bool ca_read = false, ca_written = false;
+
+  for (u32 i = 0; i < EXIT_LIVENESS_LOOKAHEAD; ++i, address += 4)
+  {
+    // HLE functions can read any register.
+    if (HLE::GetFirstFunctionIndex(address) != 0)
+      break;
+
+    const PowerPC::TryReadInstResult result = PowerPC::TryReadInstruction(address);
+    if (!result.valid)
+      break;
+
+    const UGeckoInstruction inst = result.hex;
+    GekkoOPInfo* opinfo = PPCTables::GetOpInfo(inst);
+    if (opinfo->type == OpType::Invalid || opinfo->type == OpType::Unknown ||
+        (opinfo->flags & (FL_EVIL | FL_CHECKEXCEPTIONS)))
+    {
+      break;
+    }
+
+    // If this code changes, the block has to be recompiled along with it.
+    block->m_physical_addresses.insert(result.physical_address);
+
+    CodeOp op = {};
+    op.inst = inst;
+    op.opinfo = opinfo;
+    op.address = address;
+    SetInstructionStats(&scratch, &op, opinfo, i);
+
+    read |= op.regsIn & ~written;
+    written |= op.regsOut;
+    ca_read |= op.wantsCA && !ca_written;
+    ca_written |= op.outputCA;
+
+    if (opinfo->flags & FL_ENDBLOCK)
+      break;
+  }
+
+  *gprs = written & ~read;
+  *ca = ca_written && !ca_read;
+}
+
+bool PPCAnalyzer::IsHotBranch(u32 address) const
+{
+  if (!m_branch_profile)
+    return false;
+
+  const auto it = m_branch_profile->find(address);
+  if (it == m_branch_profile->end())
+    return false;
+
+  const u64 taken = it->second.taken;
+  const u64 total = taken + it->second.not_taken;
+  return total >= HOT_BRANCH_MIN_COUNT && taken * 100 >= total * HOT_BRANCH_TAKEN_PERCENT;
+}
+
+// Whether an instruction other than an integer op or a load may appear in a busy wait loop.
+// It must not have any visible side effects, and must not observe the passage of time, as
+// idle skipping fast-forwards to the next event.
+static bool IsBusyWaitSafeOp(const CodeOp& op)
+{
+  // CR logic and moves from the CR aren't allowed, since the register tracking below doesn't
+  // cover CR fields.
+  const UGeckoInstruction inst = op.inst;
+  if (inst.OPCD == 19)
+  {
+    // isync
+    return inst.SUBOP10 == 150;
+  }
+
+  if (inst.OPCD != 31)
+    return false;
+
+  switch (inst.SUBOP10)
+  {
+  case 83:   // mfmsr
+  case 598:  // sync
+  case 854:  // eieio
+  case 54:   // dcbst
+  case 86:   // dcbf
+  case 246:  // dcbtst
+  case 278:  // dcbt
+    return true;
+  case 339:  // mfspr
+  {
+    // The decrementer, time base and performance counters change while the loop spins.
+    const u32 index = (inst.SPRU << 5) | (inst.SPRL & 0x1F);
+    switch (index)
+    {
+    case SPR_DEC:
+    case SPR_TL:
+    case SPR_TU:
+    case SPR_PMC1:
+    case SPR_PMC2:
+    case SPR_PMC3:
+    case SPR_PMC4:
+    case SPR_UPMC1:
+    case SPR_UPMC2:
+    case SPR_UPMC3:
+    case SPR_UPMC4:
+      return false;
+    default:
+      return true;
+    }
+  }
+  default:
+    return false;
+  }
+}
+
 bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions)
 {
   // Very basic algorithm to detect busy wait loops:
-  //   * It loops to itself and does not contain any other branches.
-  //   * It does not write to memory.
+  //   * It loops to itself. Other branches may only leave the loop.
+  //   * It does not write to memory or to SPRs, so that polling MMIO or a RAM
+  //     word is its only effect. Memory barriers and cache hints, as commonly
+  //     found around such polls, are fine.
   //   * It only reads from registers it wrote to earlier in the loop, or it
   //     does not write to these registers.
   //
-  // Would benefit a lot from basic inlining support - a lot of the most
-  // used busy loops are DSP register interactions, which are bl/cmp/bne
-  // (with the bl target a pure function that follows the above rules). We
-  // don't detect these at the moment.
+  // Loops polling through a call (bl/cmp/bne with the bl target a pure
+  // function that follows the above rules) are detected when branch following
+  // inlines the call. Other calls end the block, so we can't see the loop.
+  //
+  // Memory polled by such a loop can only change through interrupts and DMA,
+  // which are all driven by CoreTiming events, so skipping to the next event
+  // doesn't change what the loop observes.
   std::bitset<32> write_disallowed_regs;
   std::bitset<32> written_regs;
   for (size_t i = 0; i <= instructions; ++i)
@@ -697,7 +837,8 @@ bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instruct
       if (code[i].branchTo == block->m_address && i == instructions)
         return true;
     }
-    else if (code[i].opinfo->type != OpType::Integer && code[i].opinfo->type != OpType::Load)
+    else if (code[i].opinfo->type != OpType::Integer && code[i].opinfo->type != OpType::Load &&
+             !IsBusyWaitSafeOp(code[i]))
     {
       // In the future, some subsets of other instruction types might get
       // supported. Right now, only try loops that have this very
@@ -758,6 +899,9 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
   u32 num_inst = 0;
 
   const bool enable_follow = SConfig::GetInstance().bJITFollowBranch;
+  const u32 follow_threshold = HasOption(OPTION_BRANCH_FOLLOW_EXTENDED) ?
+                                   EXTENDED_BRANCH_FOLLOWING_THRESHOLD :
+                                   BRANCH_FOLLOWING_THRESHOLD;
 
   for (std::size_t i = 0; i < block_size; ++i)
   {
@@ -818,7 +962,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
       {
         code[i].branchTo = code[caller].address + 4;
         if ((inst.BO & BO_DONT_DECREMENT_FLAG) && (inst.BO & BO_DONT_CHECK_CONDITION) &&
-            numFollows < BRANCH_FOLLOWING_THRESHOLD)
+            numFollows < follow_threshold)
         {
           // bclrx with unconditional branch = return
           // Follow it if we can propagate the LR value of the last CALL instruction.
@@ -853,7 +997,20 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
           ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0 || (inst.BO & BO_DONT_CHECK_CONDITION) == 0))
       {
         // bcx with conditional branch
-        conditional_continue = true;
+        if (enable_follow && HasOption(OPTION_TRACE_HOT_BRANCHES) && !inst.LK &&
+            numFollows < follow_threshold && code[i].branchTo != block->m_address &&
+            IsHotBranch(code[i].address))
+        {
+          // Continue the block on the usually taken path, the JIT emits a side exit for the
+          // other one.
+          code[i].branchFollowTaken = true;
+          follow = true;
+          found_call = false;
+        }
+        else
+        {
+          conditional_continue = true;
+        }
       }
       else if (inst.OPCD == 19 && inst.SUBOP10 == 16 &&
                ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0 ||
@@ -878,7 +1035,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
     code[i].branchIsIdleLoop =
         code[i].branchTo == block->m_address && IsBusyWaitLoop(block, code, i);
 
-    if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
+    if (follow && numFollows < follow_threshold)
     {
       // Follow the unconditional branch.
       numFollows++;
@@ -913,9 +1070,32 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
     block->m_broken = true;
   }
 
+  // Find out what the code at the final exit of the block overwrites. Only direct exits are
+  // considered: unconditional branches without LK, and falling through at the end of a broken
+  // block.
+  BitSet32 gprDeadAtExit;
+  bool caDeadAtExit = false;
+  bool exitAnalyzed = false;
+  if (HasOption(OPTION_EXIT_LIVENESS) && block->m_num_instructions > 0 &&
+      !SConfig::GetInstance().bEnableDebugging)
+  {
+    const CodeOp& last = code[block->m_num_instructions - 1];
+    if (block->m_broken)
+    {
+      FindDeadRegistersAtExit(block, address, &gprDeadAtExit, &caDeadAtExit);
+    }
+    else if (last.inst.OPCD == 18 && !last.inst.LK)
+    {
+      FindDeadRegistersAtExit(block, last.branchTo, &gprDeadAtExit, &caDeadAtExit);
+      exitAnalyzed = true;
+    }
+  }
+  block->m_gpr_dead_at_exit = gprDeadAtExit;
+
   // Scan for flag dependencies; assume the next block (or any branch that can leave the block)
-  // wants flags, to be safe.
-  bool wantsCR0 = true, wantsCR1 = true, wantsFPRF = true, wantsCA = true;
+  // wants flags, to be safe. The carry flag is the exception if the code after the final exit is
+  // known to overwrite it.
+  bool wantsCR0 = true, wantsCR1 = true, wantsFPRF = true, wantsCA = !caDeadAtExit;
   BitSet32 fprInUse, gprInUse, gprInReg, fprInXmm;
   for (int i = block->m_num_instructions - 1; i >= 0; i--)
   {
@@ -925,14 +1105,15 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
     const bool opWantsCR1 = op.wantsCR1;
     const bool opWantsFPRF = op.wantsFPRF;
     const bool opWantsCA = op.wantsCA;
+    const bool isFinalExit = exitAnalyzed && i == static_cast<int>(block->m_num_instructions) - 1;
     op.wantsCR0 = wantsCR0 || op.canEndBlock;
     op.wantsCR1 = wantsCR1 || op.canEndBlock;
     op.wantsFPRF = wantsFPRF || op.canEndBlock;
-    op.wantsCA = wantsCA || op.canEndBlock;
+    op.wantsCA = wantsCA || (op.canEndBlock && !isFinalExit);
     wantsCR0 |= opWantsCR0 || op.canEndBlock;
     wantsCR1 |= opWantsCR1 || op.canEndBlock;
     wantsFPRF |= opWantsFPRF || op.canEndBlock;
-    wantsCA |= opWantsCA || op.canEndBlock;
+    wantsCA |= opWantsCA || (op.canEndBlock && !isFinalExit);
     wantsCR0 &= !op.outputCR0 || opWantsCR0;
     wantsCR1 &= !op.outputCR1 || opWantsCR1;
     wantsFPRF &= !op.outputFPRF || opWantsFPRF;
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/BitSet.h"
@@ -35,6 +36,7 @@ struct CodeOp  // 16B
   bool isBranchTarget;
   bool branchUsesCtr;
   bool branchIsIdleLoop;
+  bool branchFollowTaken;  // conditional branch whose taken path continues the block
   bool wantsCR0;
   bool wantsCR1;
   bool wantsFPRF;
@@ -152,6 +154,10 @@ struct CodeBlock
   // Which GPRs this block reads from before defining, if any.
   BitSet32 m_gpr_inputs;
 
+  // Which GPRs the code after the final exit of this block overwrites before reading, if any.
+  // Only set with OPTION_EXIT_LIVENESS.
+  BitSet32 m_gpr_dead_at_exit;
+
   // Which memory locations are occupied by this block.
   std::set<u32> m_physical_addresses;
 };
@@ -195,12 +201,37 @@ public:
 
     // Reorder cror instructions next to their associated fcmp.
     OPTION_CROR_MERGE = (1 << 6),
+
+    // Follow more unconditional branches per block than usual, producing larger blocks.
+    // Only worth it for hot code, as it increases code size and invalidation costs.
+    // Requires OPTION_BRANCH_FOLLOW.
+    OPTION_BRANCH_FOLLOW_EXTENDED = (1 << 7),
+
+    // Follow the taken path of conditional branches that are hot according to the branch
+    // profile, forming a trace which is left through a side exit when the branch isn't taken.
+    // Requires JIT support (CodeOp::branchFollowTaken).
+    OPTION_TRACE_HOT_BRANCHES = (1 << 8),
+
+    // Look ahead at the code the block exits to, to find registers and the carry flag it
+    // overwrites before reading. The JIT can skip storing these when leaving the block.
+    // Requires JIT support (CodeBlock::m_gpr_dead_at_exit).
+    OPTION_EXIT_LIVENESS = (1 << 9),
   };
 
+  // How often a conditional branch went either way in its first-tier block.
+  struct BranchCounts
+  {
+    u32 taken;
+    u32 not_taken;
+  };
+  // Maps the address of a conditional branch to its counts.
+  using BranchProfile = std::unordered_map<u32, BranchCounts>;
+
   // Option setting/getting
   void SetOption(AnalystOption option) { m_options |= option; }
   void ClearOption(AnalystOption option) { m_options &= ~(option); }
   bool HasOption(AnalystOption option) const { return !!(m_options & option); }
+  void SetBranchProfile(const BranchProfile* profile) { m_branch_profile = profile; }
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size);
 
 private:
@@ -215,9 +246,13 @@ private:
   void ReorderInstructions(u32 instructions, CodeOp* code);
   void SetInstructionStats(CodeBlock* block, CodeOp* code, const GekkoOPInfo* opinfo, u32 index);
   bool IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions);
+  bool IsHotBranch(u32 address) const;
+  void FindDeadRegistersAtExit(CodeBlock* block, u32 address, BitSet32* gprs, bool* ca);
 
   // Options
   u32 m_options = 0;
+
+  const BranchProfile* m_branch_profile = nullptr;
 };
 
 void FindFunctions(u32 startAddr, u32 endAddr, PPCSymbolDB* func_db);
@@ -613,6 +613,7 @@ void PowerPCState::SetSR(u32 index, u32 value)
 {
   DEBUG_LOG(POWERPC, "%08x: MMU: Segment register %i set to %08x", pc, index, value);
   sr[index] = value;
+  UnmapFastmemPages();
 }
 
 // FPSCR update functions
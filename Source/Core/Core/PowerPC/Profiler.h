@@ -14,8 +14,9 @@ namespace Profiler
 {
 struct BlockStat
 {
-  BlockStat(u32 _addr, u64 c, u64 ticks, u64 run, u32 size)
-      : addr(_addr), cost(c), tick_counter(ticks), run_count(run), block_size(size)
+  BlockStat(u32 _addr, u64 c, u64 ticks, u64 run, u32 size, u32 eliminated)
+      : addr(_addr), cost(c), tick_counter(ticks), run_count(run), block_size(size),
+        eliminated_stores(eliminated)
   {
   }
   u32 addr;
@@ -23,6 +24,7 @@ struct BlockStat
   u64 tick_counter;
   u64 run_count;
   u32 block_size;
+  u32 eliminated_stores;
 
   bool operator<(const BlockStat& other) const { return cost > other.cost; }
 };
@@ -32,6 +34,8 @@ struct ProfileStats
   u64 cost_sum;
   u64 timecost_sum;
   u64 countsPerSec;
+  u64 tier_up_count;
+  u64 compile_ticks;
 };
 
 }  // namespace Profiler
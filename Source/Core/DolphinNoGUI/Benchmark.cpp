@@ -0,0 +1,194 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DolphinNoGUI/Benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <utility>
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+#include <fmt/format.h>
+
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Timer.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "VideoCommon/Statistics.h"
+
+// Returns the CPU time used by the calling thread.
+static u64 GetThreadTimeUs()
+{
+#ifdef _WIN32
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time))
+    return 0;
+
+  // FILETIMEs are in units of 100 nanoseconds.
+  const auto to_u64 = [](const FILETIME& time) {
+    return (u64(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+  };
+  return (to_u64(kernel_time) + to_u64(user_time)) / 10;
+#else
+  timespec time;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0)
+    return 0;
+  return u64(time.tv_sec) * 1000000 + time.tv_nsec / 1000;
+#endif
+}
+
+static double ToMilliseconds(u64 us)
+{
+  return us / 1000.0;
+}
+
+Benchmark::Benchmark(u32 num_frames, std::function<void()> on_finished)
+    : m_num_frames(num_frames), m_on_finished(std::move(on_finished))
+{
+  m_frames.reserve(num_frames);
+}
+
+void Benchmark::Start()
+{
+  Core::SetOnFramePresentedCallback([this] { OnFramePresented(); });
+  Core::SetOnNewFieldCallback([this] { OnNewField(); });
+}
+
+void Benchmark::Stop()
+{
+  Core::SetOnFramePresentedCallback(nullptr);
+  Core::SetOnNewFieldCallback(nullptr);
+}
+
+Benchmark::Counters Benchmark::GetCounters() const
+{
+  Counters counters;
+  counters.time_us = Common::Timer::GetTimeUs();
+  counters.cpu_thread_time_us = m_cpu_thread_time_us.load(std::memory_order_relaxed);
+  counters.gpu_thread_time_us = GetThreadTimeUs();
+  counters.jit_compile_time_us = JitInterface::GetCompileTimeUs();
+  counters.pixel_shaders_created = g_stats.num_pixel_shaders_created;
+  counters.vertex_shaders_created = g_stats.num_vertex_shaders_created;
+  counters.textures_created = g_stats.num_textures_created;
+  counters.textures_uploaded = g_stats.num_textures_uploaded;
+  return counters;
+}
+
+void Benchmark::OnNewField()
+{
+  m_cpu_thread_time_us.store(GetThreadTimeUs(), std::memory_order_relaxed);
+}
+
+void Benchmark::OnFramePresented()
+{
+  if (m_frames.size() >= m_num_frames)
+    return;
+
+  // The first frame only provides the starting point, so that booting isn't measured.
+  const Counters counters = GetCounters();
+  if (!m_started)
+  {
+    m_started = true;
+    m_last_counters = counters;
+    return;
+  }
+
+  Counters& frame = m_frames.emplace_back();
+  frame.time_us = counters.time_us - m_last_counters.time_us;
+  frame.cpu_thread_time_us = counters.cpu_thread_time_us - m_last_counters.cpu_thread_time_us;
+  frame.gpu_thread_time_us = counters.gpu_thread_time_us - m_last_counters.gpu_thread_time_us;
+  frame.jit_compile_time_us = counters.jit_compile_time_us - m_last_counters.jit_compile_time_us;
+  frame.pixel_shaders_created =
+      counters.pixel_shaders_created - m_last_counters.pixel_shaders_created;
+  frame.vertex_shaders_created =
+      counters.vertex_shaders_created - m_last_counters.vertex_shaders_created;
+  frame.textures_created = counters.textures_created - m_last_counters.textures_created;
+  frame.textures_uploaded = counters.textures_uploaded - m_last_counters.textures_uploaded;
+  m_last_counters = counters;
+
+  if (m_frames.size() == m_num_frames && m_on_finished)
+    m_on_finished();
+}
+
+bool Benchmark::WriteReport(const std::string& path) const
+{
+  Counters total{};
+  std::vector<u64> frame_times;
+  frame_times.reserve(m_frames.size());
+  for (const Counters& frame : m_frames)
+  {
+    total.time_us += frame.time_us;
+    total.cpu_thread_time_us += frame.cpu_thread_time_us;
+    total.gpu_thread_time_us += frame.gpu_thread_time_us;
+    total.jit_compile_time_us += frame.jit_compile_time_us;
+    total.pixel_shaders_created += frame.pixel_shaders_created;
+    total.vertex_shaders_created += frame.vertex_shaders_created;
+    total.textures_created += frame.textures_created;
+    total.textures_uploaded += frame.textures_uploaded;
+    frame_times.push_back(frame.time_us);
+  }
+
+  std::sort(frame_times.begin(), frame_times.end());
+  const auto percentile = [&frame_times](size_t percent) {
+    if (frame_times.empty())
+      return 0.0;
+    return ToMilliseconds(frame_times[(frame_times.size() - 1) * percent / 100]);
+  };
+  const double mean_frame_time =
+      m_frames.empty() ? 0.0 : ToMilliseconds(total.time_us) / m_frames.size();
+
+  std::string report = "{\n";
+  report += fmt::format("  \"video_backend\": \"{}\",\n", Config::Get(Config::MAIN_GFX_BACKEND));
+  report += fmt::format("  \"frames\": {},\n", m_frames.size());
+  report += fmt::format("  \"total_time_ms\": {:.3f},\n", ToMilliseconds(total.time_us));
+  report += fmt::format("  \"fps\": {:.3f},\n",
+                        total.time_us ? m_frames.size() * 1000000.0 / total.time_us : 0.0);
+  report += fmt::format("  \"frame_time_ms\": {{\"mean\": {:.3f}, \"median\": {:.3f}, "
+                        "\"p95\": {:.3f}, \"p99\": {:.3f}, \"max\": {:.3f}}},\n",
+                        mean_frame_time, percentile(50), percentile(95), percentile(99),
+                        percentile(100));
+  report += fmt::format("  \"cpu_thread_time_ms\": {:.3f},\n",
+                        ToMilliseconds(total.cpu_thread_time_us));
+  report += fmt::format("  \"gpu_thread_time_ms\": {:.3f},\n",
+                        ToMilliseconds(total.gpu_thread_time_us));
+  report += fmt::format("  \"jit_compile_time_ms\": {:.3f},\n",
+                        ToMilliseconds(total.jit_compile_time_us));
+  report += fmt::format("  \"pixel_shaders_created\": {},\n", total.pixel_shaders_created);
+  report += fmt::format("  \"vertex_shaders_created\": {},\n", total.vertex_shaders_created);
+  report += fmt::format("  \"textures_created\": {},\n", total.textures_created);
+  report += fmt::format("  \"textures_uploaded\": {},\n", total.textures_uploaded);
+  report += fmt::format("  \"textures_alive\": {},\n", g_stats.num_textures_alive);
+
+  report += "  \"per_frame\": [";
+  for (size_t i = 0; i < m_frames.size(); i++)
+  {
+    const Counters& frame = m_frames[i];
+    report += fmt::format(
+        "{}\n    {{\"time_us\": {}, \"cpu_thread_us\": {}, \"gpu_thread_us\": {}, "
+        "\"jit_compile_us\": {}, \"pixel_shaders\": {}, \"vertex_shaders\": {}, "
+        "\"textures_created\": {}, \"textures_uploaded\": {}}}",
+        i == 0 ? "" : ",", frame.time_us, frame.cpu_thread_time_us, frame.gpu_thread_time_us,
+        frame.jit_compile_time_us, frame.pixel_shaders_created, frame.vertex_shaders_created,
+        frame.textures_created, frame.textures_uploaded);
+  }
+  report += "\n  ]\n}\n";
+
+  if (path.empty())
+  {
+    std::fputs(report.c_str(), stdout);
+    return true;
+  }
+
+  if (!File::WriteStringToFile(path, report))
+  {
+    std::fprintf(stderr, "Failed to write the benchmark report to %s\n", path.c_str());
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,59 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Records performance counters for every presented frame while a game, FIFO log or movie is
+// running, and writes them as JSON so that runs can be compared automatically.
+class Benchmark
+{
+public:
+  // on_finished is called on the GPU thread once num_frames frames have been recorded.
+  Benchmark(u32 num_frames, std::function<void()> on_finished);
+
+  // Installs the frame callbacks in Core. Must be called before booting.
+  void Start();
+  // Removes the frame callbacks. Must be called after emulation has stopped.
+  void Stop();
+
+  // Writes the report to the given file, or to stdout if the path is empty.
+  bool WriteReport(const std::string& path) const;
+
+private:
+  struct Counters
+  {
+    u64 time_us;
+    u64 cpu_thread_time_us;
+    u64 gpu_thread_time_us;
+    u64 jit_compile_time_us;
+    int pixel_shaders_created;
+    int vertex_shaders_created;
+    int textures_created;
+    int textures_uploaded;
+  };
+
+  void OnFramePresented();
+  void OnNewField();
+  Counters GetCounters() const;
+
+  u32 m_num_frames;
+  std::function<void()> m_on_finished;
+
+  // Updated by the CPU thread at every field, since the CPU time of a thread can only be queried
+  // portably from the thread itself.
+  std::atomic<u64> m_cpu_thread_time_us{0};
+
+  // Only accessed by the GPU thread while emulation is running.
+  bool m_started = false;
+  Counters m_last_counters{};
+  // The difference of the counters to the previous frame, for each frame.
+  std::vector<Counters> m_frames;
+};
@@ -8,6 +8,7 @@
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <memory>
 #include <signal.h>
 #include <string>
 #ifndef _WIN32
@@ -16,12 +17,18 @@
 #include <Windows.h>
 #endif
 
+#include "Common/Config/Config.h"
 #include "Common/StringUtil.h"
+#include "Common/Trace.h"
 #include "Core/Analytics.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/Host.h"
+#include "Core/Movie.h"
+#include "DolphinNoGUI/Benchmark.h"
 
 #include "UICommon/CommandLineParse.h"
 #ifdef USE_DISCORD_PRESENCE
@@ -152,6 +159,20 @@ int main(int argc, char* argv[])
             "win32"
 #endif
       });
+  parser->add_option("--benchmark")
+      .action("store")
+      .type("int")
+      .metavar("<frames>")
+      .help("Run the given number of frames as fast as possible and report the performance. "
+            "Uses the Null video backend unless another one is specified");
+  parser->add_option("--benchmark_output")
+      .action("store")
+      .metavar("<file>")
+      .help("Write the benchmark report as JSON to the given file instead of stdout");
+  parser->add_option("--trace")
+      .action("store")
+      .metavar("<file>")
+      .help("Record a performance trace, and write it to the given file when emulation stops");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -216,6 +237,40 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  if (options.is_set("movie"))
+  {
+    if (!game_specified)
+    {
+      fprintf(stderr, "A movie cannot be played without specifying a game to launch.\n");
+      return 1;
+    }
+    if (!Movie::PlayInput(static_cast<const char*>(options.get("movie")), &boot->savestate_path))
+    {
+      fprintf(stderr, "Could not play the specified movie\n");
+      return 1;
+    }
+  }
+
+  std::unique_ptr<Benchmark> benchmark;
+  const float emulation_speed = SConfig::GetInstance().m_EmulationSpeed;
+  if (options.is_set("benchmark"))
+  {
+    const int num_frames = static_cast<int>(options.get("benchmark"));
+    if (num_frames <= 0)
+    {
+      fprintf(stderr, "The number of benchmark frames must be positive.\n");
+      return 1;
+    }
+
+    // Run unthrottled, and without rendering anything unless a backend was requested.
+    SConfig::GetInstance().m_EmulationSpeed = 0.0f;
+    if (!options.is_set_by_user("video_backend"))
+      Config::SetCurrent(Config::MAIN_GFX_BACKEND, std::string("Null"));
+
+    benchmark = std::make_unique<Benchmark>(num_frames, [] { s_platform->Stop(); });
+    benchmark->Start();
+  }
+
   Core::SetOnStateChangedCallback([](Core::State state) {
     if (state == Core::State::Uninitialized)
       s_platform->Stop();
@@ -236,6 +291,9 @@ int main(int argc, char* argv[])
 
   DolphinAnalytics::Instance().ReportDolphinStart("nogui");
 
+  if (options.is_set("trace"))
+    Common::Trace::SetEnabled(true);
+
   if (!BootManager::BootCore(std::move(boot), s_platform->GetWindowSystemInfo()))
   {
     fprintf(stderr, "Could not boot the specified file\n");
@@ -250,8 +308,27 @@ int main(int argc, char* argv[])
   Core::Stop();
 
   Core::Shutdown();
+
+  int result = 0;
+  if (options.is_set("trace"))
+  {
+    Common::Trace::SetEnabled(false);
+    if (!Common::Trace::ExportChromeTrace(static_cast<const char*>(options.get("trace"))))
+      result = 1;
+  }
+
+  if (benchmark)
+  {
+    benchmark->Stop();
+    if (!benchmark->WriteReport(static_cast<const char*>(options.get("benchmark_output"))))
+      result = 1;
+
+    // Don't save the unthrottled speed to the user's configuration.
+    SConfig::GetInstance().m_EmulationSpeed = emulation_speed;
+  }
+
   s_platform.reset();
   UICommon::Shutdown();
 
-  return 0;
+  return result;
 }
@@ -17,6 +17,7 @@
 #include "Common/CommonPaths.h"
 #include "Common/FileUtil.h"
 #include "Common/StringUtil.h"
+#include "Common/Trace.h"
 
 #include "Common/CDUtils.h"
 #include "Core/Boot/Boot.h"
@@ -830,6 +831,9 @@ void MenuBar::AddJITMenu()
       m_jit->addAction(tr("Log JIT Instruction Coverage"), this, &MenuBar::LogInstructions);
   m_jit_search_instruction =
       m_jit->addAction(tr("Search for an Instruction"), this, &MenuBar::SearchInstruction);
+  m_jit_record_trace = m_jit->addAction(tr("Record Performance Trace"));
+  m_jit_record_trace->setCheckable(true);
+  connect(m_jit_record_trace, &QAction::toggled, this, &MenuBar::RecordTrace);
 
   m_jit->addSeparator();
 
@@ -1569,6 +1573,32 @@ void MenuBar::LogInstructions()
   PPCTables::LogCompiledInstructions();
 }
 
+void MenuBar::RecordTrace(bool enabled)
+{
+  if (enabled)
+  {
+    Common::Trace::Clear();
+    Common::Trace::SetEnabled(true);
+    return;
+  }
+
+  Common::Trace::SetEnabled(false);
+  const std::string path = File::GetUserPath(D_DUMP_IDX) + "trace.json";
+  if (Common::Trace::ExportChromeTrace(path))
+  {
+    ModalMessageBox::information(
+        this, tr("Performance Trace"),
+        tr("Wrote the performance trace to %1. It can be opened in chrome://tracing.")
+            .arg(QString::fromStdString(path)));
+  }
+  else
+  {
+    ModalMessageBox::critical(this, tr("Performance Trace"),
+                              tr("Failed to write the performance trace to %1.")
+                                  .arg(QString::fromStdString(path)));
+  }
+}
+
 void MenuBar::SearchInstruction()
 {
   bool good;
@@ -169,6 +169,7 @@ private:
   void PatchHLEFunctions();
   void ClearCache();
   void LogInstructions();
+  void RecordTrace(bool enabled);
   void SearchInstruction();
 
   void OnSelectionChanged(std::shared_ptr<const UICommon::GameFile> game_file);
@@ -253,6 +254,7 @@ private:
   QAction* m_jit_clear_cache;
   QAction* m_jit_log_coverage;
   QAction* m_jit_search_instruction;
+  QAction* m_jit_record_trace;
   QAction* m_jit_off;
   QAction* m_jit_loadstore_off;
   QAction* m_jit_loadstore_lbzx_off;
@@ -472,6 +472,7 @@ void NetPlayDialog::OnStart()
   settings.m_JITFollowBranch = Config::Get(Config::MAIN_JIT_FOLLOW_BRANCH);
   settings.m_FastDiscSpeed = Config::Get(Config::MAIN_FAST_DISC_SPEED);
   settings.m_MMU = Config::Get(Config::MAIN_MMU);
+  settings.m_HLELibcFunctions = Config::Get(Config::MAIN_HLE_LIBC_FUNCTIONS);
   settings.m_Fastmem = Config::Get(Config::MAIN_FASTMEM);
   settings.m_SkipIPL = Config::Get(Config::MAIN_SKIP_IPL) ||
                        !Settings::Instance().GetNetPlayServer()->DoAllPlayersHaveIPLDump();
@@ -65,6 +65,23 @@ bool operator!=(const GameBanner& lhs, const GameBanner& rhs)
   return !operator==(lhs, rhs);
 }
 
+FileFingerprint FileFingerprint::FromPath(const std::string& path)
+{
+  const File::FileInfo info(path);
+  return {info.GetSize(), info.GetModificationTime(), info.GetInode()};
+}
+
+bool operator==(const FileFingerprint& lhs, const FileFingerprint& rhs)
+{
+  return std::tie(lhs.size, lhs.modification_time, lhs.inode) ==
+         std::tie(rhs.size, rhs.modification_time, rhs.inode);
+}
+
+bool operator!=(const FileFingerprint& lhs, const FileFingerprint& rhs)
+{
+  return !operator==(lhs, rhs);
+}
+
 const std::string& GameFile::Lookup(DiscIO::Language language,
                                     const std::map<DiscIO::Language, std::string>& strings)
 {
@@ -99,6 +116,7 @@ GameFile::GameFile() = default;
 GameFile::GameFile(std::string path) : m_file_path(std::move(path))
 {
   m_file_name = PathToFileName(m_file_path);
+  m_fingerprint = FileFingerprint::FromPath(m_file_path);
 
   {
     std::unique_ptr<DiscIO::Volume> volume(DiscIO::CreateVolume(m_file_path));
@@ -295,11 +313,19 @@ void GameCover::DoState(PointerWrap& p)
   p.Do(buffer);
 }
 
+void FileFingerprint::DoState(PointerWrap& p)
+{
+  p.Do(size);
+  p.Do(modification_time);
+  p.Do(inode);
+}
+
 void GameFile::DoState(PointerWrap& p)
 {
   p.Do(m_valid);
   p.Do(m_file_path);
   p.Do(m_file_name);
+  m_fingerprint.DoState(p);
 
   p.Do(m_file_size);
   p.Do(m_volume_size);
@@ -40,6 +40,21 @@ struct GameCover
 bool operator==(const GameBanner& lhs, const GameBanner& rhs);
 bool operator!=(const GameBanner& lhs, const GameBanner& rhs);
 
+// Identifies the state of a file on disk without opening it, so that cached metadata
+// can be reused for files that haven't changed since they were last scanned.
+struct FileFingerprint
+{
+  u64 size{};
+  s64 modification_time{};
+  u64 inode{};
+
+  static FileFingerprint FromPath(const std::string& path);
+  void DoState(PointerWrap& p);
+};
+
+bool operator==(const FileFingerprint& lhs, const FileFingerprint& rhs);
+bool operator!=(const FileFingerprint& lhs, const FileFingerprint& rhs);
+
 // This class caches the metadata of a DiscIO::Volume (or a DOL/ELF file).
 class GameFile final
 {
@@ -58,6 +73,7 @@ public:
   bool IsValid() const;
   const std::string& GetFilePath() const { return m_file_path; }
   const std::string& GetFileName() const { return m_file_name; }
+  const FileFingerprint& GetFingerprint() const { return m_fingerprint; }
   const std::string& GetName(const Core::TitleDatabase& title_database) const;
   const std::string& GetName(Variant variant) const;
   const std::string& GetMaker(Variant variant) const;
@@ -126,6 +142,7 @@ private:
   bool m_valid{};
   std::string m_file_path;
   std::string m_file_name;
+  FileFingerprint m_fingerprint{};
 
   u64 m_file_size{};
   u64 m_volume_size{};
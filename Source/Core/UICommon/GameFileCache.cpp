@@ -5,12 +5,14 @@
 #include "UICommon/GameFileCache.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -27,7 +29,36 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 18;  // Last changed in PR 8891
+static constexpr u32 CACHE_REVISION = 19;  // Last changed to save the file fingerprints
+
+// Calls func(i) for every i in [0, count) on a pool of worker threads. Opening a volume is
+// mostly spent waiting on I/O (especially on network storage), so scanning many files at once
+// is much faster than scanning them one by one.
+static void ParallelFor(size_t count, const std::function<void(size_t)>& func)
+{
+  const size_t thread_count =
+      std::min<size_t>(count, std::max<unsigned int>(1, std::thread::hardware_concurrency()));
+  if (thread_count <= 1)
+  {
+    for (size_t i = 0; i < count; ++i)
+      func(i);
+    return;
+  }
+
+  std::atomic<size_t> next_index{0};
+  const auto worker = [&] {
+    for (size_t i = next_index++; i < count; i = next_index++)
+      func(i);
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count - 1);
+  for (size_t i = 0; i < thread_count - 1; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (std::thread& thread : threads)
+    thread.join();
+}
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
@@ -73,15 +104,26 @@ std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
       m_cached_files.begin(), m_cached_files.end(),
       [&path](const std::shared_ptr<GameFile>& file) { return file->GetFilePath() == path; });
   const bool found = it != m_cached_files.cend();
-  if (!found)
+  const bool modified = found && (*it)->GetFingerprint() != FileFingerprint::FromPath(path);
+  if (!found || modified)
   {
     std::shared_ptr<UICommon::GameFile> game = std::make_shared<GameFile>(path);
     if (!game->IsValid())
+    {
+      if (modified)
+      {
+        m_cached_files.erase(it);
+        *cache_changed = true;
+      }
       return nullptr;
-    m_cached_files.emplace_back(std::move(game));
+    }
+    if (modified)
+      *it = std::move(game);
+    else
+      m_cached_files.emplace_back(std::move(game));
   }
   std::shared_ptr<GameFile>& result = found ? *it : m_cached_files.back();
-  if (UpdateAdditionalMetadata(&result) || !found)
+  if (UpdateAdditionalMetadata(&result) || !found || modified)
     *cache_changed = true;
 
   return result;
@@ -130,36 +172,74 @@ bool GameFileCache::Update(
     m_cached_files.erase(it, m_cached_files.end());
   }
 
-  // Now that the previous loop has run, game_paths only contains paths that
-  // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
+  // Files that are still present but have changed on disk since they were cached
+  // are dropped from m_cached_files and rescanned along with the new files below.
+  // Unchanged files are kept without being opened.
+  std::vector<std::string> paths_to_scan(game_paths.begin(), game_paths.end());
   {
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
+    std::vector<char> modified(m_cached_files.size());
+    ParallelFor(m_cached_files.size(), [&](size_t i) {
+      const std::shared_ptr<GameFile>& file = m_cached_files[i];
+      modified[i] = file->GetFingerprint() != FileFingerprint::FromPath(file->GetFilePath());
+    });
+
+    size_t kept = 0;
+    for (size_t i = 0; i < m_cached_files.size(); ++i)
     {
-      if (game_added_to_cache)
-        game_added_to_cache(file);
+      if (!modified[i])
+      {
+        m_cached_files[kept++] = std::move(m_cached_files[i]);
+        continue;
+      }
+
+      if (game_removed_from_cache)
+        game_removed_from_cache(m_cached_files[i]->GetFilePath());
 
       cache_changed = true;
-      m_cached_files.push_back(std::move(file));
+      paths_to_scan.push_back(m_cached_files[i]->GetFilePath());
     }
+    m_cached_files.erase(m_cached_files.begin() + kept, m_cached_files.end());
   }
 
+  // Now paths_to_scan only contains paths that aren't in m_cached_files,
+  // so we simply add all of them to m_cached_files.
+  std::mutex add_mutex;
+  ParallelFor(paths_to_scan.size(), [&](size_t i) {
+    auto file = std::make_shared<GameFile>(paths_to_scan[i]);
+    if (!file->IsValid())
+      return;
+
+    std::lock_guard lk(add_mutex);
+    if (game_added_to_cache)
+      game_added_to_cache(file);
+
+    cache_changed = true;
+    m_cached_files.push_back(std::move(file));
+  });
+
   return cache_changed;
 }
 
 bool GameFileCache::UpdateAdditionalMetadata(
     std::function<void(const std::shared_ptr<const GameFile>&)> game_updated)
 {
-  bool cache_changed = false;
+  std::atomic<bool> cache_changed{false};
+  std::mutex callback_mutex;
+
+  // Each worker only replaces its own element of m_cached_files, so no locking is needed
+  // except around the callback.
+  ParallelFor(m_cached_files.size(), [&](size_t i) {
+    std::shared_ptr<GameFile>& file = m_cached_files[i];
+    if (!UpdateAdditionalMetadata(&file))
+      return;
 
-  for (std::shared_ptr<GameFile>& file : m_cached_files)
-  {
-    const bool updated = UpdateAdditionalMetadata(&file);
-    cache_changed |= updated;
-    if (game_updated && updated)
+    cache_changed = true;
+    if (game_updated)
+    {
+      std::lock_guard lk(callback_mutex);
       game_updated(file);
-  }
+    }
+  });
 
   return cache_changed;
 }
@@ -42,6 +42,9 @@ public:
   std::shared_ptr<const GameFile> AddOrGet(const std::string& path, bool* cache_changed);
 
   // These functions return true if the call modified the cache.
+  // Files are scanned on multiple threads, and the callbacks may be called from any of them
+  // (but never concurrently). Cached files whose fingerprint still matches the file on disk
+  // are reused without being opened; modified files are removed and scanned again.
   bool Update(const std::vector<std::string>& all_game_paths,
               std::function<void(const std::shared_ptr<const GameFile>&)> game_added_to_cache = {},
               std::function<void(const std::string&)> game_removed_from_cache = {});
@@ -302,7 +302,7 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
           MMIO::DirectWrite<u16>(MMIO::Utils::HighPart(&fifo.CPReadPointer), WMASK_HI_RESTRICT));
 }
 
-void GatherPipeBursted()
+void GatherPipeBursted(u32 size)
 {
   SetCPStatusFromCPU();
 
@@ -323,11 +323,11 @@ void GatherPipeBursted()
     return;
   }
 
-  // update the fifo pointer
-  if (fifo.CPWritePointer == fifo.CPEnd)
+  // update the fifo pointer, GPFifo never writes past CPEnd before the last burst of a span
+  if (fifo.CPWritePointer + size - GATHER_PIPE_SIZE == fifo.CPEnd)
     fifo.CPWritePointer = fifo.CPBase;
   else
-    fifo.CPWritePointer += GATHER_PIPE_SIZE;
+    fifo.CPWritePointer += size;
 
   if (m_CPCtrlReg.GPReadEnable && m_CPCtrlReg.GPLinkEnable)
   {
@@ -340,7 +340,7 @@ void GatherPipeBursted()
   if (fifo.bFF_HiWatermark)
     CoreTiming::ForceExceptionCheck(0);
 
-  Common::AtomicAdd(fifo.CPReadWriteDistance, GATHER_PIPE_SIZE);
+  Common::AtomicAdd(fifo.CPReadWriteDistance, size);
 
   Fifo::RunGpu();
 
@@ -157,7 +157,8 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base);
 
 void SetCPStatusFromGPU();
 void SetCPStatusFromCPU();
-void GatherPipeBursted();
+// Called when size bytes (whole gather pipe bursts) have been written to the CPU FIFO.
+void GatherPipeBursted(u32 size);
 void UpdateInterrupts(u64 userdata);
 void UpdateInterruptsFromVideoBackend(u64 userdata);
 
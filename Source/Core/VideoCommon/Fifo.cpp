@@ -15,6 +15,7 @@
 #include "Common/FPURoundMode.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Trace.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
@@ -306,6 +307,8 @@ void RunGpuLoop()
         if (!s_emu_running_state.IsSet())
           return;
 
+        TRACE_SCOPE("Fifo::RunGpuLoop");
+
         if (s_use_deterministic_gpu_thread)
         {
           // All the fifo/CP stuff is on the CPU.  We just need to run the opcode decoder.
@@ -436,6 +439,7 @@ void RunGpu()
 
 static int RunGpuOnCpu(int ticks)
 {
+  TRACE_SCOPE("Fifo::RunGpuOnCpu");
   CommandProcessor::SCPFifoStruct& fifo = CommandProcessor::fifo;
   bool reset_simd_state = false;
   int available_ticks = int(ticks * SConfig::GetInstance().fSyncGpuOverclock) + s_sync_ticks.load();
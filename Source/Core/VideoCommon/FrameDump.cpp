@@ -6,8 +6,13 @@
 #define __STDC_CONSTANT_MACROS 1
 #endif
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -15,6 +20,7 @@ extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 #include <libavutil/mathematics.h>
+#include <libavutil/pixdesc.h>
 #include <libswscale/swscale.h>
 }
 
@@ -44,7 +50,6 @@ static AVCodecContext* s_codec_context = nullptr;
 static AVFrame* s_src_frame = nullptr;
 static AVFrame* s_scaled_frame = nullptr;
 static AVPixelFormat s_pix_fmt = AV_PIX_FMT_BGR24;
-static SwsContext* s_sws_context = nullptr;
 static int s_width;
 static int s_height;
 static u64 s_last_frame;
@@ -55,6 +60,23 @@ static int s_file_index = 0;
 static int s_savestate_index = 0;
 static int s_last_savestate_index = 0;
 
+// The colorspace conversion is split into horizontal bands, which are converted in parallel by
+// the dumping thread and a pool of conversion threads. Each band has its own scaler context, so
+// this is only done for pixel formats whose rows are converted independently. The chroma of
+// vertically subsampled formats like YUV420P is filtered across rows, and would differ at band
+// edges.
+constexpr int MAX_CONVERSION_BANDS = 8;
+constexpr int MIN_CONVERSION_BAND_HEIGHT = 64;
+static std::vector<SwsContext*> s_sws_contexts;
+static int s_conversion_band_height;
+static std::vector<std::thread> s_conversion_threads;
+static std::mutex s_conversion_lock;
+static std::condition_variable s_conversion_start;
+static std::condition_variable s_conversion_done;
+static u64 s_conversion_generation = 0;
+static int s_conversion_bands_remaining = 0;
+static bool s_conversion_shutdown = false;
+
 static void InitAVCodec()
 {
   static bool first_run = true;
@@ -80,6 +102,119 @@ static bool AVStreamCopyContext(AVStream* stream, AVCodecContext* codec_context)
 #endif
 }
 
+static void ConvertBand(int band)
+{
+  const int y = band * s_conversion_band_height;
+  const int band_height = std::min(s_conversion_band_height, s_height - y);
+  if (band_height <= 0)
+    return;
+
+  // Only formats without vertical chroma subsampling are split, so all planes have a row for
+  // every row of the frame unless y is 0.
+  const u8* src[4] = {s_src_frame->data[0] + y * s_src_frame->linesize[0]};
+  const int src_stride[4] = {s_src_frame->linesize[0]};
+  u8* dst[4] = {};
+  int dst_stride[4] = {};
+  for (int plane = 0; plane < 4 && s_scaled_frame->data[plane]; plane++)
+  {
+    dst[plane] = s_scaled_frame->data[plane] + y * s_scaled_frame->linesize[plane];
+    dst_stride[plane] = s_scaled_frame->linesize[plane];
+  }
+
+  s_sws_contexts[band] = sws_getCachedContext(
+      s_sws_contexts[band], s_width, band_height, s_pix_fmt, s_width, band_height,
+      s_codec_context->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
+  if (s_sws_contexts[band])
+    sws_scale(s_sws_contexts[band], src, src_stride, 0, band_height, dst, dst_stride);
+}
+
+static void ConversionThread(int band, u64 generation)
+{
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lk(s_conversion_lock);
+      s_conversion_start.wait(
+          lk, [&] { return s_conversion_shutdown || s_conversion_generation != generation; });
+      if (s_conversion_shutdown)
+        return;
+      generation = s_conversion_generation;
+    }
+
+    ConvertBand(band);
+
+    std::lock_guard<std::mutex> lk(s_conversion_lock);
+    if (--s_conversion_bands_remaining == 0)
+      s_conversion_done.notify_one();
+  }
+}
+
+static void StartConversionThreads()
+{
+  // Vertically subsampled formats are converted in a single band.
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(s_codec_context->pix_fmt);
+  const int max_bands =
+      desc->log2_chroma_h != 0 ?
+          1 :
+          std::min(MAX_CONVERSION_BANDS, std::max(s_height / MIN_CONVERSION_BAND_HEIGHT, 1));
+  const int num_bands =
+      std::clamp(static_cast<int>(std::thread::hardware_concurrency() / 2), 1, max_bands);
+  s_conversion_band_height = (s_height + num_bands - 1) / num_bands;
+
+  s_sws_contexts.resize(num_bands, nullptr);
+  s_conversion_shutdown = false;
+  for (int band = 1; band < num_bands; band++)
+    s_conversion_threads.emplace_back(ConversionThread, band, s_conversion_generation);
+}
+
+static void StopConversionThreads()
+{
+  {
+    std::lock_guard<std::mutex> lk(s_conversion_lock);
+    s_conversion_shutdown = true;
+  }
+  s_conversion_start.notify_all();
+  for (std::thread& thread : s_conversion_threads)
+    thread.join();
+  s_conversion_threads.clear();
+
+  for (SwsContext* context : s_sws_contexts)
+    sws_freeContext(context);
+  s_sws_contexts.clear();
+}
+
+static void ConvertFrame(int width, int height)
+{
+  if (s_sws_contexts.empty())
+    return;
+
+  // Only frames which don't have to be scaled can be converted in bands.
+  if (width != s_width || height != s_height)
+  {
+    s_sws_contexts[0] =
+        sws_getCachedContext(s_sws_contexts[0], width, height, s_pix_fmt, s_width, s_height,
+                             s_codec_context->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
+    if (s_sws_contexts[0])
+    {
+      sws_scale(s_sws_contexts[0], s_src_frame->data, s_src_frame->linesize, 0, height,
+                s_scaled_frame->data, s_scaled_frame->linesize);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(s_conversion_lock);
+    s_conversion_bands_remaining = static_cast<int>(s_conversion_threads.size());
+    s_conversion_generation++;
+  }
+  s_conversion_start.notify_all();
+
+  ConvertBand(0);
+
+  std::unique_lock<std::mutex> lk(s_conversion_lock);
+  s_conversion_done.wait(lk, [] { return s_conversion_bands_remaining == 0; });
+}
+
 bool FrameDump::Start(int w, int h)
 {
   s_pix_fmt = AV_PIX_FMT_RGBA;
@@ -198,7 +333,12 @@ bool FrameDump::CreateVideoFile()
   if (output_format->flags & AVFMT_GLOBALHEADER)
     s_codec_context->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
 
-  if (avcodec_open2(s_codec_context, codec, nullptr) < 0)
+  // Let the encoder use as many threads as it supports, so encoding keeps up at high resolutions.
+  AVDictionary* codec_options = nullptr;
+  av_dict_set(&codec_options, "threads", "auto", 0);
+  const int open_result = avcodec_open2(s_codec_context, codec, &codec_options);
+  av_dict_free(&codec_options);
+  if (open_result < 0)
   {
     ERROR_LOG(VIDEO, "Could not open codec");
     return false;
@@ -219,6 +359,8 @@ bool FrameDump::CreateVideoFile()
     return false;
 #endif
 
+  StartConversionThreads();
+
   s_stream = avformat_new_stream(s_format_context, codec);
   if (!s_stream || !AVStreamCopyContext(s_stream, s_codec_context))
   {
@@ -312,15 +454,17 @@ void FrameDump::AddFrame(const u8* data, int width, int height, int stride, cons
   s_src_frame->width = s_width;
   s_src_frame->height = s_height;
 
-  // Convert image from {BGR24, RGBA} to desired pixel format
-  s_sws_context =
-      sws_getCachedContext(s_sws_context, width, height, s_pix_fmt, s_width, s_height,
-                           s_codec_context->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
-  if (s_sws_context)
+  // The encoder can still hold a reference to the previous frame's buffers.
+#if LIBAVCODEC_VERSION_MAJOR >= 55
+  if (av_frame_make_writable(s_scaled_frame) < 0)
   {
-    sws_scale(s_sws_context, s_src_frame->data, s_src_frame->linesize, 0, height,
-              s_scaled_frame->data, s_scaled_frame->linesize);
+    ERROR_LOG(VIDEO, "Could not make the frame dump buffer writable");
+    return;
   }
+#endif
+
+  // Convert image from {BGR24, RGBA} to desired pixel format
+  ConvertFrame(width, height);
 
   // Encode and write the image.
   AVPacket pkt;
@@ -399,6 +543,8 @@ void FrameDump::Stop()
 
 void FrameDump::CloseVideoFile()
 {
+  StopConversionThreads();
+
   av_frame_free(&s_src_frame);
   av_frame_free(&s_scaled_frame);
 
@@ -410,12 +556,6 @@ void FrameDump::CloseVideoFile()
   }
   avformat_free_context(s_format_context);
   s_format_context = nullptr;
-
-  if (s_sws_context)
-  {
-    sws_freeContext(s_sws_context);
-    s_sws_context = nullptr;
-  }
 }
 
 void FrameDump::DoState()
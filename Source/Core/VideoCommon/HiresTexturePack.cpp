@@ -0,0 +1,312 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/HiresTexturePack.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <tuple>
+#include <utility>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <fmt/format.h>
+#include <xxhash.h>
+#include <zstd.h>
+
+#include "Common/Align.h"
+#include "Common/FileSearch.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+
+constexpr std::string_view s_format_prefix{"tex1_"};
+
+// Textures are far smaller than this. Anything bigger comes from a corrupted index.
+constexpr u64 MAX_TEXTURE_FILE_SIZE = 1024 * 1024 * 1024;
+
+static u64 HashName(std::string_view name)
+{
+  return XXH64(name.data(), name.size(), 0);
+}
+
+// Reads from a position without moving the file pointer, so it can be called from several
+// threads at once.
+static bool ReadAt(File::IOFile& file, u64 offset, u8* data, size_t size)
+{
+#ifdef _WIN32
+  const HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file.GetHandle())));
+  while (size > 0)
+  {
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD read_size;
+    if (!ReadFile(handle, data, static_cast<DWORD>(std::min<size_t>(size, 0x40000000)),
+                  &read_size, &overlapped) ||
+        read_size == 0)
+    {
+      return false;
+    }
+    offset += read_size;
+    data += read_size;
+    size -= read_size;
+  }
+#else
+  const int fd = fileno(file.GetHandle());
+  while (size > 0)
+  {
+    const ssize_t read_size = pread(fd, data, size, static_cast<off_t>(offset));
+    if (read_size <= 0)
+      return false;
+    offset += read_size;
+    data += read_size;
+    size -= read_size;
+  }
+#endif
+  return true;
+}
+
+HiresTexturePack::HiresTexturePack(std::string path) : m_path(std::move(path))
+{
+}
+
+std::vector<HiresTexturePack::TextureFile>
+HiresTexturePack::FindTextureFiles(const std::string& directory)
+{
+  std::vector<TextureFile> result;
+  const std::vector<std::string> extensions{".png", ".dds"};
+  for (const std::string& path : Common::DoFileSearch({directory}, extensions, /*recursive*/ true))
+  {
+    std::string filename;
+    std::string extension;
+    SplitPath(path, nullptr, &filename, &extension);
+
+    if (filename.substr(0, s_format_prefix.length()) != s_format_prefix)
+      continue;
+
+    const size_t arb_index = filename.rfind("_arb");
+    const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
+    if (has_arbitrary_mipmaps)
+      filename.erase(arb_index, 4);
+
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    result.push_back(TextureFile{std::move(filename), path, has_arbitrary_mipmaps,
+                                 extension == ".dds"});
+  }
+  return result;
+}
+
+std::unique_ptr<HiresTexturePack> HiresTexturePack::Open(const std::string& path)
+{
+  // Can't use make_unique due to private constructor.
+  std::unique_ptr<HiresTexturePack> pack(new HiresTexturePack(path));
+  if (!pack->m_file.Open(path, "rb"))
+    return nullptr;
+
+  const u64 file_size = pack->m_file.GetSize();
+  Header header;
+  if (!pack->m_file.ReadBytes(&header, sizeof(header)) || header.magic != MAGIC)
+  {
+    ERROR_LOG(VIDEO, "%s is not a custom texture pack", path.c_str());
+    return nullptr;
+  }
+  if (header.version != VERSION)
+  {
+    ERROR_LOG(VIDEO, "Custom texture pack %s has unsupported version %u", path.c_str(),
+              header.version);
+    return nullptr;
+  }
+  if (sizeof(Header) + u64(header.num_entries) * sizeof(Entry) + header.names_size > file_size)
+  {
+    ERROR_LOG(VIDEO, "Custom texture pack %s is truncated", path.c_str());
+    return nullptr;
+  }
+
+  pack->m_entries.resize(header.num_entries);
+  pack->m_names.resize(header.names_size);
+  if (!pack->m_file.ReadArray(pack->m_entries.data(), pack->m_entries.size()) ||
+      !pack->m_file.ReadBytes(pack->m_names.data(), pack->m_names.size()))
+  {
+    ERROR_LOG(VIDEO, "Failed to read the index of custom texture pack %s", path.c_str());
+    return nullptr;
+  }
+
+  const auto is_invalid = [&](const Entry& entry) {
+    return u64(entry.name_offset) + entry.name_length > header.names_size ||
+           entry.data_offset + entry.data_size > file_size ||
+           entry.compression > Compression::Zstd;
+  };
+  const auto by_hash = [](const Entry& a, const Entry& b) { return a.name_hash < b.name_hash; };
+  if (std::any_of(pack->m_entries.begin(), pack->m_entries.end(), is_invalid) ||
+      !std::is_sorted(pack->m_entries.begin(), pack->m_entries.end(), by_hash))
+  {
+    ERROR_LOG(VIDEO, "Custom texture pack %s has an invalid index", path.c_str());
+    return nullptr;
+  }
+
+  return pack;
+}
+
+bool HiresTexturePack::Create(const std::string& path, const std::vector<TextureFile>& files,
+                              int compression_level, std::string* error_message)
+{
+  const auto fail = [error_message](std::string message) {
+    ERROR_LOG(VIDEO, "%s", message.c_str());
+    *error_message = std::move(message);
+    return false;
+  };
+
+  // Sort by hash, and drop all but the first texture with the same name.
+  std::vector<std::pair<u64, const TextureFile*>> sorted_files;
+  sorted_files.reserve(files.size());
+  for (const TextureFile& file : files)
+    sorted_files.emplace_back(HashName(file.name), &file);
+  std::stable_sort(sorted_files.begin(), sorted_files.end(), [](const auto& a, const auto& b) {
+    return std::tie(a.first, a.second->name) < std::tie(b.first, b.second->name);
+  });
+  sorted_files.erase(std::unique(sorted_files.begin(), sorted_files.end(),
+                                 [](const auto& a, const auto& b) {
+                                   return a.first == b.first && a.second->name == b.second->name;
+                                 }),
+                     sorted_files.end());
+
+  std::vector<Entry> entries(sorted_files.size());
+  std::string names;
+  for (size_t i = 0; i < sorted_files.size(); i++)
+  {
+    const TextureFile& file = *sorted_files[i].second;
+    Entry& entry = entries[i];
+    entry.name_hash = sorted_files[i].first;
+    entry.name_offset = static_cast<u32>(names.size());
+    entry.name_length = static_cast<u16>(file.name.size());
+    entry.flags = (file.is_dds ? ENTRY_FLAG_DDS : 0) |
+                  (file.has_arbitrary_mipmaps ? ENTRY_FLAG_ARBITRARY_MIPMAPS : 0);
+    names += file.name;
+  }
+
+  File::IOFile out(path, "wb");
+  if (!out)
+    return fail(fmt::format("Failed to create custom texture pack {}", path));
+
+  // The index is written last, once the offsets of the textures are known.
+  const Header header{MAGIC, VERSION, static_cast<u32>(entries.size()),
+                      static_cast<u32>(names.size())};
+  const u64 names_offset = sizeof(Header) + entries.size() * sizeof(Entry);
+  u64 data_offset = Common::AlignUp(names_offset + names.size(), DATA_ALIGNMENT);
+
+  std::vector<u8> data;
+  std::vector<u8> compressed_data;
+  for (size_t i = 0; i < entries.size(); i++)
+  {
+    const TextureFile& file = *sorted_files[i].second;
+    Entry& entry = entries[i];
+
+    File::IOFile in(file.path, "rb");
+    const u64 file_size = in ? in.GetSize() : 0;
+    if (!in)
+      return fail(fmt::format("Failed to open {}", file.path));
+    if (file_size > MAX_TEXTURE_FILE_SIZE)
+      return fail(fmt::format("{} is too big for a custom texture", file.path));
+    data.resize(file_size);
+    if (!in.ReadBytes(data.data(), data.size()))
+      return fail(fmt::format("Failed to read {}", file.path));
+
+    entry.data_offset = data_offset;
+    entry.uncompressed_size = static_cast<u32>(data.size());
+    entry.compression = Compression::None;
+    const u8* stored_data = data.data();
+    size_t stored_size = data.size();
+    if (compression_level > 0)
+    {
+      compressed_data.resize(ZSTD_compressBound(data.size()));
+      const size_t compressed_size = ZSTD_compress(compressed_data.data(), compressed_data.size(),
+                                                   data.data(), data.size(), compression_level);
+      // PNG files are compressed already, so only keep the compressed data if it's smaller.
+      if (!ZSTD_isError(compressed_size) && compressed_size < data.size())
+      {
+        entry.compression = Compression::Zstd;
+        stored_data = compressed_data.data();
+        stored_size = compressed_size;
+      }
+    }
+    entry.data_size = static_cast<u32>(stored_size);
+
+    if (!out.Seek(data_offset, SEEK_SET) || !out.WriteBytes(stored_data, stored_size))
+      return fail(fmt::format("Failed to write {} to custom texture pack {}", file.path, path));
+    data_offset = Common::AlignUp(data_offset + stored_size, DATA_ALIGNMENT);
+  }
+
+  if (!out.Seek(0, SEEK_SET) || !out.WriteBytes(&header, sizeof(header)) ||
+      !out.WriteArray(entries.data(), entries.size()) ||
+      !out.WriteBytes(names.data(), names.size()))
+  {
+    return fail(fmt::format("Failed to write the index of custom texture pack {}", path));
+  }
+
+  return true;
+}
+
+std::string_view HiresTexturePack::GetName(const Entry& entry) const
+{
+  return std::string_view(m_names).substr(entry.name_offset, entry.name_length);
+}
+
+const HiresTexturePack::Entry* HiresTexturePack::Find(std::string_view name) const
+{
+  const u64 hash = HashName(name);
+  auto iter =
+      std::lower_bound(m_entries.begin(), m_entries.end(), hash,
+                       [](const Entry& entry, u64 value) { return entry.name_hash < value; });
+  for (; iter != m_entries.end() && iter->name_hash == hash; ++iter)
+  {
+    if (GetName(*iter) == name)
+      return &*iter;
+  }
+  return nullptr;
+}
+
+bool HiresTexturePack::ReadData(const Entry& entry, std::vector<u8>* data)
+{
+  std::vector<u8> stored_data(entry.data_size);
+  if (!ReadAt(m_file, entry.data_offset, stored_data.data(), stored_data.size()))
+  {
+    ERROR_LOG(VIDEO, "Failed to read %s from custom texture pack %s",
+              std::string(GetName(entry)).c_str(), m_path.c_str());
+    return false;
+  }
+
+  if (entry.compression == Compression::None)
+  {
+    *data = std::move(stored_data);
+    return true;
+  }
+
+  // The size is also stored in the zstd frame. Check that both agree before allocating, so that a
+  // corrupted entry can't make us allocate an arbitrary amount of memory.
+  const unsigned long long frame_size =
+      ZSTD_getFrameContentSize(stored_data.data(), stored_data.size());
+  if (frame_size != entry.uncompressed_size || frame_size > MAX_TEXTURE_FILE_SIZE)
+  {
+    ERROR_LOG(VIDEO, "Invalid size for %s in custom texture pack %s",
+              std::string(GetName(entry)).c_str(), m_path.c_str());
+    return false;
+  }
+
+  data->resize(entry.uncompressed_size);
+  const size_t size =
+      ZSTD_decompress(data->data(), data->size(), stored_data.data(), stored_data.size());
+  if (ZSTD_isError(size) || size != data->size())
+  {
+    ERROR_LOG(VIDEO, "Failed to decompress %s from custom texture pack %s",
+              std::string(GetName(entry)).c_str(), m_path.c_str());
+    return false;
+  }
+  return true;
+}
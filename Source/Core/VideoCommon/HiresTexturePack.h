@@ -0,0 +1,107 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+
+// A custom texture pack stored in a single file, so that it doesn't have to be indexed by scanning
+// a directory tree every time a game is started.
+//
+// The file starts with a header and an index of all textures, which is sorted by the XXH64 hash
+// of the texture names and followed by the names themselves. Opening a pack reads the index with
+// a single read, and looking up a texture is a binary search. The texture files are stored as they
+// are, so block-compressed DDS textures stay compressed, and can additionally be compressed with
+// zstd. Each texture starts at a 4 KiB boundary. All values are little-endian.
+class HiresTexturePack
+{
+public:
+  static constexpr std::string_view EXTENSION = ".dtp";
+
+  // A custom texture file found on disk.
+  struct TextureFile
+  {
+    // The file name without the extension and the "_arb" suffix.
+    std::string name;
+    std::string path;
+    bool has_arbitrary_mipmaps;
+    bool is_dds;
+  };
+
+  enum class Compression : u8
+  {
+    None = 0,
+    Zstd = 1,
+  };
+
+  enum EntryFlags : u8
+  {
+    ENTRY_FLAG_DDS = 1 << 0,
+    ENTRY_FLAG_ARBITRARY_MIPMAPS = 1 << 1,
+  };
+
+  struct Entry
+  {
+    u64 name_hash;
+    u64 data_offset;
+    u32 data_size;
+    u32 uncompressed_size;
+    u32 name_offset;
+    u16 name_length;
+    Compression compression;
+    u8 flags;
+  };
+  static_assert(sizeof(Entry) == 32);
+
+  // Finds the custom textures in a directory and its subdirectories.
+  static std::vector<TextureFile> FindTextureFiles(const std::string& directory);
+
+  static std::unique_ptr<HiresTexturePack> Open(const std::string& path);
+
+  // Writes the given textures to a new pack. If there are several textures with the same name,
+  // only the first one is stored. A compression level of 0 stores the textures uncompressed.
+  // On failure, error_message says which file couldn't be read or written.
+  static bool Create(const std::string& path, const std::vector<TextureFile>& files,
+                     int compression_level, std::string* error_message);
+
+  const std::string& GetPath() const { return m_path; }
+  const std::vector<Entry>& GetEntries() const { return m_entries; }
+  std::string_view GetName(const Entry& entry) const;
+
+  // Returns nullptr if the pack doesn't contain a texture with this name.
+  const Entry* Find(std::string_view name) const;
+
+  // Reads and decompresses a texture file. Can be called from multiple threads.
+  bool ReadData(const Entry& entry, std::vector<u8>* data);
+
+private:
+  struct Header
+  {
+    u32 magic;
+    u32 version;
+    u32 num_entries;
+    u32 names_size;
+  };
+  static_assert(sizeof(Header) == 16);
+
+  static constexpr u32 MAGIC = 0x50544444;  // "DDTP"
+  static constexpr u32 VERSION = 1;
+  static constexpr u64 DATA_ALIGNMENT = 4096;
+
+  explicit HiresTexturePack(std::string path);
+
+  std::string m_path;
+  std::vector<Entry> m_entries;
+  std::string m_names;
+
+  // Only used with positional reads after the index has been read, so that loader threads don't
+  // have to take turns.
+  File::IOFile m_file;
+};
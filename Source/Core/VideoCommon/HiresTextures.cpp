@@ -5,12 +5,17 @@
 #include "VideoCommon/HiresTextures.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <list>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <xxhash.h>
@@ -21,7 +26,6 @@
 #include "Common/File.h"
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
-#include "Common/Flag.h"
 #include "Common/Image.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
@@ -29,8 +33,8 @@
 #include "Common/Swap.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
-#include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
+#include "VideoCommon/HiresTexturePack.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -38,183 +42,420 @@ struct DiskTexture
 {
   std::string path;
   bool has_arbitrary_mipmaps;
+  bool is_dds;
+  // Set if the texture is stored in a texture pack rather than in a separate file.
+  HiresTexturePack* pack = nullptr;
+  const HiresTexturePack::Entry* pack_entry = nullptr;
+};
+
+// Loaded textures are kept in a cache that is limited to a byte budget, and the least recently
+// used ones are evicted when a texture that is needed now doesn't fit. Textures are loaded by a
+// pool of worker threads ahead of time where possible:
+// - The textures that were requested right after a texture are remembered, and when that texture
+//   is requested again, its successors are loaded in the background. Games tend to load their
+//   textures in the same order, so this hides most of the latency of loading on demand.
+// - With "Prefetch Custom Textures", the whole pack is queued at startup until the cache is full.
+// A texture that isn't cached when it is needed is still loaded on the GPU thread.
+struct CachedTexture
+{
+  std::shared_ptr<HiresTexture> texture;
+  size_t size;
+  std::list<std::string>::iterator lru_iter;
+};
+
+struct LoadRequest
+{
+  std::string base_filename;
+  bool prefetch;
 };
 
 constexpr std::string_view s_format_prefix{"tex1_"};
 
-static std::unordered_map<std::string, DiskTexture> s_textureMap;
-static std::unordered_map<std::string, std::shared_ptr<HiresTexture>> s_textureCache;
-static std::mutex s_textureCacheMutex;
-static Common::Flag s_textureCacheAbortLoading;
+// Number of successors that are remembered for each texture.
+constexpr size_t MAX_TEXTURE_SUCCESSORS = 4;
+// Maximum number of textures that are queued when a texture is requested.
+constexpr size_t MAX_LOOK_AHEAD = 16;
+constexpr unsigned int MAX_LOADER_THREADS = 8;
+// Cache budget used for streaming when the size isn't set and the whole pack isn't prefetched.
+constexpr size_t DEFAULT_CACHE_BUDGET = 256 * 1024 * 1024;
 
-static std::thread s_prefetcher;
+static std::unordered_map<std::string, DiskTexture> s_textureMap;
+static std::vector<std::unique_ptr<HiresTexturePack>> s_texturePacks;
 
-void HiresTexture::Init()
+// Everything below is protected by s_textureCacheMutex.
+static std::mutex s_textureCacheMutex;
+static std::unordered_map<std::string, CachedTexture> s_textureCache;
+// Most recently used first.
+static std::list<std::string> s_textureCacheLRU;
+static size_t s_textureCacheSize = 0;
+static size_t s_textureCacheBudget = 0;
+// Textures that are currently being loaded. s_textureLoaded is signalled when a load finishes.
+static std::unordered_set<std::string> s_texturesLoading;
+static std::condition_variable s_textureLoaded;
+
+// Look-ahead requests are put at the front of the queue, prefetch requests at the back.
+static std::deque<LoadRequest> s_loadQueue;
+static std::unordered_set<std::string> s_lookAheadQueued;
+static std::condition_variable s_loadQueueChanged;
+static std::vector<std::thread> s_loaderThreads;
+static bool s_loaderShutdown = false;
+
+static std::unordered_map<std::string, std::vector<std::string>> s_textureSuccessors;
+static std::string s_lastRequestedTexture;
+
+static size_t s_prefetchRemaining = 0;
+static u32 s_prefetchStartTime = 0;
+
+static bool HasTexture(const std::string& name)
 {
-  Update();
+  return s_textureMap.count(name) != 0 ||
+         std::any_of(s_texturePacks.begin(), s_texturePacks.end(),
+                     [&name](const auto& pack) { return pack->Find(name) != nullptr; });
 }
 
-void HiresTexture::Shutdown()
+// Textures in the texture directories take precedence over the ones in texture packs.
+static std::optional<DiskTexture> FindTexture(const std::string& name)
 {
-  if (s_prefetcher.joinable())
+  const auto iter = s_textureMap.find(name);
+  if (iter != s_textureMap.end())
+    return iter->second;
+
+  for (const auto& pack : s_texturePacks)
   {
-    s_textureCacheAbortLoading.Set();
-    s_prefetcher.join();
+    const HiresTexturePack::Entry* entry = pack->Find(name);
+    if (!entry)
+      continue;
+
+    return DiskTexture{fmt::format("{}:{}", pack->GetPath(), name),
+                       (entry->flags & HiresTexturePack::ENTRY_FLAG_ARBITRARY_MIPMAPS) != 0,
+                       (entry->flags & HiresTexturePack::ENTRY_FLAG_DDS) != 0, pack.get(), entry};
   }
 
-  s_textureMap.clear();
-  s_textureCache.clear();
+  return std::nullopt;
 }
 
-void HiresTexture::Update()
+static bool ReadTextureFile(const DiskTexture& texture, std::vector<u8>* data)
+{
+  if (texture.pack)
+    return texture.pack->ReadData(*texture.pack_entry, data);
+
+  File::IOFile file(texture.path, "rb");
+  data->resize(file.GetSize());
+  return file.ReadBytes(data->data(), data->size());
+}
+
+static size_t GetCacheBudget()
+{
+  if (g_ActiveConfig.iHiresTextureCacheSize > 0)
+    return size_t(g_ActiveConfig.iHiresTextureCacheSize) * 1024 * 1024;
+
+  if (!g_ActiveConfig.bCacheHiresTextures)
+    return DEFAULT_CACHE_BUDGET;
+
+  const size_t sys_mem = Common::MemPhysical();
+  const size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
+  // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
+  return (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+}
+
+static size_t GetTextureSize(const HiresTexture& texture)
+{
+  size_t size = 0;
+  for (const HiresTexture::Level& level : texture.m_levels)
+    size += level.data.size();
+  return size;
+}
+
+// s_textureCacheMutex must be held.
+static void EraseFromCache(std::unordered_map<std::string, CachedTexture>::iterator iter)
+{
+  s_textureCacheSize -= iter->second.size;
+  s_textureCacheLRU.erase(iter->second.lru_iter);
+  s_textureCache.erase(iter);
+}
+
+// s_textureCacheMutex must be held.
+static void EvictFromCache(size_t budget)
+{
+  while (s_textureCacheSize > budget && !s_textureCacheLRU.empty())
+    EraseFromCache(s_textureCache.find(s_textureCacheLRU.back()));
+}
+
+// Prefetched textures don't evict other textures, as those have actually been used. Returns false
+// if the texture didn't fit.
+// s_textureCacheMutex must be held.
+static bool InsertIntoCache(const std::string& base_filename,
+                            std::shared_ptr<HiresTexture> texture, bool evict)
+{
+  const size_t size = GetTextureSize(*texture);
+  if (evict)
+    EvictFromCache(s_textureCacheBudget - std::min(size, s_textureCacheBudget));
+  else if (s_textureCacheSize + size > s_textureCacheBudget)
+    return false;
+
+  s_textureCacheLRU.push_front(base_filename);
+  s_textureCache.emplace(base_filename,
+                         CachedTexture{std::move(texture), size, s_textureCacheLRU.begin()});
+  s_textureCacheSize += size;
+  return true;
+}
+
+// s_textureCacheMutex must be held.
+static void FinishPrefetch(bool cache_full)
 {
-  if (s_prefetcher.joinable())
+  if (cache_full)
   {
-    s_textureCacheAbortLoading.Set();
-    s_prefetcher.join();
+    s_loadQueue.erase(std::remove_if(s_loadQueue.begin(), s_loadQueue.end(),
+                                     [](const LoadRequest& request) { return request.prefetch; }),
+                      s_loadQueue.end());
+    OSD::AddMessage(fmt::format("Custom Textures prefetching stopped after {:.1f} MB, the "
+                                "texture cache is full",
+                                s_textureCacheSize / (1024.0 * 1024.0)),
+                    10000);
   }
-
-  if (!g_ActiveConfig.bHiresTextures)
+  else
   {
-    s_textureMap.clear();
-    s_textureCache.clear();
-    return;
+    const u32 stop_time = Common::Timer::GetTimeMs();
+    OSD::AddMessage(fmt::format("Custom Textures loaded, {:.1f} MB in {:.1f}s",
+                                s_textureCacheSize / (1024.0 * 1024.0),
+                                (stop_time - s_prefetchStartTime) / 1000.0),
+                    10000);
   }
+  s_prefetchRemaining = 0;
+}
 
-  if (!g_ActiveConfig.bCacheHiresTextures)
+// Remembers that base_filename was requested after the previous texture, and queues the
+// textures that followed base_filename the last times it was requested.
+// s_textureCacheMutex must be held.
+static void QueueLookAhead(const std::string& base_filename)
+{
+  if (!s_lastRequestedTexture.empty() && s_lastRequestedTexture != base_filename)
   {
-    s_textureCache.clear();
+    std::vector<std::string>& successors = s_textureSuccessors[s_lastRequestedTexture];
+    if (std::find(successors.begin(), successors.end(), base_filename) == successors.end())
+    {
+      if (successors.size() >= MAX_TEXTURE_SUCCESSORS)
+        successors.erase(successors.begin());
+      successors.push_back(base_filename);
+    }
   }
+  s_lastRequestedTexture = base_filename;
 
-  const std::string& game_id = SConfig::GetInstance().GetGameID();
-  const std::set<std::string> texture_directories = GetTextureDirectories(game_id);
-  const std::vector<std::string> extensions{".png", ".dds"};
+  if (s_loaderThreads.empty())
+    return;
 
-  for (const auto& texture_directory : texture_directories)
+  // Walk the successors breadth-first, so that the textures that are likely needed first end up
+  // at the front of the queue.
+  std::vector<const std::string*> look_ahead{&base_filename};
+  std::unordered_set<std::string_view> visited{base_filename};
+  for (size_t i = 0; i < look_ahead.size() && look_ahead.size() <= MAX_LOOK_AHEAD; i++)
   {
-    const auto texture_paths =
-        Common::DoFileSearch({texture_directory}, extensions, /*recursive*/ true);
+    const auto iter = s_textureSuccessors.find(*look_ahead[i]);
+    if (iter == s_textureSuccessors.end())
+      continue;
 
-    bool failed_insert = false;
-    for (auto& path : texture_paths)
+    for (const std::string& successor : iter->second)
     {
-      std::string filename;
-      SplitPath(path, nullptr, &filename, nullptr);
-
-      if (filename.substr(0, s_format_prefix.length()) == s_format_prefix)
-      {
-        const size_t arb_index = filename.rfind("_arb");
-        const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
-        if (has_arbitrary_mipmaps)
-          filename.erase(arb_index, 4);
-
-        const auto [it, inserted] =
-            s_textureMap.try_emplace(filename, DiskTexture{path, has_arbitrary_mipmaps});
-        if (!inserted)
-        {
-          failed_insert = true;
-        }
-      }
+      if (visited.insert(successor).second)
+        look_ahead.push_back(&successor);
     }
+  }
 
-    if (failed_insert)
+  bool queued = false;
+  for (auto iter = look_ahead.rbegin(); iter != look_ahead.rend() - 1; ++iter)
+  {
+    const std::string& name = **iter;
+    if (s_textureCache.count(name) || s_texturesLoading.count(name) ||
+        !s_lookAheadQueued.insert(name).second)
     {
-      ERROR_LOG(VIDEO, "One or more textures at path '%s' were already inserted",
-                texture_directory.c_str());
+      continue;
     }
+
+    s_loadQueue.push_front(LoadRequest{name, false});
+    queued = true;
   }
 
-  if (g_ActiveConfig.bCacheHiresTextures)
+  if (queued)
+    s_loadQueueChanged.notify_all();
+}
+
+void HiresTexture::LoaderThread()
+{
+  Common::SetCurrentThreadName("HiresTextureLoader");
+
+  std::unique_lock<std::mutex> lk(s_textureCacheMutex);
+  while (true)
   {
-    // remove cached but deleted textures
-    auto iter = s_textureCache.begin();
-    while (iter != s_textureCache.end())
+    s_loadQueueChanged.wait(lk, [] { return s_loaderShutdown || !s_loadQueue.empty(); });
+    if (s_loaderShutdown)
+      return;
+
+    const LoadRequest request = std::move(s_loadQueue.front());
+    s_loadQueue.pop_front();
+    if (!request.prefetch)
+      s_lookAheadQueued.erase(request.base_filename);
+
+    bool cache_full = request.prefetch && s_textureCacheSize >= s_textureCacheBudget;
+    if (!cache_full && !s_textureCache.count(request.base_filename) &&
+        s_texturesLoading.insert(request.base_filename).second)
     {
-      if (s_textureMap.find(iter->first) == s_textureMap.end())
-      {
-        iter = s_textureCache.erase(iter);
-      }
-      else
+      lk.unlock();
+      std::shared_ptr<HiresTexture> texture = Load(request.base_filename, 0, 0);
+      lk.lock();
+
+      s_texturesLoading.erase(request.base_filename);
+      if (texture && !s_loaderShutdown)
       {
-        iter++;
+        cache_full =
+            !InsertIntoCache(request.base_filename, std::move(texture), !request.prefetch);
       }
+      s_textureLoaded.notify_all();
     }
 
-    s_textureCacheAbortLoading.Clear();
-    s_prefetcher = std::thread(Prefetch);
+    if (request.prefetch && s_prefetchRemaining != 0 && (cache_full || --s_prefetchRemaining == 0))
+      FinishPrefetch(cache_full);
   }
 }
 
-void HiresTexture::Prefetch()
+static void StartLoaderThreads()
 {
-  Common::SetCurrentThreadName("Prefetcher");
+  const unsigned int num_threads =
+      std::clamp(std::thread::hardware_concurrency(), 2u, MAX_LOADER_THREADS + 1) - 1;
 
-  size_t size_sum = 0;
-  const size_t sys_mem = Common::MemPhysical();
-  const size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
-  // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
-  const size_t max_mem =
-      (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+  s_loaderShutdown = false;
+  for (unsigned int i = 0; i < num_threads; i++)
+    s_loaderThreads.emplace_back(HiresTexture::LoaderThread);
+}
 
-  const u32 start_time = Common::Timer::GetTimeMs();
-  for (const auto& entry : s_textureMap)
+static void StopLoaderThreads()
+{
   {
-    const std::string& base_filename = entry.first;
+    std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+    s_loaderShutdown = true;
+    s_loadQueue.clear();
+    s_lookAheadQueued.clear();
+    s_prefetchRemaining = 0;
+  }
+  s_loadQueueChanged.notify_all();
 
-    if (base_filename.find("_mip") == std::string::npos)
-    {
-      std::unique_lock<std::mutex> lk(s_textureCacheMutex);
+  for (std::thread& thread : s_loaderThreads)
+    thread.join();
+  s_loaderThreads.clear();
+}
 
-      auto iter = s_textureCache.find(base_filename);
-      if (iter == s_textureCache.end())
-      {
-        // unlock while loading a texture. This may result in a race condition where
-        // we'll load a texture twice, but it reduces the stuttering a lot.
-        lk.unlock();
-        std::unique_ptr<HiresTexture> texture = Load(base_filename, 0, 0);
-        lk.lock();
-        if (texture)
-        {
-          std::shared_ptr<HiresTexture> ptr(std::move(texture));
-          iter = s_textureCache.insert(iter, std::make_pair(base_filename, ptr));
-        }
-      }
-      if (iter != s_textureCache.end())
+static void ClearCache()
+{
+  s_textureCache.clear();
+  s_textureCacheLRU.clear();
+  s_textureCacheSize = 0;
+  s_textureSuccessors.clear();
+  s_lastRequestedTexture.clear();
+}
+
+void HiresTexture::Init()
+{
+  Update();
+}
+
+void HiresTexture::Shutdown()
+{
+  StopLoaderThreads();
+
+  s_textureMap.clear();
+  s_texturePacks.clear();
+  ClearCache();
+}
+
+void HiresTexture::Update()
+{
+  StopLoaderThreads();
+
+  s_textureMap.clear();
+  s_texturePacks.clear();
+
+  if (!g_ActiveConfig.bHiresTextures)
+  {
+    ClearCache();
+    return;
+  }
+
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  const std::string texture_pack_path = GetTexturePackPath(game_id);
+  if (!texture_pack_path.empty())
+  {
+    std::unique_ptr<HiresTexturePack> pack = HiresTexturePack::Open(texture_pack_path);
+    if (pack)
+      s_texturePacks.push_back(std::move(pack));
+  }
+
+  const std::set<std::string> texture_directories = GetTextureDirectories(game_id);
+  for (const auto& texture_directory : texture_directories)
+  {
+    bool failed_insert = false;
+    for (const auto& file : HiresTexturePack::FindTextureFiles(texture_directory))
+    {
+      const auto [it, inserted] = s_textureMap.try_emplace(
+          file.name, DiskTexture{file.path, file.has_arbitrary_mipmaps, file.is_dds});
+      if (!inserted)
       {
-        for (const Level& l : iter->second->m_levels)
-          size_sum += l.data.size();
+        failed_insert = true;
       }
     }
 
-    if (s_textureCacheAbortLoading.IsSet())
+    if (failed_insert)
     {
-      return;
+      ERROR_LOG(VIDEO, "One or more textures at path '%s' were already inserted",
+                texture_directory.c_str());
     }
+  }
 
-    if (size_sum > max_mem)
+  // remove cached but deleted textures
+  auto iter = s_textureCache.begin();
+  while (iter != s_textureCache.end())
+  {
+    if (!HasTexture(iter->first))
+    {
+      auto next = std::next(iter);
+      EraseFromCache(iter);
+      iter = next;
+    }
+    else
     {
-      Config::SetCurrent(Config::GFX_HIRES_TEXTURES, false);
+      iter++;
+    }
+  }
 
-      OSD::AddMessage(
-          fmt::format(
-              "Custom Textures prefetching after {:.1f} MB aborted, not enough RAM available",
-              size_sum / (1024.0 * 1024.0)),
-          10000);
-      return;
+  s_textureCacheBudget = GetCacheBudget();
+  EvictFromCache(s_textureCacheBudget);
+
+  if (g_ActiveConfig.bCacheHiresTextures)
+  {
+    for (const auto& entry : s_textureMap)
+    {
+      if (entry.first.find("_mip") == std::string::npos)
+        s_loadQueue.push_back(LoadRequest{entry.first, true});
+    }
+    for (const auto& pack : s_texturePacks)
+    {
+      for (const HiresTexturePack::Entry& entry : pack->GetEntries())
+      {
+        const std::string_view name = pack->GetName(entry);
+        if (name.find("_mip") == std::string_view::npos && !s_textureMap.count(std::string(name)))
+          s_loadQueue.push_back(LoadRequest{std::string(name), true});
+      }
     }
+    s_prefetchRemaining = s_loadQueue.size();
+    s_prefetchStartTime = Common::Timer::GetTimeMs();
   }
 
-  const u32 stop_time = Common::Timer::GetTimeMs();
-  OSD::AddMessage(fmt::format("Custom Textures loaded, {:.1f} MB in {:.1f}s",
-                              size_sum / (1024.0 * 1024.0), (stop_time - start_time) / 1000.0),
-                  10000);
+  StartLoaderThreads();
 }
 
 std::string HiresTexture::GenBaseName(const u8* texture, size_t texture_size, const u8* tlut,
                                       size_t tlut_size, u32 width, u32 height, TextureFormat format,
                                       bool has_mipmaps, bool dump)
 {
-  if (!dump && s_textureMap.empty())
+  if (!dump && s_textureMap.empty() && s_texturePacks.empty())
     return "";
 
   // checking for min/max on paletted textures
@@ -274,12 +515,12 @@ std::string HiresTexture::GenBaseName(const u8* texture, size_t texture_size, co
   if (!dump)
   {
     const std::string texture_name = fmt::format("{}_${}", base_name, format_name);
-    if (s_textureMap.find(texture_name) != s_textureMap.end())
+    if (HasTexture(texture_name))
       return texture_name;
   }
 
   // else generate the complete texture
-  if (dump || s_textureMap.find(full_name) != s_textureMap.end())
+  if (dump || HasTexture(full_name))
     return full_name;
 
   return "";
@@ -307,21 +548,39 @@ std::shared_ptr<HiresTexture> HiresTexture::Search(const u8* texture, size_t tex
 {
   std::string base_filename =
       GenBaseName(texture, texture_size, tlut, tlut_size, width, height, format, has_mipmaps);
+  if (base_filename.empty())
+    return nullptr;
+
+  std::unique_lock<std::mutex> lk(s_textureCacheMutex);
 
-  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  QueueLookAhead(base_filename);
 
-  auto iter = s_textureCache.find(base_filename);
-  if (iter != s_textureCache.end())
+  // If a loader thread is already working on this texture, wait for it instead of loading it twice.
+  while (true)
   {
-    return iter->second;
+    auto iter = s_textureCache.find(base_filename);
+    if (iter != s_textureCache.end())
+    {
+      s_textureCacheLRU.splice(s_textureCacheLRU.begin(), s_textureCacheLRU,
+                               iter->second.lru_iter);
+      return iter->second.texture;
+    }
+
+    if (!s_texturesLoading.count(base_filename))
+      break;
+
+    s_textureLoaded.wait(lk);
   }
 
+  s_texturesLoading.insert(base_filename);
+  lk.unlock();
   std::shared_ptr<HiresTexture> ptr(Load(base_filename, width, height));
+  lk.lock();
+  s_texturesLoading.erase(base_filename);
 
-  if (ptr && g_ActiveConfig.bCacheHiresTextures)
-  {
-    s_textureCache[base_filename] = ptr;
-  }
+  if (ptr)
+    InsertIntoCache(base_filename, ptr, true);
+  s_textureLoaded.notify_all();
 
   return ptr;
 }
@@ -330,17 +589,24 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
                                                  u32 height)
 {
   // We need to have a level 0 custom texture to even consider loading.
-  auto filename_iter = s_textureMap.find(base_filename);
-  if (filename_iter == s_textureMap.end())
+  const std::optional<DiskTexture> first_mip_file = FindTexture(base_filename);
+  if (!first_mip_file)
     return nullptr;
 
+  std::vector<u8> buffer;
+  if (!ReadTextureFile(*first_mip_file, &buffer))
+  {
+    ERROR_LOG(VIDEO, "Custom texture %s failed to load", first_mip_file->path.c_str());
+    return nullptr;
+  }
+
   // Try to load level 0 (and any mipmaps) from a DDS file.
   // If this fails, it's fine, we'll just load level0 again using SOIL.
   // Can't use make_unique due to private constructor.
   std::unique_ptr<HiresTexture> ret = std::unique_ptr<HiresTexture>(new HiresTexture());
-  const DiskTexture& first_mip_file = filename_iter->second;
-  ret->m_has_arbitrary_mipmaps = first_mip_file.has_arbitrary_mipmaps;
-  LoadDDSTexture(ret.get(), first_mip_file.path);
+  ret->m_has_arbitrary_mipmaps = first_mip_file->has_arbitrary_mipmaps;
+  if (first_mip_file->is_dds)
+    LoadDDSTexture(ret.get(), buffer, first_mip_file->path);
 
   // Load remaining mip levels, or from the start if it's not a DDS texture.
   for (u32 mip_level = static_cast<u32>(ret->m_levels.size());; mip_level++)
@@ -349,20 +615,21 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
     if (mip_level != 0)
       filename += fmt::format("_mip{}", mip_level);
 
-    filename_iter = s_textureMap.find(filename);
-    if (filename_iter == s_textureMap.end())
+    const std::optional<DiskTexture> file = FindTexture(filename);
+    if (!file)
       break;
 
+    // The first level has been read already.
+    if (mip_level != 0 && !ReadTextureFile(*file, &buffer))
+    {
+      ERROR_LOG(VIDEO, "Custom texture %s failed to load", filename.c_str());
+      break;
+    }
+
     // Try loading DDS textures first, that way we maintain compression of DXT formats.
-    // TODO: Reduce the number of open() calls here. We could use one fd.
     Level level;
-    if (!LoadDDSTexture(level, filename_iter->second.path, mip_level))
+    if (!file->is_dds || !LoadDDSTexture(level, buffer, file->path, mip_level))
     {
-      File::IOFile file;
-      file.Open(filename_iter->second.path, "rb");
-      std::vector<u8> buffer(file.GetSize());
-      file.ReadBytes(buffer.data(), file.GetSize());
-
       if (!LoadTexture(level, buffer))
       {
         ERROR_LOG(VIDEO, "Custom texture %s failed to load", filename.c_str());
@@ -384,7 +651,7 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
     ERROR_LOG(VIDEO,
               "Invalid custom texture size %ux%u for texture %s. The aspect differs "
               "from the native size %ux%u.",
-              first_mip.width, first_mip.height, first_mip_file.path.c_str(), width, height);
+              first_mip.width, first_mip.height, first_mip_file->path.c_str(), width, height);
   }
 
   // Same deal if the custom texture isn't a multiple of the native size.
@@ -393,7 +660,7 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
     ERROR_LOG(VIDEO,
               "Invalid custom texture size %ux%u for texture %s. Please use an integer "
               "upscaling factor based on the native size %ux%u.",
-              first_mip.width, first_mip.height, first_mip_file.path.c_str(), width, height);
+              first_mip.width, first_mip.height, first_mip_file->path.c_str(), width, height);
   }
 
   // Verify that each mip level is the correct size (divide by 2 each time).
@@ -412,14 +679,14 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
 
       ERROR_LOG(VIDEO,
                 "Invalid custom texture size %dx%d for texture %s. Mipmap level %u must be %dx%d.",
-                level.width, level.height, first_mip_file.path.c_str(), mip_level,
+                level.width, level.height, first_mip_file->path.c_str(), mip_level,
                 current_mip_width, current_mip_height);
     }
     else
     {
       // It is invalid to have more than a single 1x1 mipmap.
       ERROR_LOG(VIDEO, "Custom texture %s has too many 1x1 mipmaps. Skipping extra levels.",
-                first_mip_file.path.c_str());
+                first_mip_file->path.c_str());
     }
 
     // Drop this mip level and any others after it.
@@ -432,7 +699,7 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
                   [&ret](const Level& l) { return l.format != ret->m_levels[0].format; }))
   {
     ERROR_LOG(VIDEO, "Custom texture %s has inconsistent formats across mip levels.",
-              first_mip_file.path.c_str());
+              first_mip_file->path.c_str());
 
     return nullptr;
   }
@@ -454,6 +721,20 @@ bool HiresTexture::LoadTexture(Level& level, const std::vector<u8>& buffer)
   return true;
 }
 
+std::string HiresTexture::GetTexturePackPath(const std::string& game_id)
+{
+  // Like texture directories, texture packs are named after the game ID or the region-free ID.
+  const std::string root_directory = File::GetUserPath(D_HIRESTEXTURES_IDX);
+  for (const std::string& id : {game_id, game_id.substr(0, 3)})
+  {
+    const std::string path = root_directory + id + std::string(HiresTexturePack::EXTENSION);
+    if (File::Exists(path))
+      return path;
+  }
+
+  return "";
+}
+
 std::set<std::string> HiresTexture::GetTextureDirectories(const std::string& game_id)
 {
   std::set<std::string> result;
@@ -31,6 +31,9 @@ public:
 
   static u32 CalculateMipCount(u32 width, u32 height);
 
+  // Body of the threads that load textures in the background.
+  static void LoaderThread();
+
   ~HiresTexture();
 
   AbstractTextureFormat GetFormat() const;
@@ -49,11 +52,13 @@ public:
 private:
   static std::unique_ptr<HiresTexture> Load(const std::string& base_filename, u32 width,
                                             u32 height);
-  static bool LoadDDSTexture(HiresTexture* tex, const std::string& filename);
-  static bool LoadDDSTexture(Level& level, const std::string& filename, u32 mip_level);
+  static bool LoadDDSTexture(HiresTexture* tex, const std::vector<u8>& buffer,
+                             const std::string& filename);
+  static bool LoadDDSTexture(Level& level, const std::vector<u8>& buffer,
+                             const std::string& filename, u32 mip_level);
   static bool LoadTexture(Level& level, const std::vector<u8>& buffer);
-  static void Prefetch();
 
+  static std::string GetTexturePackPath(const std::string& game_id);
   static std::set<std::string> GetTextureDirectories(const std::string& game_id);
 
   HiresTexture() {}
@@ -11,7 +11,6 @@
 #include <functional>
 
 #include "Common/Align.h"
-#include "Common/File.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
 #include "VideoCommon/VideoConfig.h"
@@ -228,17 +227,48 @@ void ConvertTexture_R8G8B8(HiresTexture::Level* level)
   level->data = std::move(new_data);
 }
 
-bool ParseDDSHeader(File::IOFile& file, DDSLoadInfo* info)
+// Reads from a DDS file that has been loaded into memory.
+class DDSReader
 {
-  // Exit as early as possible for non-DDS textures, since all extensions are currently
-  // passed through this function.
+public:
+  explicit DDSReader(const std::vector<u8>& buffer) : m_buffer(buffer) {}
+
+  bool ReadBytes(void* data, size_t length)
+  {
+    if (length > m_buffer.size() - m_position)
+      return false;
+
+    std::memcpy(data, m_buffer.data() + m_position, length);
+    m_position += length;
+    return true;
+  }
+
+  bool Seek(size_t position)
+  {
+    if (position > m_buffer.size())
+      return false;
+
+    m_position = position;
+    return true;
+  }
+
+  size_t GetSize() const { return m_buffer.size(); }
+
+private:
+  const std::vector<u8>& m_buffer;
+  size_t m_position = 0;
+};
+
+bool ParseDDSHeader(DDSReader& reader, DDSLoadInfo* info)
+{
+  // Exit as early as possible for files that only have a .dds extension.
   u32 magic;
-  if (!file.ReadBytes(&magic, sizeof(magic)) || magic != DDS_MAGIC)
+  if (!reader.ReadBytes(&magic, sizeof(magic)) || magic != DDS_MAGIC)
     return false;
 
   DDS_HEADER header;
   size_t header_size = sizeof(header);
-  if (!file.ReadBytes(&header, header_size) || header.dwSize < header_size)
+  if (!reader.ReadBytes(&header, header_size) || header.dwSize < header_size)
     return false;
 
   // Required fields.
@@ -279,7 +309,7 @@ bool ParseDDSHeader(File::IOFile& file, DDSLoadInfo* info)
     if (header.ddspf.dwFourCC == MAKEFOURCC('D', 'X', '1', '0'))
     {
       DDS_HEADER_DXT10 dxt10_header;
-      if (!file.ReadBytes(&dxt10_header, sizeof(dxt10_header)))
+      if (!reader.ReadBytes(&dxt10_header, sizeof(dxt10_header)))
         return false;
 
       // Can't handle array textures here. Doesn't make sense to use them, anyway.
@@ -395,13 +425,13 @@ bool ParseDDSHeader(File::IOFile& file, DDSLoadInfo* info)
 
   // Check for truncated or corrupted files.
   info->first_mip_offset = sizeof(magic) + header_size;
-  if (info->first_mip_offset >= file.GetSize())
+  if (info->first_mip_offset >= reader.GetSize())
     return false;
 
   return true;
 }
 
-bool ReadMipLevel(HiresTexture::Level* level, File::IOFile& file, const std::string& filename,
+bool ReadMipLevel(HiresTexture::Level* level, DDSReader& reader, const std::string& filename,
                   u32 mip_level, const DDSLoadInfo& info, u32 width, u32 height, u32 row_length,
                   size_t size)
 {
@@ -423,7 +453,7 @@ bool ReadMipLevel(HiresTexture::Level* level, File::IOFile& file, const std::str
   level->format = info.format;
   level->row_length = row_length;
   level->data.resize(size);
-  if (!file.ReadBytes(level->data.data(), level->data.size()))
+  if (!reader.ReadBytes(level->data.data(), level->data.size()))
     return false;
 
   // Apply conversion function for uncompressed textures.
@@ -435,21 +465,18 @@ bool ReadMipLevel(HiresTexture::Level* level, File::IOFile& file, const std::str
 
 }  // namespace
 
-bool HiresTexture::LoadDDSTexture(HiresTexture* tex, const std::string& filename)
+bool HiresTexture::LoadDDSTexture(HiresTexture* tex, const std::vector<u8>& buffer,
+                                  const std::string& filename)
 {
-  File::IOFile file;
-  file.Open(filename, "rb");
-  if (!file.IsOpen())
-    return false;
-
+  DDSReader reader(buffer);
   DDSLoadInfo info;
-  if (!ParseDDSHeader(file, &info))
+  if (!ParseDDSHeader(reader, &info))
     return false;
 
   // Read first mip level, as it may have a custom pitch.
   Level first_level;
-  if (!file.Seek(info.first_mip_offset, SEEK_SET) ||
-      !ReadMipLevel(&first_level, file, filename, 0, info, info.width, info.height,
+  if (!reader.Seek(info.first_mip_offset) ||
+      !ReadMipLevel(&first_level, reader, filename, 0, info, info.width, info.height,
                     info.first_mip_row_length, info.first_mip_size))
   {
     return false;
@@ -472,7 +499,7 @@ bool HiresTexture::LoadDDSTexture(HiresTexture* tex, const std::string& filename
     u32 mip_row_length = blocks_wide * info.block_size;
     size_t mip_size = blocks_wide * static_cast<size_t>(info.bytes_per_block) * blocks_high;
     Level level;
-    if (!ReadMipLevel(&level, file, filename, i, info, mip_width, mip_height, mip_row_length,
+    if (!ReadMipLevel(&level, reader, filename, i, info, mip_width, mip_height, mip_row_length,
                       mip_size))
       break;
 
@@ -482,18 +509,15 @@ bool HiresTexture::LoadDDSTexture(HiresTexture* tex, const std::string& filename
   return true;
 }
 
-bool HiresTexture::LoadDDSTexture(Level& level, const std::string& filename, u32 mip_level)
+bool HiresTexture::LoadDDSTexture(Level& level, const std::vector<u8>& buffer,
+                                  const std::string& filename, u32 mip_level)
 {
   // Only loading a single mip level.
-  File::IOFile file;
-  file.Open(filename, "rb");
-  if (!file.IsOpen())
-    return false;
-
+  DDSReader reader(buffer);
   DDSLoadInfo info;
-  if (!ParseDDSHeader(file, &info))
+  if (!ParseDDSHeader(reader, &info))
     return false;
 
-  return ReadMipLevel(&level, file, filename, mip_level, info, info.width, info.height,
+  return ReadMipLevel(&level, reader, filename, mip_level, info, info.width, info.height,
                       info.first_mip_row_length, info.first_mip_size);
 }
@@ -38,6 +38,7 @@
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/Trace.h"
 
 #include "Core/Analytics.h"
 #include "Core/Config/NetplaySettings.h"
@@ -1202,6 +1203,8 @@ void Renderer::UpdateWidescreenHeuristic()
 
 void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u64 ticks)
 {
+  TRACE_SCOPE("Renderer::Swap");
+
   if (SConfig::GetInstance().bWii)
     m_is_game_widescreen = Config::Get(Config::SYSCONF_WIDESCREEN);
 
@@ -1405,15 +1408,11 @@ void Renderer::DumpCurrentFrame(const AbstractTexture* src_texture,
     copy_rect = src_texture->GetRect();
   }
 
-  // Index 0 was just sent to FFMPEG dump. Swap with the second texture.
-  if (m_frame_dump_readback_textures[0])
-    std::swap(m_frame_dump_readback_textures[0], m_frame_dump_readback_textures[1]);
-
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
+  std::unique_ptr<AbstractStagingTexture>& rbtex = GetFrameDumpReadbackTexture();
+  if (!CheckFrameDumpReadbackTexture(rbtex, target_width, target_height))
     return;
 
-  m_frame_dump_readback_textures[0]->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                     m_frame_dump_readback_textures[0]->GetRect());
+  rbtex->CopyFromTexture(src_texture, copy_rect, 0, 0, rbtex->GetRect());
   m_last_frame_state = FrameDump::FetchState(ticks);
   m_last_frame_exported = true;
 }
@@ -1444,9 +1443,9 @@ bool Renderer::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
   return true;
 }
 
-bool Renderer::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
+bool Renderer::CheckFrameDumpReadbackTexture(std::unique_ptr<AbstractStagingTexture>& rbtex,
+                                             u32 target_width, u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_textures[0];
   if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
     return true;
 
@@ -1460,16 +1459,31 @@ bool Renderer::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height
   return true;
 }
 
+std::unique_ptr<AbstractStagingTexture>& Renderer::GetFrameDumpReadbackTexture()
+{
+  // The texture of the frame that was queued a whole ring ago may still be read by the encoder.
+  std::unique_lock<std::mutex> lk(m_frame_dump_lock);
+  if (m_frame_dump_frames_queued - m_frame_dump_frames_done >= FRAME_DUMP_READBACK_TEXTURES)
+  {
+    const u64 start_time = Common::Timer::GetTimeUs();
+    m_frame_dump_cv.wait(lk, [this] {
+      return m_frame_dump_frames_queued - m_frame_dump_frames_done < FRAME_DUMP_READBACK_TEXTURES;
+    });
+    m_frame_dump_stalls++;
+    m_frame_dump_stall_time_us += Common::Timer::GetTimeUs() - start_time;
+  }
+
+  return m_frame_dump_readback_textures[m_frame_dump_frames_queued % FRAME_DUMP_READBACK_TEXTURES];
+}
+
 void Renderer::FlushFrameDump()
 {
   if (!m_last_frame_exported)
     return;
 
-  // Ensure the previously-queued frame was encoded.
-  FinishFrameData();
-
   // Queue encoding of the last frame dumped.
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_textures[0];
+  std::unique_ptr<AbstractStagingTexture>& rbtex =
+      m_frame_dump_readback_textures[m_frame_dump_frames_queued % FRAME_DUMP_READBACK_TEXTURES];
   rbtex->Flush();
   if (rbtex->Map())
   {
@@ -1498,10 +1512,23 @@ void Renderer::ShutdownFrameDumping()
   FinishFrameData();
 
   // Wake thread up, and wait for it to exit.
-  m_frame_dump_thread_running.Clear();
-  m_frame_dump_start.Set();
+  {
+    std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+    m_frame_dump_thread_running.Clear();
+  }
+  m_frame_dump_cv.notify_all();
   if (m_frame_dump_thread.joinable())
     m_frame_dump_thread.join();
+
+  if (m_frame_dump_stalls != 0)
+  {
+    NOTICE_LOG(VIDEO, "Frame dumping waited %u times for the encoder, %" PRIu64 " ms in total",
+               m_frame_dump_stalls, m_frame_dump_stall_time_us / 1000);
+    OSD::AddMessage(fmt::format("Frame dumping slowed down emulation {} times, {} ms in total",
+                                m_frame_dump_stalls, m_frame_dump_stall_time_us / 1000),
+                    10000);
+  }
+  g_stats.frame_dump_queue_depth = 0;
   m_frame_dump_render_framebuffer.reset();
   m_frame_dump_render_texture.reset();
   for (auto& tex : m_frame_dump_readback_textures)
@@ -1511,28 +1538,35 @@ void Renderer::ShutdownFrameDumping()
 void Renderer::DumpFrameData(const u8* data, int w, int h, int stride,
                              const FrameDump::Frame& state)
 {
-  m_frame_dump_config = FrameDumpConfig{data, w, h, stride, state};
-
   if (!m_frame_dump_thread_running.IsSet())
   {
     if (m_frame_dump_thread.joinable())
       m_frame_dump_thread.join();
+    m_frame_dump_stalls = 0;
+    m_frame_dump_stall_time_us = 0;
     m_frame_dump_thread_running.Set();
     m_frame_dump_thread = std::thread(&Renderer::RunFrameDumps, this);
   }
 
-  // Wake worker thread up.
-  m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
+  // Queue the frame, and wake the worker thread up.
+  {
+    std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+    m_frame_dump_queue.push_back(FrameDumpConfig{data, w, h, stride, state});
+    m_frame_dump_frames_queued++;
+
+    g_stats.frame_dump_queue_depth =
+        static_cast<int>(m_frame_dump_frames_queued - m_frame_dump_frames_done);
+    g_stats.num_frame_dump_stalls = static_cast<int>(m_frame_dump_stalls);
+    g_stats.frame_dump_stall_time_ms = static_cast<int>(m_frame_dump_stall_time_us / 1000);
+  }
+  m_frame_dump_cv.notify_all();
 }
 
 void Renderer::FinishFrameData()
 {
-  if (!m_frame_dump_frame_running)
-    return;
-
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
+  std::unique_lock<std::mutex> lk(m_frame_dump_lock);
+  m_frame_dump_cv.wait(lk,
+                       [this] { return m_frame_dump_frames_done == m_frame_dump_frames_queued; });
 }
 
 void Renderer::RunFrameDumps()
@@ -1553,11 +1587,18 @@ void Renderer::RunFrameDumps()
 
   while (true)
   {
-    m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
-      break;
-
-    auto config = m_frame_dump_config;
+    FrameDumpConfig config;
+    {
+      std::unique_lock<std::mutex> lk(m_frame_dump_lock);
+      m_frame_dump_cv.wait(lk, [this] {
+        return !m_frame_dump_queue.empty() || !m_frame_dump_thread_running.IsSet();
+      });
+      if (m_frame_dump_queue.empty())
+        break;
+
+      config = m_frame_dump_queue.front();
+      m_frame_dump_queue.pop_front();
+    }
 
     // Save screenshot
     if (m_screenshot_request.TestAndClear())
@@ -1597,7 +1638,11 @@ void Renderer::RunFrameDumps()
       }
     }
 
-    m_frame_dump_done.Set();
+    {
+      std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+      m_frame_dump_frames_done++;
+    }
+    m_frame_dump_cv.notify_all();
   }
 
   if (frame_dump_started)
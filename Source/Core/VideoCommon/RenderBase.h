@@ -15,6 +15,8 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -349,12 +351,13 @@ private:
   int m_last_window_request_height = 0;
 
   // frame dumping
+  // Number of frames that can be read back or waiting to be encoded, before the GPU thread has to
+  // wait for the encoder.
+  static constexpr size_t FRAME_DUMP_READBACK_TEXTURES = 4;
+
   std::thread m_frame_dump_thread;
-  Common::Event m_frame_dump_start;
-  Common::Event m_frame_dump_done;
   Common::Flag m_frame_dump_thread_running;
   u32 m_frame_dump_image_counter = 0;
-  bool m_frame_dump_frame_running = false;
   struct FrameDumpConfig
   {
     const u8* data;
@@ -362,12 +365,25 @@ private:
     int height;
     int stride;
     FrameDump::Frame state;
-  } m_frame_dump_config;
+  };
+
+  // Frames waiting for the frame dumping thread. The readback texture of a queued frame isn't
+  // reused until the frame has been encoded.
+  std::mutex m_frame_dump_lock;
+  std::condition_variable m_frame_dump_cv;
+  std::deque<FrameDumpConfig> m_frame_dump_queue;
+  u64 m_frame_dump_frames_queued = 0;
+  u64 m_frame_dump_frames_done = 0;
+
+  // How often, and for how long, the GPU thread had to wait for the encoder.
+  u32 m_frame_dump_stalls = 0;
+  u64 m_frame_dump_stall_time_us = 0;
 
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
-  std::array<std::unique_ptr<AbstractStagingTexture>, 2> m_frame_dump_readback_textures;
+  std::array<std::unique_ptr<AbstractStagingTexture>, FRAME_DUMP_READBACK_TEXTURES>
+      m_frame_dump_readback_textures;
   FrameDump::Frame m_last_frame_state;
   bool m_last_frame_exported = false;
 
@@ -394,7 +410,11 @@ private:
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
   // Checks that the frame dump readback texture exists and is the correct size.
-  bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
+  bool CheckFrameDumpReadbackTexture(std::unique_ptr<AbstractStagingTexture>& rbtex,
+                                     u32 target_width, u32 target_height);
+
+  // Returns the readback texture for the next frame, waiting for the encoder if it's still in use.
+  std::unique_ptr<AbstractStagingTexture>& GetFrameDumpReadbackTexture();
 
   // Fills the frame dump staging texture with the current XFB texture.
   void DumpCurrentFrame(const AbstractTexture* src_texture,
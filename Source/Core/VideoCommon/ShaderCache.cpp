@@ -7,6 +7,7 @@
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Trace.h"
 #include "Core/ConfigManager.h"
 
 #include "VideoCommon/FramebufferManager.h"
@@ -417,6 +418,7 @@ void ShaderCache::CompileMissingPipelines()
 
 std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexShaderUid& uid) const
 {
+  TRACE_SCOPE("ShaderCache::CompileVertexShader");
   const ShaderCode source_code =
       GenerateVertexShaderCode(m_api_type, m_host_config, uid.GetUidData());
   return g_renderer->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer());
@@ -432,6 +434,7 @@ ShaderCache::CompileVertexUberShader(const UberShader::VertexShaderUid& uid) con
 
 std::unique_ptr<AbstractShader> ShaderCache::CompilePixelShader(const PixelShaderUid& uid) const
 {
+  TRACE_SCOPE("ShaderCache::CompilePixelShader");
   const ShaderCode source_code =
       GeneratePixelShaderCode(m_api_type, m_host_config, uid.GetUidData());
   return g_renderer->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer());
@@ -87,6 +87,13 @@ void Statistics::Display() const
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
 
+  if (frame_dump_queue_depth != 0)
+  {
+    draw_statistic("Frame dump queue", "%d", frame_dump_queue_depth);
+    draw_statistic("Frame dump stalls", "%d (%d ms)", num_frame_dump_stalls,
+                   frame_dump_stall_time_ms);
+  }
+
   ImGui::Columns(1);
 
   ImGui::End();
@@ -19,6 +19,11 @@ struct Statistics
 
   int num_vertex_loaders;
 
+  // Frames waiting to be encoded, and how often the GPU thread had to wait for the encoder.
+  int frame_dump_queue_depth;
+  int num_frame_dump_stalls;
+  int frame_dump_stall_time_ms;
+
   std::array<float, 6> proj;
   std::array<float, 16> gproj;
   std::array<float, 16> g2proj;
@@ -26,6 +26,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 #include "Common/MemoryUtil.h"
+#include "Common/Trace.h"
 
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
@@ -94,7 +95,8 @@ TextureCacheBase::TextureCacheBase()
 
   HiresTexture::Init();
 
-  Common::SetHash64Function();
+  Common::SetHash64Function(backup_config.xxh3_texture_hashing ? Common::Hash64Mode::XXH3 :
+                                                                Common::Hash64Mode::Legacy);
 
   InvalidateAllBindPoints();
 }
@@ -140,7 +142,8 @@ void TextureCacheBase::Invalidate()
 void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
 {
   if (config.bHiresTextures != backup_config.hires_textures ||
-      config.bCacheHiresTextures != backup_config.cache_hires_textures)
+      config.bCacheHiresTextures != backup_config.cache_hires_textures ||
+      config.iHiresTextureCacheSize != backup_config.hires_texture_cache_size)
   {
     HiresTexture::Update();
   }
@@ -152,10 +155,13 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
       config.bHiresTextures != backup_config.hires_textures ||
       config.bEnableGPUTextureDecoding != backup_config.gpu_texture_decoding ||
       config.bDisableCopyToVRAM != backup_config.disable_vram_copies ||
-      config.bArbitraryMipmapDetection != backup_config.arbitrary_mipmap_detection)
+      config.bArbitraryMipmapDetection != backup_config.arbitrary_mipmap_detection ||
+      config.bXXH3TextureHashing != backup_config.xxh3_texture_hashing)
   {
     Invalidate();
     TexDecoder_SetTexFmtOverlayOptions(config.bTexFmtOverlayEnable, config.bTexFmtOverlayCenter);
+    Common::SetHash64Function(config.bXXH3TextureHashing ? Common::Hash64Mode::XXH3 :
+                                                           Common::Hash64Mode::Legacy);
   }
 
   SetBackupConfig(config);
@@ -242,11 +248,13 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
   backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   backup_config.hires_textures = config.bHiresTextures;
   backup_config.cache_hires_textures = config.bCacheHiresTextures;
+  backup_config.hires_texture_cache_size = config.iHiresTextureCacheSize;
   backup_config.stereo_3d = config.stereo_mode != StereoMode::Off;
   backup_config.efb_mono_depth = config.bStereoEFBMonoDepth;
   backup_config.gpu_texture_decoding = config.bEnableGPUTextureDecoding;
   backup_config.disable_vram_copies = config.bDisableCopyToVRAM;
   backup_config.arbitrary_mipmap_detection = config.bArbitraryMipmapDetection;
+  backup_config.xxh3_texture_hashing = config.bXXH3TextureHashing;
 }
 
 TextureCacheBase::TCacheEntry*
@@ -516,6 +524,9 @@ void TextureCacheBase::DoState(PointerWrap& p)
 
 void TextureCacheBase::DoSaveState(PointerWrap& p)
 {
+  u32 hash_revision = Common::GetHash64Revision();
+  p.Do(hash_revision);
+
   std::map<const TCacheEntry*, u32> entry_map;
   std::vector<TCacheEntry*> entries_to_save;
   auto ShouldSaveEntry = [](const TCacheEntry* entry) {
@@ -636,11 +647,17 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
     return iter == id_map.end() ? nullptr : iter->second;
   };
 
+  // The hashes of the saved entries can only be compared with the ones calculated now if they
+  // were calculated the same way. Otherwise, the entries are dropped like invalid ones.
+  u32 hash_revision = 0;
+  p.Do(hash_revision);
+
   // Only clear out state when actually restoring/loading.
   // Since we throw away entries when not in loading mode now, we don't need to check
   // before inserting entries into the cache, as GetEntry will always return null.
-  const bool commit_state = p.GetMode() == PointerWrap::MODE_READ;
-  if (commit_state)
+  const bool commit_state = p.GetMode() == PointerWrap::MODE_READ &&
+                            hash_revision == Common::GetHash64Revision();
+  if (p.GetMode() == PointerWrap::MODE_READ)
     Invalidate();
 
   // Preload all cache entries.
@@ -1267,9 +1284,81 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
                                           MemoryUpdate::TEXTURE_MAP);
   }
 
+  // If the memory of an earlier texture at this address has been watched and not written since,
+  // its hash can be reused instead of hashing the data again. If only the end of it was written,
+  // the hash can be resumed from the last checkpoint before the first written part.
+  u64 write_stamp = 0;
+  bool hash_reused = false;
+  std::shared_ptr<const std::vector<Common::Hash64Checkpoint>> hash_checkpoints;
+  const std::vector<Common::Hash64Checkpoint>* resume_checkpoints = nullptr;
+  u32 hash_resume_offset = 0;
+  if (!from_tmem)
+  {
+    const TCacheEntry* partially_written_entry = nullptr;
+    const auto reuse_range = textures_by_address.equal_range(address);
+    for (auto it = reuse_range.first; it != reuse_range.second; ++it)
+    {
+      const TCacheEntry* entry = it->second;
+      if (entry->IsCopy() || entry->write_stamp == 0 || entry->size_in_bytes != texture_size ||
+          entry->format.texfmt != texformat)
+      {
+        continue;
+      }
+
+      if (!Memory::HasBeenWrittenSince(address, texture_size, entry->write_stamp))
+      {
+        base_hash = entry->base_hash;
+        write_stamp = entry->write_stamp;
+        hash_checkpoints = entry->hash_checkpoints;
+        hash_reused = true;
+        break;
+      }
+
+      if (!partially_written_entry && entry->hash_checkpoints)
+        partially_written_entry = entry;
+    }
+
+    if (!hash_reused)
+    {
+      write_stamp = Memory::WatchForWrites(address, texture_size);
+
+      if (partially_written_entry &&
+          Common::CanHash64Incrementally(texture_size, textureCacheSafetyColorSampleSize))
+      {
+        resume_checkpoints = partially_written_entry->hash_checkpoints.get();
+        while (hash_resume_offset < texture_size &&
+               !Memory::HasBeenWrittenSince(
+                   address + hash_resume_offset,
+                   std::min(texture_size - hash_resume_offset, Common::HASH64_CHECKPOINT_INTERVAL),
+                   partially_written_entry->write_stamp))
+        {
+          hash_resume_offset += Common::HASH64_CHECKPOINT_INTERVAL;
+        }
+      }
+    }
+  }
+
   // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
   // from the low tmem bank than it should)
-  base_hash = Common::GetHash64(src_data, texture_size, textureCacheSafetyColorSampleSize);
+  if (!hash_reused)
+  {
+    // Checkpoints are only useful if the writes to the memory are tracked.
+    if (write_stamp != 0 &&
+        Common::CanHash64Incrementally(texture_size, textureCacheSafetyColorSampleSize))
+    {
+      std::vector<Common::Hash64Checkpoint> checkpoints;
+      if (resume_checkpoints)
+        checkpoints = *resume_checkpoints;
+      base_hash = Common::GetHash64Incremental(src_data, texture_size, hash_resume_offset,
+                                               &checkpoints);
+      hash_checkpoints =
+          std::make_shared<const std::vector<Common::Hash64Checkpoint>>(std::move(checkpoints));
+    }
+    else
+    {
+      base_hash = Common::GetHash64(src_data, texture_size, textureCacheSafetyColorSampleSize);
+    }
+  }
   u32 palette_size = 0;
   if (isPaletteTexture)
   {
@@ -1413,6 +1502,8 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
           entry->native_levels >= tex_levels && entry->native_width == nativeW &&
           entry->native_height == nativeH)
       {
+        entry->write_stamp = write_stamp;
+        entry->hash_checkpoints = std::move(hash_checkpoints);
         entry = DoPartialTextureUpdates(iter->second, &texMem[tlutaddr], tlutfmt);
         entry->texture->FinishedRendering();
         return entry;
@@ -1491,6 +1582,8 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
     InvalidateTexture(oldest_entry);
   }
 
+  TRACE_SCOPE("TextureCache::LoadTexture");
+
   std::shared_ptr<HiresTexture> hires_tex;
   if (g_ActiveConfig.bHiresTextures)
   {
@@ -1597,6 +1690,8 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
   entry->SetGeneralParameters(address, texture_size, full_format, false);
   entry->SetDimensions(nativeW, nativeH, tex_levels);
   entry->SetHashes(base_hash, full_hash);
+  entry->write_stamp = write_stamp;
+  entry->hash_checkpoints = std::move(hash_checkpoints);
   entry->is_custom_tex = hires_tex != nullptr;
   entry->memory_stride = entry->BytesPerRow();
   entry->SetNotCopy();
@@ -2202,6 +2297,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
         // Immediately flush it.
         WriteEFBCopyToRAM(dst, bytes_per_row / sizeof(u32), num_blocks_y, dstStride,
                           std::move(staging_texture));
+        Memory::NotifyWrite(dstAddr, dstStride * num_blocks_y);
       }
       else
       {
@@ -2343,6 +2439,7 @@ void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
   u8* const dst = Memory::GetPointer(entry->addr);
   WriteEFBCopyToRAM(dst, entry->pending_efb_copy_width, entry->pending_efb_copy_height,
                     entry->memory_stride, std::move(entry->pending_efb_copy));
+  Memory::NotifyWrite(entry->addr, entry->memory_stride * entry->pending_efb_copy_height);
 
   // If the EFB copy was invalidated (e.g. the bloom case mentioned in InvalidateTexture), now is
   // the time to clean up the TCacheEntry. In which case, we don't need to compute the new hash of
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
 #include "Common/MathUtil.h"
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/BPMemory.h"
@@ -106,6 +107,13 @@ public:
     bool is_xfb_container = false;
     u64 id;
 
+    // Stamp from Memory::WatchForWrites taken before base_hash was calculated, 0 if the memory
+    // isn't being watched. As long as it hasn't been written since, base_hash is still valid.
+    u64 write_stamp = 0;
+    // Hash states for resuming the hash of a texture of which only the end was written, see
+    // Common::GetHash64Incremental. Shared with the entries that reused base_hash.
+    std::shared_ptr<const std::vector<Common::Hash64Checkpoint>> hash_checkpoints;
+
     bool reference_changed = false;  // used by xfb to determine when a reference xfb changed
 
     unsigned int native_width,
@@ -142,6 +150,8 @@ public:
       size_in_bytes = _size;
       format = _format;
       should_force_safe_hashing = force_safe_hashing;
+      write_stamp = 0;
+      hash_checkpoints.reset();
     }
 
     void SetDimensions(unsigned int _native_width, unsigned int _native_height,
@@ -346,12 +356,14 @@ private:
     bool texfmt_overlay_center;
     bool hires_textures;
     bool cache_hires_textures;
+    int hires_texture_cache_size;
     bool copy_cache_enable;
     bool stereo_3d;
     bool efb_mono_depth;
     bool gpu_texture_decoding;
     bool disable_vram_copies;
     bool arbitrary_mipmap_detection;
+    bool xxh3_texture_hashing;
   };
   BackupConfig backup_config = {};
 
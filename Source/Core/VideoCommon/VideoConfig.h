@@ -104,6 +104,7 @@ struct VideoConfig final
   bool bDumpTextures;
   bool bHiresTextures;
   bool bCacheHiresTextures;
+  int iHiresTextureCacheSize;  // in MB, 0 = automatic
   bool bDumpEFBTarget;
   bool bDumpXFBTarget;
   bool bDumpFramesAsImages;
@@ -139,6 +140,7 @@ struct VideoConfig final
   bool bEnablePixelLighting;
   bool bFastDepthCalc;
   bool bVertexRounding;
+  bool bXXH3TextureHashing;
   int iEFBAccessTileSize;
   int iLog;           // CONF_ bits
   int iSaveTargetId;  // TODO: Should be dropped
@@ -0,0 +1,140 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "VideoCommon/HiresTexturePack.h"
+
+static void PrintUsage()
+{
+  printf("USAGE: TexturePackTool [-?] [--help] [-c <LEVEL>] [-l] <INPUT> [<OUTPUT>]\n");
+  printf("-? / --help: Prints this message\n");
+  printf("-c <LEVEL>: Compress the textures with zstd at the given level (1-22)\n");
+  printf("-l: List the textures in a texture pack\n");
+  printf("\n");
+  printf("Converts a directory of custom textures into a texture pack. To be used, the pack has\n");
+  printf("to be named after the game ID like the directory, for example GALE01%s,\n",
+         std::string(HiresTexturePack::EXTENSION).c_str());
+  printf("and placed in the Load/Textures directory.\n");
+}
+
+static bool IsHelpFlag(const std::string& argument)
+{
+  return argument == "--help" || argument == "-?";
+}
+
+static int ListTexturePack(const std::string& path, bool print_textures)
+{
+  std::unique_ptr<HiresTexturePack> pack = HiresTexturePack::Open(path);
+  if (!pack)
+  {
+    printf("ERROR: Failed to open texture pack %s.\n", path.c_str());
+    return 1;
+  }
+
+  u64 stored_size = 0;
+  u64 uncompressed_size = 0;
+  for (const HiresTexturePack::Entry& entry : pack->GetEntries())
+  {
+    if (print_textures)
+    {
+      printf("%s %u %u\n", std::string(pack->GetName(entry)).c_str(), entry.data_size,
+             entry.uncompressed_size);
+    }
+    stored_size += entry.data_size;
+    uncompressed_size += entry.uncompressed_size;
+  }
+
+  printf("%zu textures, %.1f MB (%.1f MB uncompressed)\n", pack->GetEntries().size(),
+         stored_size / (1024.0 * 1024.0), uncompressed_size / (1024.0 * 1024.0));
+  return 0;
+}
+
+static int CreateTexturePack(const std::string& directory, const std::string& path,
+                             int compression_level)
+{
+  if (!File::IsDirectory(directory))
+  {
+    printf("ERROR: %s is not a directory.\n", directory.c_str());
+    return 1;
+  }
+
+  const std::vector<HiresTexturePack::TextureFile> files =
+      HiresTexturePack::FindTextureFiles(directory);
+  if (files.empty())
+  {
+    printf("ERROR: No custom textures found in %s.\n", directory.c_str());
+    return 1;
+  }
+
+  printf("Packing %zu textures...\n", files.size());
+  std::string error_message;
+  if (!HiresTexturePack::Create(path, files, compression_level, &error_message))
+  {
+    printf("ERROR: %s.\n", error_message.c_str());
+    return 1;
+  }
+
+  return ListTexturePack(path, false);
+}
+
+// Usage:
+// Pack a directory:
+//   texturepacktool Load/Textures/GALE01 Load/Textures/GALE01.dtp
+// Pack a directory with compression:
+//   texturepacktool -c 19 Load/Textures/GALE01 Load/Textures/GALE01.dtp
+// List the contents of a pack:
+//   texturepacktool -l Load/Textures/GALE01.dtp
+int main(int argc, const char* argv[])
+{
+  if (argc == 1 || (argc == 2 && IsHelpFlag(argv[1])))
+  {
+    PrintUsage();
+    return 0;
+  }
+
+  std::vector<std::string> paths;
+  int compression_level = 0;
+  bool list = false;
+  for (int i = 1; i < argc; i++)
+  {
+    const std::string argument = argv[i];
+    if (argument == "-c")
+    {
+      if (++i < argc)
+        compression_level = std::atoi(argv[i]);
+    }
+    else if (argument == "-l")
+    {
+      list = true;
+    }
+    else
+    {
+      paths.push_back(argument);
+    }
+  }
+
+  if (list)
+  {
+    if (paths.size() != 1)
+    {
+      printf("ERROR: -l takes a single texture pack.\n");
+      return 1;
+    }
+    return ListTexturePack(paths[0], true);
+  }
+
+  if (paths.size() != 2)
+  {
+    printf("ERROR: Expected an input directory and an output file.\n");
+    return 1;
+  }
+  return CreateTexturePack(paths[0], paths[1], compression_level);
+}
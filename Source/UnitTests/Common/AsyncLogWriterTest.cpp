@@ -0,0 +1,110 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cstdarg>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Logging/AsyncLogWriter.h"
+#include "Common/StringUtil.h"
+
+using Common::Log::AsyncLogWriter;
+
+namespace
+{
+class MessageCollector
+{
+public:
+  void Push(AsyncLogWriter* writer, const char* format, ...)
+  {
+    va_list args;
+    va_start(args, format);
+    writer->Push(Common::Log::LINFO, Common::Log::COMMON, __FILE__, __LINE__, format, args);
+    va_end(args);
+  }
+
+  AsyncLogWriter::Callback GetCallback()
+  {
+    return [this](const AsyncLogWriter::Message& message) {
+      std::lock_guard lk(m_lock);
+      m_messages.emplace_back(message.text);
+    };
+  }
+
+  const std::vector<std::string>& GetMessages() const { return m_messages; }
+
+private:
+  std::mutex m_lock;
+  std::vector<std::string> m_messages;
+};
+}  // namespace
+
+TEST(AsyncLogWriter, MatchesPrintf)
+{
+  MessageCollector collector;
+  {
+    AsyncLogWriter writer(collector.GetCallback());
+    collector.Push(&writer, "plain text");
+    collector.Push(&writer, "100%% %d %i %u", -5, 42, 3000000000u);
+    collector.Push(&writer, "%08x %X %#o %hhx %hu", 0xbeefu, 0xabcdu, 8u, 0x1ff, 0x12345);
+    collector.Push(&writer, "%lld %llu %zu %ld", -1234567890123ll, 18446744073709551615ull,
+                   size_t(7), -3l);
+    collector.Push(&writer, "%c%c %.3f %e %g", 'o', 'k', 3.14159, 1e-10, 0.5f);
+    collector.Push(&writer, "[%s] [%-8s] [%.2s] [%.*s] [%*d]", "str", "pad", "truncate", 3,
+                   "abcdef", 5, 42);
+  }
+
+  const std::vector<std::string> expected{
+      "plain text",
+      StringFromFormat("100%% %d %i %u", -5, 42, 3000000000u),
+      StringFromFormat("%08x %X %#o %hhx %hu", 0xbeefu, 0xabcdu, 8u, 0x1ff, 0x12345),
+      StringFromFormat("%lld %llu %zu %ld", -1234567890123ll, 18446744073709551615ull, size_t(7),
+                       -3l),
+      StringFromFormat("%c%c %.3f %e %g", 'o', 'k', 3.14159, 1e-10, 0.5f),
+      StringFromFormat("[%s] [%-8s] [%.2s] [%.*s] [%*d]", "str", "pad", "truncate", 3, "abcdef",
+                       5, 42),
+  };
+  EXPECT_EQ(expected, collector.GetMessages());
+}
+
+TEST(AsyncLogWriter, StringsAreCopied)
+{
+  MessageCollector collector;
+  {
+    AsyncLogWriter writer(collector.GetCallback());
+    std::string str = "before";
+    collector.Push(&writer, "%s", str.c_str());
+    str = "after!";
+  }
+
+  ASSERT_EQ(1u, collector.GetMessages().size());
+  EXPECT_EQ("before", collector.GetMessages()[0]);
+}
+
+TEST(AsyncLogWriter, LongMessagesFallBack)
+{
+  MessageCollector collector;
+  // Longer than the arguments of a single record, but shorter than the maximum message length.
+  std::string long_string;
+  for (int i = 0; i < 100; ++i)
+    long_string += StringFromFormat("%03d:%s ", i, "ab");
+  const std::string too_long_string(2000, 'x');
+  {
+    AsyncLogWriter writer(collector.GetCallback());
+    collector.Push(&writer, "%s", long_string.c_str());
+    collector.Push(&writer, "%s", too_long_string.c_str());
+    collector.Push(&writer, "after");
+  }
+
+  ASSERT_EQ(3u, collector.GetMessages().size());
+  EXPECT_GT(long_string.size(), 480u);
+  EXPECT_EQ(long_string, collector.GetMessages()[0]);
+  EXPECT_FALSE(collector.GetMessages()[1].empty());
+  EXPECT_EQ(std::string::npos, collector.GetMessages()[1].find_first_not_of('x'));
+  EXPECT_EQ("after", collector.GetMessages()[2]);
+}
@@ -0,0 +1,78 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Common/Config/Config.h"
+
+namespace
+{
+const Config::Info<int> TEST_INT{{Config::System::Main, "Test", "Int"}, 1};
+const Config::Info<std::string> TEST_STRING{{Config::System::Main, "Test", "String"}, "default"};
+
+class ConfigTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    Config::Init();
+    Config::AddLayer(std::make_unique<EmptyLoader>(Config::LayerType::Base));
+  }
+  void TearDown() override { Config::Shutdown(); }
+
+private:
+  class EmptyLoader final : public Config::ConfigLayerLoader
+  {
+  public:
+    using ConfigLayerLoader::ConfigLayerLoader;
+    void Load(Config::Layer*) override {}
+    void Save(Config::Layer*) override {}
+  };
+};
+}  // namespace
+
+TEST_F(ConfigTest, CachedValueFollowsSet)
+{
+  EXPECT_EQ(1, Config::Get(TEST_INT));
+  EXPECT_EQ("default", Config::Get(TEST_STRING));
+
+  Config::SetBase(TEST_INT, 2);
+  Config::SetBase(TEST_STRING, std::string("base"));
+  EXPECT_EQ(2, Config::Get(TEST_INT));
+  EXPECT_EQ("base", Config::Get(TEST_STRING));
+
+  Config::SetCurrent(TEST_INT, 3);
+  EXPECT_EQ(3, Config::Get(TEST_INT));
+  EXPECT_EQ(2, Config::GetBase(TEST_INT));
+}
+
+TEST_F(ConfigTest, CachedValueFollowsDirectLayerWrites)
+{
+  EXPECT_EQ(1, Config::Get(TEST_INT));
+
+  const auto layer = Config::GetLayer(Config::LayerType::CurrentRun);
+  layer->Set(TEST_INT, 4);
+  EXPECT_EQ(4, Config::Get(TEST_INT));
+
+  layer->DeleteKey(TEST_INT.location);
+  EXPECT_EQ(1, Config::Get(TEST_INT));
+
+  Config::SetCurrent(TEST_INT, 5);
+  Config::ClearCurrentRunLayer();
+  EXPECT_EQ(1, Config::Get(TEST_INT));
+}
+
+TEST_F(ConfigTest, CopiesDoNotShareCache)
+{
+  Config::SetBase(TEST_INT, 6);
+  EXPECT_EQ(6, Config::Get(TEST_INT));
+
+  const Config::Info<int> copy = TEST_INT;
+  EXPECT_EQ(6, Config::Get(copy));
+  Config::SetBase(copy, 7);
+  EXPECT_EQ(7, Config::Get(TEST_INT));
+  EXPECT_EQ(7, Config::Get(copy));
+}
@@ -0,0 +1,152 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+namespace
+{
+std::vector<u8> MakeData(size_t size)
+{
+  std::vector<u8> data(size);
+  u64 x = 1;
+  for (u8& byte : data)
+  {
+    x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+    byte = static_cast<u8>(x >> 56);
+  }
+  return data;
+}
+
+std::vector<Common::Hash64Implementation> GetXXH3Implementations()
+{
+  std::vector<Common::Hash64Implementation> implementations;
+  for (const auto& implementation : Common::GetHash64Implementations())
+  {
+    if (implementation.mode == Common::Hash64Mode::XXH3)
+      implementations.push_back(implementation);
+  }
+  return implementations;
+}
+}  // namespace
+
+TEST(Hash, XXH3MatchesReference)
+{
+  // Calculated with the reference implementation of XXH3_64bits.
+  static const std::pair<u32, u64> expected[] = {
+      {0, 0x2D06800538D394C2ULL},
+      {1, 0xC00F9D4F580C0C3AULL},
+      {3, 0xE92112D1E602AF4AULL},
+      {4, 0x9008DE7E100606D1ULL},
+      {8, 0xCCA6EE6F8E080C52ULL},
+      {9, 0x568F9D2E69AD8BD0ULL},
+      {16, 0x600A07A4F5A9911CULL},
+      {17, 0xDEAB0265F35DFC24ULL},
+      {100, 0x43F564F2115EB14FULL},
+      {128, 0x410BD3B4D8D84F51ULL},
+      {129, 0x55964EEC39625032ULL},
+      {200, 0xEDCED795343597FDULL},
+      {240, 0x977B659BDC81FDB1ULL},
+      {241, 0x2CB1ED4A30C8BDEDULL},
+      {1000, 0x00187EF5AD20CB35ULL},
+      {1024, 0x5EC111A1E5A293AEULL},
+      {1025, 0x5EA0264528A903FCULL},
+      {4096, 0xA76570548864595EULL},
+      {65536, 0xD062F29C26DA8CF9ULL},
+      {100003, 0x03D688B82EAD917DULL},
+      {1048576, 0x7B0C7E7348BDE3FFULL},
+  };
+
+  const std::vector<u8> data = MakeData(1 << 20);
+  for (const auto& implementation : GetXXH3Implementations())
+  {
+    for (const auto& [len, hash] : expected)
+    {
+      EXPECT_EQ(hash, implementation.function(data.data(), len, 0))
+          << implementation.name << " " << len;
+    }
+  }
+}
+
+TEST(Hash, XXH3SampledImplementationsAgree)
+{
+  const std::vector<u8> data = MakeData(1 << 18);
+  const auto implementations = GetXXH3Implementations();
+  for (u32 len : {241u, 5000u, 1u << 18})
+  {
+    for (u32 samples : {1u, 7u, 128u, 100000u})
+    {
+      const u64 reference = implementations[0].function(data.data(), len, samples);
+      for (const auto& implementation : implementations)
+      {
+        EXPECT_EQ(reference, implementation.function(data.data(), len, samples))
+            << implementation.name << " " << len << " " << samples;
+      }
+    }
+  }
+}
+
+TEST(Hash, IncrementalMatchesFullHash)
+{
+  Common::SetHash64Function(Common::Hash64Mode::XXH3);
+  ASSERT_EQ(Common::Hash64Mode::XXH3, Common::GetHash64Mode());
+
+  for (u32 len : {241u, 4097u, 65536u, 100003u})
+  {
+    std::vector<u8> data = MakeData(len);
+    std::vector<Common::Hash64Checkpoint> checkpoints;
+    EXPECT_EQ(Common::GetHash64(data.data(), len, 0),
+              Common::GetHash64Incremental(data.data(), len, 0, &checkpoints));
+
+    // Only the data after the modified offset has to be hashed again.
+    for (u32 offset : {len / 3, len / 2, len - 1})
+    {
+      data[offset] ^= 0xFF;
+      EXPECT_EQ(Common::GetHash64(data.data(), len, 0),
+                Common::GetHash64Incremental(data.data(), len, offset, &checkpoints))
+          << len << " " << offset;
+    }
+  }
+
+  Common::SetHash64Function();
+  EXPECT_EQ(Common::Hash64Mode::Legacy, Common::GetHash64Mode());
+}
+
+TEST(Hash, RevisionDependsOnFunction)
+{
+  Common::SetHash64Function(Common::Hash64Mode::XXH3);
+  const u32 xxh3_revision = Common::GetHash64Revision();
+  Common::SetHash64Function(Common::Hash64Mode::Legacy);
+  EXPECT_NE(xxh3_revision, Common::GetHash64Revision());
+}
+
+// Compares the speed of all hash functions. Run with --gtest_also_run_disabled_tests.
+TEST(Hash, DISABLED_Benchmark)
+{
+  constexpr size_t TOTAL_BYTES = 1ULL << 30;
+  const std::vector<u8> data = MakeData(1 << 20);
+
+  for (const auto& implementation : Common::GetHash64Implementations())
+  {
+    for (u32 len : {256u, 4096u, 65536u, 1u << 20})
+    {
+      const size_t iterations = TOTAL_BYTES / len;
+      u64 result = 0;
+      const auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < iterations; i++)
+        result += implementation.function(data.data(), len, 0);
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+      std::printf("%-16s %8u bytes: %8.2f GB/s (%016llx)\n", implementation.name, len,
+                  TOTAL_BYTES / elapsed.count() / 1e9, static_cast<unsigned long long>(result));
+    }
+  }
+}
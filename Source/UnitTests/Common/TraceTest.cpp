@@ -0,0 +1,89 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Thread.h"
+#include "Common/Trace.h"
+
+namespace
+{
+size_t CountOccurrences(const std::string& str, const std::string& pattern)
+{
+  size_t count = 0;
+  for (size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1))
+    count++;
+  return count;
+}
+
+std::string ExportTrace()
+{
+  const std::string directory = File::CreateTempDir();
+  const std::string path = directory + "/trace.json";
+  std::string trace;
+  if (Common::Trace::ExportChromeTrace(path))
+    File::ReadFileToString(path, trace);
+  File::DeleteDirRecursively(directory);
+  return trace;
+}
+}  // namespace
+
+TEST(Trace, DisabledScopesAreNotRecorded)
+{
+  Common::Trace::Clear();
+  Common::Trace::SetEnabled(false);
+  {
+    TRACE_SCOPE("Disabled");
+  }
+
+  EXPECT_EQ(0u, CountOccurrences(ExportTrace(), "\"Disabled\""));
+}
+
+TEST(Trace, RecordsScopesOfAllThreads)
+{
+  Common::Trace::Clear();
+  Common::Trace::SetEnabled(true);
+  {
+    TRACE_SCOPE("Main");
+  }
+  std::thread thread([] {
+    Common::SetCurrentThreadName("Trace test thread");
+    for (int i = 0; i < 3; i++)
+    {
+      TRACE_SCOPE("Worker");
+    }
+  });
+  thread.join();
+  Common::Trace::SetEnabled(false);
+
+  const std::string trace = ExportTrace();
+  EXPECT_EQ(1u, CountOccurrences(trace, "{\"name\":\"Main\",\"ph\":\"X\""));
+  EXPECT_EQ(3u, CountOccurrences(trace, "{\"name\":\"Worker\",\"ph\":\"X\""));
+  EXPECT_EQ(1u, CountOccurrences(trace, "\"args\":{\"name\":\"Trace test thread\"}"));
+
+  // Clearing drops the events, and forgets about the thread that has exited.
+  Common::Trace::Clear();
+  const std::string cleared_trace = ExportTrace();
+  EXPECT_EQ(0u, CountOccurrences(cleared_trace, "\"ph\":\"X\""));
+  EXPECT_EQ(0u, CountOccurrences(cleared_trace, "Trace test thread"));
+}
+
+TEST(Trace, KeepsTheNewestEvents)
+{
+  Common::Trace::Clear();
+  Common::Trace::SetEnabled(true);
+  for (int i = 0; i < 200000; i++)
+    Common::Trace::RecordEvent(i < 100000 ? "Old" : "New", i, i + 1);
+  Common::Trace::SetEnabled(false);
+
+  // The ring buffer of a thread holds tens of thousands of events.
+  const std::string trace = ExportTrace();
+  EXPECT_EQ(0u, CountOccurrences(trace, "\"Old\""));
+  EXPECT_LT(10000u, CountOccurrences(trace, "\"New\""));
+  EXPECT_GT(100000u, CountOccurrences(trace, "\"New\""));
+}
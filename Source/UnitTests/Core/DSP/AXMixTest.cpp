@@ -0,0 +1,94 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
+
+namespace
+{
+// AX GC mixes 32 samples per frame and AX Wii 96, Wii Remote buffers use 3 or 18. The others
+// cover every combination of the 8 and 4 sample SIMD paths and the scalar tail.
+constexpr std::array<u32, 10> SAMPLE_COUNTS{{0, 1, 3, 4, 8, 12, 18, 32, 95, 96}};
+constexpr u32 MAX_SAMPLES = 96;
+
+void CheckMatchesScalar(const std::array<s16, MAX_SAMPLES>& input, u32 count, u16 volume,
+                        u16 volume_delta, bool ramp)
+{
+  std::array<int, MAX_SAMPLES> expected_out;
+  expected_out.fill(0x1234);
+  std::array<int, MAX_SAMPLES> out = expected_out;
+
+  std::array<u16, 2> expected_vol{{volume, volume_delta}};
+  std::array<u16, 2> vol = expected_vol;
+  s16 expected_dpop = 0x55;
+  s16 dpop = expected_dpop;
+
+  DSP::HLE::MixAddScalar(expected_out.data(), input.data(), count, expected_vol.data(),
+                         &expected_dpop, ramp);
+  DSP::HLE::MixAdd(out.data(), input.data(), count, vol.data(), &dpop, ramp);
+
+  EXPECT_EQ(expected_out, out);
+  EXPECT_EQ(expected_vol, vol);
+  EXPECT_EQ(expected_dpop, dpop);
+}
+
+void CheckRandomParameters()
+{
+  std::mt19937 rng(0x41584D58);
+  std::uniform_int_distribution<int> sample_dist(-32768, 32767);
+  std::uniform_int_distribution<int> u16_dist(0, 0xFFFF);
+
+  std::array<s16, MAX_SAMPLES> input;
+  for (int iteration = 0; iteration < 1000; ++iteration)
+  {
+    for (s16& sample : input)
+      sample = static_cast<s16>(sample_dist(rng));
+
+    const u16 volume = static_cast<u16>(u16_dist(rng));
+    const u16 volume_delta = static_cast<u16>(u16_dist(rng));
+    for (u32 count : SAMPLE_COUNTS)
+    {
+      CheckMatchesScalar(input, count, volume, volume_delta, true);
+      CheckMatchesScalar(input, count, volume, volume_delta, false);
+    }
+  }
+}
+}  // namespace
+
+TEST(AXMix, ExtremeValues)
+{
+  std::array<s16, MAX_SAMPLES> input;
+  for (size_t i = 0; i < input.size(); ++i)
+    input[i] = (i & 1) ? -32768 : 32767;
+
+  for (u32 count : SAMPLE_COUNTS)
+  {
+    for (u16 volume : {0x0000, 0x0001, 0x7FFF, 0x8000, 0xFFFF})
+    {
+      CheckMatchesScalar(input, count, volume, 0, false);
+      CheckMatchesScalar(input, count, volume, 0x0100, true);
+      CheckMatchesScalar(input, count, volume, 0xFF00, true);
+    }
+  }
+}
+
+TEST(AXMix, RandomParameters)
+{
+  CheckRandomParameters();
+}
+
+// MixAdd uses the widest SIMD path the host has, so hide AVX2 to check the SSE4.1 path too.
+TEST(AXMix, RandomParametersWithoutAVX2)
+{
+  const bool has_avx2 = cpu_info.bAVX2;
+  cpu_info.bAVX2 = false;
+  CheckRandomParameters();
+  cpu_info.bAVX2 = has_avx2;
+}
@@ -0,0 +1,91 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/DSP/DSPAnalyzer.h"
+#include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPTables.h"
+
+namespace
+{
+std::array<u16, DSP::DSP_IRAM_SIZE> s_iram;
+std::array<u16, DSP::DSP_IROM_SIZE> s_irom;
+
+// Places the code at 0x0010 in an otherwise empty (NOP) IRAM and analyzes it.
+void AnalyzeCode(const std::vector<u16>& code)
+{
+  s_iram.fill(0);
+  s_irom.fill(0);
+  std::copy(code.begin(), code.end(), s_iram.begin() + 0x10);
+
+  DSP::g_dsp.iram = s_iram.data();
+  DSP::g_dsp.irom = s_irom.data();
+  DSP::InitInstructionTable();
+  DSP::Analyzer::Analyze();
+}
+
+bool IsIdleSkip(u16 address)
+{
+  return (DSP::Analyzer::GetCodeFlags(address) & DSP::Analyzer::CODE_IDLE_SKIP) != 0;
+}
+}  // namespace
+
+TEST(DSPAnalyzer, KnownSignature)
+{
+  AnalyzeCode({
+      0x26fc,          // LRS   $AC0.M, @DMBH
+      0x02c0, 0x8000,  // ANDCF $AC0.M, #0x8000
+      0x029d, 0x0010,  // JLZ   0x0010
+      0x02df,          // RET
+  });
+  EXPECT_TRUE(IsIdleSkip(0x10));
+  EXPECT_FALSE(IsIdleSkip(0x11));
+}
+
+TEST(DSPAnalyzer, MailboxPollLoop)
+{
+  AnalyzeCode({
+      0x00df, 0xfffe,  // LR    $AC1.M, @CMBH
+      0x03a0, 0x8000,  // ANDF  $AC1.M, #0x8000
+      0x029d, 0x0010,  // JLZ   0x0010
+      0x02df,          // RET
+  });
+  EXPECT_TRUE(IsIdleSkip(0x10));
+}
+
+TEST(DSPAnalyzer, LoopThatDoesNotPollMailbox)
+{
+  // Reads a DRAM word instead of a mailbox.
+  AnalyzeCode({
+      0x00df, 0x0352,  // LR    $AC1.M, @0x0352
+      0x03a0, 0x8000,  // ANDF  $AC1.M, #0x8000
+      0x029d, 0x0010,  // JLZ   0x0010
+      0x02df,          // RET
+  });
+  EXPECT_FALSE(IsIdleSkip(0x10));
+
+  // Tests a different register than the one the mailbox was read into.
+  AnalyzeCode({
+      0x00de, 0xfffe,  // LR    $AC0.M, @CMBH
+      0x03a0, 0x8000,  // ANDF  $AC1.M, #0x8000
+      0x029d, 0x0010,  // JLZ   0x0010
+      0x02df,          // RET
+  });
+  EXPECT_FALSE(IsIdleSkip(0x10));
+
+  // Jumps somewhere other than back to the mailbox read.
+  AnalyzeCode({
+      0x00de, 0xfffe,  // LR    $AC0.M, @CMBH
+      0x02a0, 0x8000,  // ANDF  $AC0.M, #0x8000
+      0x029d, 0x0020,  // JLZ   0x0020
+      0x02df,          // RET
+  });
+  EXPECT_FALSE(IsIdleSkip(0x10));
+}
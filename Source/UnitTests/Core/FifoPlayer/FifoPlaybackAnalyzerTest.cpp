@@ -0,0 +1,249 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/FifoPlayer/FifoAnalyzer.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+#include "Core/FifoPlayer/FifoPlaybackAnalyzer.h"
+#include "VideoCommon/OpcodeDecoding.h"
+
+namespace
+{
+MemoryUpdate MakeUpdate(u32 fifo_position, u32 address, std::vector<u8> data,
+                        MemoryUpdate::Type type = MemoryUpdate::TEXTURE_MAP)
+{
+  MemoryUpdate update;
+  update.fifoPosition = fifo_position;
+  update.address = address;
+  update.data = std::move(data);
+  update.type = type;
+  return update;
+}
+
+// Direct positions. VAT 0 starts with 2 bytes per vertex (XY as u8).
+constexpr u32 VCD_LO_DIRECT_POSITION = 0x200;
+// XYZ as float, 12 bytes per vertex.
+constexpr u32 VAT_G0_XYZ_FLOAT = 0x9;
+// XYZ as u8, 3 bytes per vertex.
+constexpr u32 VAT_G0_XYZ_U8 = 0x1;
+
+void LoadCPReg(std::vector<u8>& fifo, u8 subCmd, u32 value)
+{
+  fifo.insert(fifo.end(), {OpcodeDecoder::GX_LOAD_CP_REG, subCmd, u8(value >> 24), u8(value >> 16),
+                           u8(value >> 8), u8(value)});
+}
+
+void LoadBPReg(std::vector<u8>& fifo)
+{
+  fifo.insert(fifo.end(), {OpcodeDecoder::GX_LOAD_BP_REG, 0x61, 0, 0, 0});
+}
+
+// The vertex data is filled with the given byte, so that a wrong vertex size makes the analysis
+// see either NOPs or invalid opcodes.
+void Draw(std::vector<u8>& fifo, u8 vat, u16 numVertices, u32 vertexSize, u8 fill)
+{
+  const u8 cmd = 0x80 | (OpcodeDecoder::GX_DRAW_QUADS << OpcodeDecoder::GX_PRIMITIVE_SHIFT) | vat;
+  fifo.insert(fifo.end(), {cmd, u8(numVertices >> 8), u8(numVertices)});
+  fifo.insert(fifo.end(), numVertices * vertexSize, fill);
+}
+
+std::unique_ptr<FifoDataFile> CreateFile(const std::vector<std::vector<u8>>& frames)
+{
+  auto file = std::make_unique<FifoDataFile>();
+  u32* cpMem = file->GetCPMem();
+  std::memset(cpMem, 0, FifoDataFile::CP_MEM_SIZE * sizeof(u32));
+  cpMem[0x50] = VCD_LO_DIRECT_POSITION;
+
+  for (const std::vector<u8>& fifoData : frames)
+  {
+    FifoFrameInfo frame;
+    frame.fifoData = fifoData;
+    frame.fifoStart = 0;
+    frame.fifoEnd = static_cast<u32>(fifoData.size());
+    file->AddFrame(frame);
+  }
+  return file;
+}
+
+// Analyzes the frames one after another, carrying the CP state over, the way the analyzer did
+// before frames were analyzed in parallel.
+std::vector<AnalyzedFrameInfo> AnalyzeSerially(FifoDataFile* file)
+{
+  using namespace FifoAnalyzer;
+
+  s_CpMem = {};
+  for (u32 subCmd : {0x50, 0x60})
+    LoadCPReg(subCmd, file->GetCPMem()[subCmd], s_CpMem);
+  for (u32 i = 0; i < 8; ++i)
+  {
+    for (u32 subCmd : {0x70 + i, 0x80 + i, 0x90 + i})
+      LoadCPReg(subCmd, file->GetCPMem()[subCmd], s_CpMem);
+  }
+
+  std::vector<AnalyzedFrameInfo> frameInfo(file->GetFrameCount());
+  for (u32 frameIdx = 0; frameIdx < file->GetFrameCount(); ++frameIdx)
+  {
+    const std::vector<u8>& fifoData = file->GetFrame(frameIdx).fifoData;
+    AnalyzedFrameInfo& analyzed = frameInfo[frameIdx];
+    s_DrawingObject = false;
+
+    u32 cmdStart = 0;
+    while (cmdStart < fifoData.size())
+    {
+      const bool wasDrawing = s_DrawingObject;
+      const u32 cmdSize = AnalyzeCommand(&fifoData[cmdStart], DecodeMode::Playback);
+      if (cmdSize == 0)
+      {
+        analyzed.objectStarts.clear();
+        analyzed.objectEnds.clear();
+        return frameInfo;
+      }
+
+      if (wasDrawing != s_DrawingObject)
+      {
+        if (s_DrawingObject)
+          analyzed.objectStarts.push_back(cmdStart);
+        else
+          analyzed.objectEnds.push_back(cmdStart);
+      }
+      cmdStart += cmdSize;
+    }
+
+    if (analyzed.objectEnds.size() < analyzed.objectStarts.size())
+      analyzed.objectEnds.push_back(cmdStart);
+  }
+  return frameInfo;
+}
+
+void ExpectSameObjects(const std::vector<AnalyzedFrameInfo>& expected,
+                       const std::vector<AnalyzedFrameInfo>& actual)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    EXPECT_EQ(expected[i].objectStarts, actual[i].objectStarts) << "frame " << i;
+    EXPECT_EQ(expected[i].objectEnds, actual[i].objectEnds) << "frame " << i;
+  }
+}
+}  // namespace
+
+TEST(FifoPlaybackAnalyzer, MergesAdjacentAndOverlappingUpdates)
+{
+  const std::vector<MemoryUpdate> merged = FifoPlaybackAnalyzer::MergeMemoryUpdates({
+      MakeUpdate(0, 0x104, {5, 6}, MemoryUpdate::VERTEX_STREAM),
+      MakeUpdate(0, 0x100, {1, 2, 3, 4}),
+      MakeUpdate(0, 0x105, {7, 8, 9}),
+      MakeUpdate(0, 0x200, {10}),
+  });
+
+  ASSERT_EQ(2u, merged.size());
+  EXPECT_EQ(0x100u, merged[0].address);
+  EXPECT_EQ((std::vector<u8>{1, 2, 3, 4, 5, 7, 8, 9}), merged[0].data);
+  EXPECT_EQ(MemoryUpdate::TEXTURE_MAP | MemoryUpdate::VERTEX_STREAM, merged[0].type);
+  EXPECT_EQ(0x200u, merged[1].address);
+  EXPECT_EQ(std::vector<u8>{10}, merged[1].data);
+}
+
+TEST(FifoPlaybackAnalyzer, LaterUpdatesWin)
+{
+  const std::vector<MemoryUpdate> merged = FifoPlaybackAnalyzer::MergeMemoryUpdates({
+      MakeUpdate(0, 0x102, {1, 1}),
+      MakeUpdate(0, 0x100, {2, 2, 2, 2, 2, 2}),
+      MakeUpdate(0, 0x101, {3}),
+  });
+
+  ASSERT_EQ(1u, merged.size());
+  EXPECT_EQ(0x100u, merged[0].address);
+  EXPECT_EQ((std::vector<u8>{2, 3, 2, 2, 2, 2}), merged[0].data);
+}
+
+TEST(FifoPlaybackAnalyzer, KeepsUpdatesAtDifferentPositionsApart)
+{
+  const std::vector<MemoryUpdate> merged = FifoPlaybackAnalyzer::MergeMemoryUpdates({
+      MakeUpdate(0, 0x100, {1, 2}),
+      MakeUpdate(8, 0x102, {3, 4}),
+      MakeUpdate(8, 0x10000100, {5}),
+      MakeUpdate(8, 0x10000101, {6}),
+  });
+
+  ASSERT_EQ(3u, merged.size());
+  EXPECT_EQ(0u, merged[0].fifoPosition);
+  EXPECT_EQ((std::vector<u8>{1, 2}), merged[0].data);
+  EXPECT_EQ(8u, merged[1].fifoPosition);
+  EXPECT_EQ((std::vector<u8>{3, 4}), merged[1].data);
+  EXPECT_EQ(0x10000100u, merged[2].address);
+  EXPECT_EQ((std::vector<u8>{5, 6}), merged[2].data);
+}
+
+TEST(FifoPlaybackAnalyzer, FramesDependOnEarlierVertexState)
+{
+  std::vector<std::vector<u8>> frames(4);
+
+  // Draws with the initial VAT, then loads a bigger vertex format and draws with it.
+  Draw(frames[0], 0, 2, 2, 0x00);
+  LoadCPReg(frames[0], 0x70, VAT_G0_XYZ_FLOAT);
+  Draw(frames[0], 0, 1, 12, 0x00);
+  frames[0].push_back(OpcodeDecoder::GX_NOP);
+
+  // Draws with the VAT loaded by the previous frame. With the initial one, the vertex data would
+  // contain invalid opcodes.
+  Draw(frames[1], 0, 2, 12, 0x01);
+
+  // Loads a second VAT and draws with it, then draws with the VAT from frame 0 again. With the
+  // initial VAT, the vertex data would be read as NOPs.
+  LoadCPReg(frames[2], 0x71, VAT_G0_XYZ_U8);
+  Draw(frames[2], 1, 2, 3, 0x00);
+  LoadBPReg(frames[2]);
+  Draw(frames[2], 0, 1, 12, 0x00);
+
+  // Loads VAT 0 before using it, so it doesn't depend on the earlier frames.
+  LoadCPReg(frames[3], 0x70, 0);
+  Draw(frames[3], 0, 2, 2, 0x00);
+
+  const std::unique_ptr<FifoDataFile> file = CreateFile(frames);
+  std::vector<AnalyzedFrameInfo> frameInfo;
+  FifoPlaybackAnalyzer::AnalyzeFrames(file.get(), frameInfo);
+
+  ExpectSameObjects(AnalyzeSerially(file.get()), frameInfo);
+
+  ASSERT_EQ(4u, frameInfo.size());
+  EXPECT_EQ((std::vector<u32>{0}), frameInfo[1].objectStarts);
+  EXPECT_EQ((std::vector<u32>{3 + 2 * 12}), frameInfo[1].objectEnds);
+  EXPECT_EQ((std::vector<u32>{6, 6 + 3 + 6 + 5}), frameInfo[2].objectStarts);
+  EXPECT_EQ((std::vector<u32>{6 + 3 + 6, 6 + 3 + 6 + 5 + 3 + 12}), frameInfo[2].objectEnds);
+}
+
+TEST(FifoPlaybackAnalyzer, ErrorClearsLaterFrames)
+{
+  std::vector<std::vector<u8>> frames(3);
+
+  LoadCPReg(frames[0], 0x70, VAT_G0_XYZ_FLOAT);
+  Draw(frames[0], 0, 1, 12, 0x00);
+
+  // A draw with the VAT loaded by frame 0, followed by an invalid opcode.
+  Draw(frames[1], 0, 1, 12, 0x00);
+  frames[1].push_back(OpcodeDecoder::GX_UNKNOWN_RESET);
+
+  Draw(frames[2], 0, 1, 12, 0x00);
+
+  const std::unique_ptr<FifoDataFile> file = CreateFile(frames);
+  std::vector<AnalyzedFrameInfo> frameInfo;
+  FifoPlaybackAnalyzer::AnalyzeFrames(file.get(), frameInfo);
+
+  ExpectSameObjects(AnalyzeSerially(file.get()), frameInfo);
+
+  ASSERT_EQ(3u, frameInfo.size());
+  EXPECT_EQ((std::vector<u32>{6}), frameInfo[0].objectStarts);
+  for (u32 i = 1; i < 3; ++i)
+  {
+    EXPECT_TRUE(frameInfo[i].objectStarts.empty()) << "frame " << i;
+    EXPECT_TRUE(frameInfo[i].objectEnds.empty()) << "frame " << i;
+  }
+}
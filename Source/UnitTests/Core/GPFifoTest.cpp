@@ -0,0 +1,181 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/ConfigLoaders/BaseConfigLoader.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/GPFifo.h"
+#include "Core/HW/MMIO.h"
+#include "Core/HW/Memmap.h"
+#include "Core/HW/ProcessorInterface.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "UICommon/UICommon.h"
+#include "VideoCommon/CommandProcessor.h"
+
+namespace
+{
+constexpr u32 FIFO_BASE = 0x00200000;
+constexpr u32 FIFO_SIZE = 0x10000;
+// Fifo_CPUEnd points at the last burst of the FIFO, not past it.
+constexpr u32 FIFO_END = FIFO_BASE + FIFO_SIZE - GPFifo::GATHER_PIPE_SIZE;
+
+class ScopeInit final
+{
+public:
+  ScopeInit() : m_profile_path(File::CreateTempDir())
+  {
+    Core::DeclareAsCPUThread();
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    Config::AddLayer(ConfigLoaders::GenerateBaseConfigLoader());
+    SConfig::Init();
+    // The GPU thread isn't running, waking it up only sets a flag.
+    SConfig::GetInstance().bCPUThread = true;
+    SConfig::GetInstance().bSyncGPU = false;
+    PowerPC::Init(PowerPC::CPUCore::Interpreter);
+    CoreTiming::Init();
+    Memory::Init();
+    CommandProcessor::Init();
+    GPFifo::Init();
+
+    // Link the CPU FIFO to the GPU FIFO, like games do for immediate mode rendering.
+    CommandProcessor::fifo.CPBase = FIFO_BASE;
+    CommandProcessor::fifo.CPEnd = FIFO_END;
+    CommandProcessor::fifo.CPWritePointer = FIFO_BASE;
+    CommandProcessor::fifo.CPHiWatermark = FIFO_SIZE;
+    ProcessorInterface::Fifo_CPUBase = FIFO_BASE;
+    ProcessorInterface::Fifo_CPUEnd = FIFO_END;
+    ProcessorInterface::Fifo_CPUWritePointer = FIFO_BASE;
+    CommandProcessor::UCPCtrlReg ctrl;
+    ctrl.GPReadEnable = 1;
+    ctrl.GPLinkEnable = 1;
+    Memory::mmio_mapping->Write<u16>(0x0C000000 | CommandProcessor::CTRL_REGISTER, ctrl.Hex);
+  }
+  ~ScopeInit()
+  {
+    Memory::Shutdown();
+    CoreTiming::Shutdown();
+    PowerPC::Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+private:
+  std::string m_profile_path;
+};
+
+void SetWritePointer(u32 address)
+{
+  CommandProcessor::fifo.CPWritePointer = address;
+  ProcessorInterface::Fifo_CPUWritePointer = address;
+}
+
+// Pretends the GPU has consumed everything that was written so far.
+void DrainFifo()
+{
+  CommandProcessor::fifo.CPReadWriteDistance = 0;
+}
+
+void WriteBursts(u32 bursts, u8 first_value)
+{
+  for (u32 i = 0; i < bursts; ++i)
+  {
+    for (u32 j = 0; j < GPFifo::GATHER_PIPE_SIZE; ++j)
+      GPFifo::FastWrite8(static_cast<u8>(first_value + i));
+  }
+}
+}  // namespace
+
+TEST(GPFifo, SingleBurst)
+{
+  ScopeInit guard;
+  WriteBursts(1, 0x10);
+  GPFifo::FastWrite8(0x77);
+  GPFifo::UpdateGatherPipe();
+
+  EXPECT_EQ(0x10, Memory::Read_U8(FIFO_BASE));
+  EXPECT_EQ(0x10, Memory::Read_U8(FIFO_BASE + GPFifo::GATHER_PIPE_SIZE - 1));
+  EXPECT_EQ(FIFO_BASE + GPFifo::GATHER_PIPE_SIZE, ProcessorInterface::Fifo_CPUWritePointer);
+  EXPECT_EQ(FIFO_BASE + GPFifo::GATHER_PIPE_SIZE, CommandProcessor::fifo.CPWritePointer);
+  EXPECT_EQ(GPFifo::GATHER_PIPE_SIZE, CommandProcessor::fifo.CPReadWriteDistance);
+
+  // The spilled byte stays in the gather pipe.
+  EXPECT_FALSE(GPFifo::IsEmpty());
+  WriteBursts(1, 0x20);
+  GPFifo::UpdateGatherPipe();
+  EXPECT_EQ(0x77, Memory::Read_U8(FIFO_BASE + GPFifo::GATHER_PIPE_SIZE));
+  EXPECT_EQ(0x20, Memory::Read_U8(FIFO_BASE + GPFifo::GATHER_PIPE_SIZE + 1));
+  EXPECT_FALSE(GPFifo::IsEmpty());
+}
+
+TEST(GPFifo, BulkFlushWrapsAtFifoEnd)
+{
+  ScopeInit guard;
+  SetWritePointer(FIFO_END - GPFifo::GATHER_PIPE_SIZE);
+  WriteBursts(4, 0x10);
+  GPFifo::UpdateGatherPipe();
+
+  // The burst at the end of the FIFO is still written, the one after it goes to the base.
+  EXPECT_EQ(0x10, Memory::Read_U8(FIFO_END - GPFifo::GATHER_PIPE_SIZE));
+  EXPECT_EQ(0x11, Memory::Read_U8(FIFO_END));
+  EXPECT_EQ(0x12, Memory::Read_U8(FIFO_BASE));
+  EXPECT_EQ(0x13, Memory::Read_U8(FIFO_BASE + GPFifo::GATHER_PIPE_SIZE));
+  EXPECT_EQ(FIFO_BASE + 2 * GPFifo::GATHER_PIPE_SIZE, ProcessorInterface::Fifo_CPUWritePointer);
+  EXPECT_EQ(FIFO_BASE + 2 * GPFifo::GATHER_PIPE_SIZE, CommandProcessor::fifo.CPWritePointer);
+  EXPECT_EQ(4 * GPFifo::GATHER_PIPE_SIZE, CommandProcessor::fifo.CPReadWriteDistance);
+  EXPECT_TRUE(GPFifo::IsEmpty());
+}
+
+// Measures gather pipe flushes for the burst sizes a FIFO-heavy game produces: single bursts
+// from the JIT's per-store checks and multiple bursts from delayed checks. The pipe is filled
+// through gather_pipe_ptr like JIT code does, and the best of several runs is reported.
+// Run with --gtest_also_run_disabled_tests.
+TEST(GPFifo, DISABLED_Benchmark)
+{
+  ScopeInit guard;
+  constexpr u32 TOTAL_BURSTS = 1 << 22;
+  constexpr int RUNS = 5;
+  u8 data[GPFifo::GATHER_PIPE_SIZE * 15];
+  for (size_t i = 0; i < sizeof(data); ++i)
+    data[i] = static_cast<u8>(i);
+
+  for (u32 bursts : {1u, 2u, 4u, 8u, 15u})
+  {
+    const u32 iterations = TOTAL_BURSTS / bursts;
+    const u32 size = bursts * GPFifo::GATHER_PIPE_SIZE;
+    double best = 0;
+    for (int run = 0; run < RUNS; ++run)
+    {
+      SetWritePointer(FIFO_BASE);
+      DrainFifo();
+      const auto start = std::chrono::steady_clock::now();
+      for (u32 i = 0; i < iterations; ++i)
+      {
+        std::memcpy(PowerPC::ppcState.gather_pipe_ptr, data, size);
+        PowerPC::ppcState.gather_pipe_ptr += size;
+        GPFifo::UpdateGatherPipe();
+        DrainFifo();
+      }
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      if (run == 0 || elapsed.count() < best)
+        best = elapsed.count();
+    }
+
+    std::printf("%2u bursts per flush: %7.2f ns per flush, %6.2f ns per burst\n", bursts,
+                best / iterations * 1e9, best / TOTAL_BURSTS * 1e9);
+  }
+}
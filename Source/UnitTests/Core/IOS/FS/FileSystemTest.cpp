@@ -258,6 +258,47 @@ TEST_F(FileSystemTest, GetDirectoryStats)
   // check_stats(1u, 2u);
 }
 
+TEST_F(FileSystemTest, MetadataPersistedOnFlush)
+{
+  const std::string PATH = "/tmp/d";
+
+  constexpr u8 ArbitraryAttribute = 0x20;
+  constexpr Modes directory_modes{Mode::ReadWrite, Mode::Read, Mode::None};
+
+  const Result<DirectoryStats> empty_stats = m_fs->GetDirectoryStats("/tmp");
+  ASSERT_TRUE(empty_stats.Succeeded());
+
+  ASSERT_EQ(m_fs->CreateDirectory(Uid{0}, Gid{0}, PATH, ArbitraryAttribute, directory_modes),
+            ResultCode::Success);
+
+  // The new directory is counted right away, even though the FST hasn't been written yet.
+  const Result<DirectoryStats> dir_stats = m_fs->GetDirectoryStats("/tmp");
+  ASSERT_TRUE(dir_stats.Succeeded());
+  EXPECT_EQ(dir_stats->used_inodes, empty_stats->used_inodes + 1);
+
+  // A second instance only sees the metadata through the FST that was written to disk.
+  {
+    const std::unique_ptr<FileSystem> other_fs = MakeFileSystem();
+    const Result<Metadata> stats = other_fs->GetMetadata(Uid{0}, Gid{0}, PATH);
+    ASSERT_TRUE(stats.Succeeded());
+    EXPECT_NE(stats->attribute, ArbitraryAttribute);
+  }
+
+  m_fs->Flush();
+
+  const std::unique_ptr<FileSystem> other_fs = MakeFileSystem();
+  const Result<Metadata> stats = other_fs->GetMetadata(Uid{0}, Gid{0}, PATH);
+  ASSERT_TRUE(stats.Succeeded());
+  EXPECT_EQ(stats->modes, directory_modes);
+  EXPECT_EQ(stats->attribute, ArbitraryAttribute);
+
+  // Flushing also drops the cached directory stats, so files added on the host are counted.
+  ASSERT_TRUE(File::CreateEmptyFile(File::GetUserPath(D_SESSION_WIIROOT_IDX) + "/tmp/host"));
+  const Result<DirectoryStats> host_stats = m_fs->GetDirectoryStats("/tmp");
+  ASSERT_TRUE(host_stats.Succeeded());
+  EXPECT_EQ(host_stats->used_inodes, dir_stats->used_inodes + 1);
+}
+
 // Files need to be explicitly created using CreateFile or CreateDirectory.
 // Automatically creating them on first use would be a bug.
 TEST_F(FileSystemTest, NonExistingFiles)
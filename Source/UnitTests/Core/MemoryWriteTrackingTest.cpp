@@ -0,0 +1,112 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Swap.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/ConfigLoaders/BaseConfigLoader.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/DSPHLE/UCodes/UCodes.h"
+#include "Core/HW/Memmap.h"
+#include "Core/MemTools.h"
+#include "UICommon/UICommon.h"
+
+namespace
+{
+// Two pages of MEM1, like the memory of a texture that the texture cache has hashed.
+constexpr u32 TEXTURE_ADDRESS = 0x00100000;
+constexpr u32 TEXTURE_SIZE = 0x2000;
+
+class ScopeInit final
+{
+public:
+  ScopeInit() : m_profile_path(File::CreateTempDir())
+  {
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    Config::AddLayer(ConfigLoaders::GenerateBaseConfigLoader());
+    SConfig::Init();
+    Config::SetBase(Config::GFX_HACK_TRACK_TEXTURE_WRITES, true);
+    Memory::Init();
+  }
+  ~ScopeInit()
+  {
+    Memory::Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+private:
+  std::string m_profile_path;
+};
+}  // namespace
+
+TEST(MemoryWriteTracking, UnwrittenTextureKeepsItsHash)
+{
+  ScopeInit guard;
+  const u64 stamp = Memory::WatchForWrites(TEXTURE_ADDRESS, TEXTURE_SIZE);
+  // Write tracking is disabled on hosts whose pages aren't 4 KiB.
+  if (stamp == 0)
+    return;
+
+  Memory::Write_U32(0x12345678, TEXTURE_ADDRESS + TEXTURE_SIZE);
+  Memory::Write_U32(0x12345678, TEXTURE_ADDRESS - 4);
+
+  EXPECT_FALSE(Memory::HasBeenWrittenSince(TEXTURE_ADDRESS, TEXTURE_SIZE, stamp));
+}
+
+TEST(MemoryWriteTracking, PointerWriteRehashesTexture)
+{
+  ScopeInit guard;
+  const u64 stamp = Memory::WatchForWrites(TEXTURE_ADDRESS, TEXTURE_SIZE);
+  // Write tracking is disabled on hosts whose pages aren't 4 KiB.
+  if (stamp == 0)
+    return;
+
+  // DSP HLE writes go straight to the pointer into RAM instead of through the MMU.
+  DSP::HLE::HLEMemory_Write_U32(0x80000000 | (TEXTURE_ADDRESS + 0x1000), 0x12345678);
+
+  EXPECT_EQ(0x12345678u, Memory::Read_U32(TEXTURE_ADDRESS + 0x1000));
+  EXPECT_TRUE(Memory::HasBeenWrittenSince(TEXTURE_ADDRESS, TEXTURE_SIZE, stamp));
+  EXPECT_FALSE(Memory::HasBeenWrittenSince(TEXTURE_ADDRESS, 0x1000, stamp));
+
+  // Watching again, as the texture cache does after rehashing, resets the state.
+  const u64 new_stamp = Memory::WatchForWrites(TEXTURE_ADDRESS, TEXTURE_SIZE);
+  EXPECT_FALSE(Memory::HasBeenWrittenSince(TEXTURE_ADDRESS, TEXTURE_SIZE, new_stamp));
+}
+
+TEST(MemoryWriteTracking, FastmemStoreRehashesTexture)
+{
+  ScopeInit guard;
+  // Not every host can set up the fastmem arena.
+  if (!Memory::InitFastmemArena())
+  {
+    Memory::ShutdownFastmemArena();
+    return;
+  }
+  EMM::InstallExceptionHandler();
+
+  const u64 stamp = Memory::WatchForWrites(TEXTURE_ADDRESS, TEXTURE_SIZE);
+  if (stamp != 0)
+  {
+    // JIT code stores straight to the arena, where the watched pages are write protected. The
+    // fault handler has to record the write and let the store through.
+    *reinterpret_cast<volatile u32*>(Memory::physical_base + TEXTURE_ADDRESS + 0x1000) =
+        Common::swap32(0x12345678);
+
+    EXPECT_EQ(0x12345678u, Memory::Read_U32(TEXTURE_ADDRESS + 0x1000));
+    EXPECT_TRUE(Memory::HasBeenWrittenSince(TEXTURE_ADDRESS, TEXTURE_SIZE, stamp));
+    EXPECT_FALSE(Memory::HasBeenWrittenSince(TEXTURE_ADDRESS, 0x1000, stamp));
+  }
+
+  EMM::UninstallExceptionHandler();
+  Memory::ShutdownFastmemArena();
+}
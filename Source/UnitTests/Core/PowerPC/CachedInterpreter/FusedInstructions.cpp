@@ -0,0 +1,192 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/ConfigLoaders/BaseConfigLoader.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/CPU.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/CPUCoreBase.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "UICommon/UICommon.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr u32 CODE_START = 0x00003000;
+
+class ScopeInit final
+{
+public:
+  explicit ScopeInit(PowerPC::CPUCore core) : m_profile_path(File::CreateTempDir())
+  {
+    Core::DeclareAsCPUThread();
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    Config::AddLayer(ConfigLoaders::GenerateBaseConfigLoader());
+    SConfig::Init();
+    SConfig::GetInstance().bFastmem = false;
+    Memory::Init();
+    CPU::Init(core);
+    CoreTiming::Init();
+  }
+  ~ScopeInit()
+  {
+    CoreTiming::Shutdown();
+    CPU::Shutdown();
+    Memory::Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+private:
+  std::string m_profile_path;
+};
+
+void LoadCode(const std::vector<u32>& code)
+{
+  for (size_t i = 0; i < code.size(); ++i)
+    Memory::Write_U32(code[i], static_cast<u32>(CODE_START + i * 4));
+  JitInterface::ClearCache();
+
+  PowerPC::ppcState.msr.Hex = 0;
+  PowerPC::ppcState.pc = CODE_START;
+  PowerPC::ppcState.npc = CODE_START;
+}
+
+struct CompareAndBranchCase
+{
+  const char* name;
+  u32 compare;
+  u32 branch;
+  u32 a;
+  u32 b;
+  bool summary_overflow;
+  bool taken;
+  u32 cr_field;
+  u32 expected_cr;
+};
+
+// The compares use r3 and r4 (or an immediate of 0x10). The branches skip ahead by 12 bytes.
+constexpr CompareAndBranchCase COMPARE_AND_BRANCH_CASES[] = {
+    {"cmpwi+blt", 0x2C030010, 0x4180000C, u32(-1), 0, false, true, 0, 0x8},
+    {"cmplwi+blt", 0x28030010, 0x4180000C, u32(-1), 0, false, false, 0, 0x4},
+    {"cmpw+bne", 0x7C032000, 0x4082000C, 5, 5, false, false, 0, 0x2},
+    {"cmpw+bge", 0x7C032000, 0x4080000C, u32(-2), 1, false, false, 0, 0x8},
+    {"cmplw+bge", 0x7C032040, 0x4080000C, u32(-2), 1, false, true, 0, 0x4},
+    {"cmpw cr1+bgt cr1", 0x7C832000, 0x4185000C, 3, 2, false, true, 1, 0x4},
+    {"cmpwi+beq with SO", 0x2C030010, 0x4182000C, 0x10, 0, true, true, 0, 0x3},
+    // Branches on a different CR field than the compare wrote aren't fused.
+    {"cmpw cr1+beq cr0", 0x7C832000, 0x4182000C, 3, 3, false, false, 1, 0x2},
+};
+
+void RunCompareAndBranch(const CompareAndBranchCase& c)
+{
+  LoadCode({
+      c.compare,
+      c.branch,
+      0x38A00001,  // li r5, 1
+      0x48000008,  // b +8
+      0x38A00002,  // li r5, 2
+      0x48000000,  // b 0
+  });
+  PowerPC::ppcState.gpr[3] = c.a;
+  PowerPC::ppcState.gpr[4] = c.b;
+  PowerPC::ppcState.gpr[5] = 0;
+  PowerPC::ppcState.cr.Set(0);
+  PowerPC::ppcState.xer_so_ov = c.summary_overflow ? 2 : 0;
+
+  // Every call runs at least one block, and the code ends in an infinite loop.
+  for (int i = 0; i < 8; ++i)
+    PowerPC::SingleStep();
+}
+
+void CheckCompareAndBranch(PowerPC::CPUCore core)
+{
+  ScopeInit guard(core);
+  for (const CompareAndBranchCase& c : COMPARE_AND_BRANCH_CASES)
+  {
+    RunCompareAndBranch(c);
+    EXPECT_EQ(c.taken ? 2u : 1u, PowerPC::ppcState.gpr[5]) << c.name;
+    EXPECT_EQ(c.expected_cr, PowerPC::ppcState.cr.GetField(c.cr_field)) << c.name;
+    EXPECT_EQ(CODE_START + 0x14, PowerPC::ppcState.pc) << c.name;
+  }
+}
+
+void StopCPU(u64, s64)
+{
+  CPU::Break();
+}
+}  // namespace
+
+TEST(CachedInterpreter, CompareAndBranch)
+{
+  CheckCompareAndBranch(PowerPC::CPUCore::CachedInterpreter);
+}
+
+// The same cases on the Interpreter, which doesn't fuse anything, to check the expectations.
+TEST(CachedInterpreter, CompareAndBranchMatchesInterpreter)
+{
+  CheckCompareAndBranch(PowerPC::CPUCore::Interpreter);
+}
+
+// Compares the speed of the CPU cores on a loop that mixes fused, predecoded and plain
+// Interpreter instructions. The best of several runs is reported.
+// Run with --gtest_also_run_disabled_tests.
+TEST(CachedInterpreter, DISABLED_Benchmark)
+{
+  constexpr s64 CYCLES = 100000000;
+  constexpr int RUNS = 5;
+
+  for (PowerPC::CPUCore core : {PowerPC::CPUCore::Interpreter,
+                                PowerPC::CPUCore::CachedInterpreter, PowerPC::CPUCore::JIT64})
+  {
+    ScopeInit guard(core);
+    CoreTiming::EventType* stop = CoreTiming::RegisterEvent("StopCPU", StopCPU);
+    double best = 0;
+    for (int run = 0; run < RUNS; ++run)
+    {
+      LoadCode({
+          0x38600000,  // li r3, 0
+          0x38C00000,  // li r6, 0
+          0x38630001,  // addi r3, r3, 1
+          0x38C60001,  // addi r6, r6, 1
+          0x5465103A,  // rlwinm r5, r3, 2, 0, 29
+          0x7C842A14,  // add r4, r4, r5
+          0x280303E8,  // cmplwi r3, 1000
+          0x4180FFEC,  // blt -20
+          0x38600000,  // li r3, 0
+          0x4BFFFFE4,  // b -28
+      });
+
+      CoreTiming::ScheduleEvent(CYCLES, stop);
+      CPU::EnableStepping(false);
+      const auto start = std::chrono::steady_clock::now();
+      PowerPC::RunLoop();
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+      const double ns_per_iteration = elapsed.count() / PowerPC::ppcState.gpr[6] * 1e9;
+      if (run == 0 || ns_per_iteration < best)
+        best = ns_per_iteration;
+    }
+
+    std::printf("%-20s %7.2f ns per loop iteration\n",
+                core == PowerPC::CPUCore::Interpreter ? "Interpreter" :
+                                                        JitInterface::GetCore()->GetName(),
+                best);
+  }
+}
@@ -0,0 +1,151 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigLoaders/BaseConfigLoader.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/CPUCoreBase.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/Profiler.h"
+#include "UICommon/UICommon.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr u32 LOOP_START = 0x00003000;
+
+class ScopeInit final
+{
+public:
+  explicit ScopeInit(bool follow_branch) : m_profile_path(File::CreateTempDir())
+  {
+    Core::DeclareAsCPUThread();
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    Config::AddLayer(ConfigLoaders::GenerateBaseConfigLoader());
+    SConfig::Init();
+    Config::SetBase(Config::MAIN_JIT_TIERED_COMPILATION, true);
+    SConfig::GetInstance().bJITFollowBranch = follow_branch;
+    SConfig::GetInstance().bFastmem = false;
+    Memory::Init();
+    PowerPC::Init(PowerPC::CPUCore::JIT64);
+    CoreTiming::Init();
+    JitInterface::SetProfilingState(JitInterface::ProfilingState::Enabled);
+  }
+  ~ScopeInit()
+  {
+    CoreTiming::Shutdown();
+    PowerPC::Shutdown();
+    Memory::Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+private:
+  std::string m_profile_path;
+};
+
+// Runs the given code in real mode for the given number of timing slices.
+void RunCode(const std::vector<u32>& code, int slices)
+{
+  for (size_t i = 0; i < code.size(); ++i)
+    Memory::Write_U32(code[i], static_cast<u32>(LOOP_START + i * 4));
+
+  PowerPC::ppcState.msr.Hex = 0;
+  PowerPC::ppcState.pc = LOOP_START;
+  PowerPC::ppcState.npc = LOOP_START;
+
+  // The CPU isn't in the running state, so every call returns after one slice.
+  for (int i = 0; i < slices; ++i)
+    JitInterface::GetCore()->Run();
+}
+
+u32 RunCountingLoop(int slices)
+{
+  RunCode(
+      {
+          0x38600000,  // li r3, 0
+          0x38630001,  // addi r3, r3, 1
+          0x4BFFFFFC,  // b -4
+      },
+      slices);
+  return PowerPC::ppcState.gpr[3];
+}
+}  // namespace
+
+TEST(TieredCompilation, HotBlockIsRecompiledAndUsed)
+{
+  ScopeInit guard(true);
+  ASSERT_NE(nullptr, JitInterface::GetCore());
+
+  const u32 iterations = RunCountingLoop(4);
+
+  Profiler::ProfileStats stats;
+  JitInterface::GetProfileResults(&stats);
+  EXPECT_EQ(1u, stats.tier_up_count);
+
+  // The first-tier block was destroyed on tier-up, so any runs left on the loop block come from
+  // the recompiled one.
+  const auto loop_block =
+      std::find_if(stats.block_stats.begin(), stats.block_stats.end(),
+                   [](const Profiler::BlockStat& stat) { return stat.addr == LOOP_START + 4; });
+  ASSERT_NE(stats.block_stats.end(), loop_block);
+  EXPECT_GT(loop_block->run_count, 0u);
+
+  // The loop kept counting across the recompile.
+  EXPECT_GT(iterations, 1000u);
+}
+
+TEST(TieredCompilation, DisabledWithoutBranchFollowing)
+{
+  ScopeInit guard(false);
+  ASSERT_NE(nullptr, JitInterface::GetCore());
+
+  RunCountingLoop(4);
+
+  Profiler::ProfileStats stats;
+  JitInterface::GetProfileResults(&stats);
+  EXPECT_EQ(0u, stats.tier_up_count);
+}
+
+TEST(TieredCompilation, TracedBranchKeepsSideExit)
+{
+  ScopeInit guard(true);
+  ASSERT_NE(nullptr, JitInterface::GetCore());
+
+  // The bne is taken for the first 5000 iterations, so the hot tier traces through it. The not
+  // taken path still has to run through the side exit once r3 reaches 0. The b +4 keeps the
+  // loop out of the first block.
+  RunCode(
+      {
+          0x3860EC78,  // li r3, -5000
+          0x48000004,  // b +4
+          0x38630001,  // addi r3, r3, 1
+          0x2C030000,  // cmpwi r3, 0
+          0x40820008,  // bne +8
+          0x38800001,  // li r4, 1
+          0x4BFFFFF0,  // b -16
+      },
+      8);
+
+  Profiler::ProfileStats stats;
+  JitInterface::GetProfileResults(&stats);
+  EXPECT_GE(stats.tier_up_count, 1u);
+  EXPECT_GT(static_cast<s32>(PowerPC::ppcState.gpr[3]), 0);
+  EXPECT_EQ(1u, PowerPC::ppcState.gpr[4]);
+}
@@ -0,0 +1,129 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/PowerPC/JitCommon/JitProfileCache.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "UICommon/UICommon.h"
+
+namespace
+{
+constexpr char GAME_ID[] = "GTEST1";
+constexpr u32 ADDRESS = 0x80003100;
+constexpr u32 INSTRUCTION = 0x90030000;          // stw r0, 0(r3)
+constexpr u32 CHANGED_INSTRUCTION = 0x38600000;  // li r3, 0
+
+class ScopeInit final
+{
+public:
+  ScopeInit() : m_profile_path(File::CreateTempDir())
+  {
+    UICommon::SetUserDirectory(m_profile_path);
+  }
+  ~ScopeInit() { File::DeleteDirRecursively(m_profile_path); }
+
+private:
+  std::string m_profile_path;
+};
+
+std::vector<JitInterface::ExceptionType> Load(JitProfileCache& cache, u32 address,
+                                              u32 instruction)
+{
+  std::vector<JitInterface::ExceptionType> types;
+  cache.Load(address, [&] { return instruction; },
+             [&](JitInterface::ExceptionType type) { types.push_back(type); });
+  // Entries at the same address are applied in no particular order.
+  std::sort(types.begin(), types.end());
+  return types;
+}
+}  // namespace
+
+TEST(JitProfileCache, RecordedEntriesAreLoadedInTheNextSession)
+{
+  ScopeInit guard;
+  JitProfileCache cache;
+
+  cache.Open(GAME_ID);
+  cache.Record(JitInterface::ExceptionType::FIFOWrite, ADDRESS, INSTRUCTION);
+  cache.Record(JitInterface::ExceptionType::PairedQuantize, ADDRESS, INSTRUCTION);
+  cache.Close();
+
+  cache.Open(GAME_ID);
+  EXPECT_EQ((std::vector<JitInterface::ExceptionType>{
+                JitInterface::ExceptionType::FIFOWrite,
+                JitInterface::ExceptionType::PairedQuantize,
+            }),
+            Load(cache, ADDRESS, INSTRUCTION));
+  EXPECT_TRUE(Load(cache, ADDRESS + 4, INSTRUCTION).empty());
+
+  // The entries at an address are forgotten once they've been loaded.
+  EXPECT_TRUE(Load(cache, ADDRESS, INSTRUCTION).empty());
+  cache.Close();
+
+  // Other games don't see them.
+  cache.Open("GTEST2");
+  EXPECT_TRUE(Load(cache, ADDRESS, INSTRUCTION).empty());
+  cache.Close();
+}
+
+TEST(JitProfileCache, EntriesForChangedCodeAreNotApplied)
+{
+  ScopeInit guard;
+  JitProfileCache cache;
+
+  cache.Open(GAME_ID);
+  cache.Record(JitInterface::ExceptionType::FIFOWrite, ADDRESS, INSTRUCTION);
+  cache.Close();
+
+  cache.Open(GAME_ID);
+  EXPECT_TRUE(Load(cache, ADDRESS, CHANGED_INSTRUCTION).empty());
+  cache.Close();
+}
+
+TEST(JitProfileCache, DuplicatesAreOnlySavedOnce)
+{
+  ScopeInit guard;
+  JitProfileCache cache;
+
+  cache.Open(GAME_ID);
+  cache.Record(JitInterface::ExceptionType::FIFOWrite, ADDRESS, INSTRUCTION);
+  cache.Record(JitInterface::ExceptionType::FIFOWrite, ADDRESS, INSTRUCTION);
+  cache.Close();
+
+  // Entries loaded from the file count as recorded as well.
+  cache.Open(GAME_ID);
+  cache.Record(JitInterface::ExceptionType::FIFOWrite, ADDRESS, INSTRUCTION);
+  cache.Close();
+
+  cache.Open(GAME_ID);
+  EXPECT_EQ(1u, Load(cache, ADDRESS, INSTRUCTION).size());
+  cache.Close();
+}
+
+TEST(JitProfileCache, EntryIsRecordedAgainAfterCodeChanged)
+{
+  ScopeInit guard;
+  JitProfileCache cache;
+
+  cache.Open(GAME_ID);
+  cache.Record(JitInterface::ExceptionType::FIFOWrite, ADDRESS, INSTRUCTION);
+  cache.Close();
+
+  // Different code at the same address needs the same exception check.
+  cache.Open(GAME_ID);
+  cache.Record(JitInterface::ExceptionType::FIFOWrite, ADDRESS, CHANGED_INSTRUCTION);
+  cache.Close();
+
+  cache.Open(GAME_ID);
+  EXPECT_EQ((std::vector<JitInterface::ExceptionType>{JitInterface::ExceptionType::FIFOWrite}),
+            Load(cache, ADDRESS, CHANGED_INSTRUCTION));
+  cache.Close();
+}
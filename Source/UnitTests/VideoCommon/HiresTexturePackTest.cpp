@@ -0,0 +1,183 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "VideoCommon/HiresTexturePack.h"
+
+class HiresTexturePackTest : public testing::Test
+{
+protected:
+  HiresTexturePackTest() : m_directory{File::CreateTempDir()}
+  {
+    File::CreateFullPath(m_directory + "/textures/sub/");
+    WriteTexture("textures/tex1_64x64_0123456789abcdef_5.png", std::string(5000, 'a'));
+    WriteTexture("textures/sub/tex1_32x32_m_fedcba9876543210_14_arb.dds", "DDS data");
+    WriteTexture("textures/sub/tex1_32x32_m_fedcba9876543210_14_mip1.dds", "mip level 1");
+    WriteTexture("textures/readme.png", "not a texture");
+  }
+
+  ~HiresTexturePackTest() override { File::DeleteDirRecursively(m_directory); }
+
+  void WriteTexture(const std::string& path, const std::string& contents)
+  {
+    m_contents[path.substr(path.rfind('/') + 1)] = contents;
+    File::WriteStringToFile(m_directory + "/" + path, contents);
+  }
+
+  std::unique_ptr<HiresTexturePack> CreatePack(int compression_level)
+  {
+    const std::string path = m_directory + "/pack.dtp";
+    const auto files = HiresTexturePack::FindTextureFiles(m_directory + "/textures");
+    std::string error_message;
+    if (!HiresTexturePack::Create(path, files, compression_level, &error_message))
+      return nullptr;
+    return HiresTexturePack::Open(path);
+  }
+
+  void CheckPack(HiresTexturePack* pack)
+  {
+    ASSERT_NE(nullptr, pack);
+    EXPECT_EQ(3u, pack->GetEntries().size());
+    EXPECT_EQ(nullptr, pack->Find("readme"));
+    EXPECT_EQ(nullptr, pack->Find("tex1_64x64_0123456789abcdef_6"));
+
+    const HiresTexturePack::Entry* png = pack->Find("tex1_64x64_0123456789abcdef_5");
+    ASSERT_NE(nullptr, png);
+    EXPECT_EQ(0, png->flags);
+    EXPECT_EQ(0u, png->data_offset % 4096);
+    std::vector<u8> data;
+    ASSERT_TRUE(pack->ReadData(*png, &data));
+    EXPECT_EQ(m_contents["tex1_64x64_0123456789abcdef_5.png"],
+              std::string(data.begin(), data.end()));
+
+    const HiresTexturePack::Entry* dds = pack->Find("tex1_32x32_m_fedcba9876543210_14");
+    ASSERT_NE(nullptr, dds);
+    EXPECT_EQ(HiresTexturePack::ENTRY_FLAG_DDS | HiresTexturePack::ENTRY_FLAG_ARBITRARY_MIPMAPS,
+              dds->flags);
+    ASSERT_TRUE(pack->ReadData(*dds, &data));
+    EXPECT_EQ(m_contents["tex1_32x32_m_fedcba9876543210_14_arb.dds"],
+              std::string(data.begin(), data.end()));
+
+    const HiresTexturePack::Entry* mip = pack->Find("tex1_32x32_m_fedcba9876543210_14_mip1");
+    ASSERT_NE(nullptr, mip);
+    EXPECT_EQ(HiresTexturePack::ENTRY_FLAG_DDS, mip->flags);
+  }
+
+  std::string m_directory;
+  std::map<std::string, std::string> m_contents;
+};
+
+TEST_F(HiresTexturePackTest, Uncompressed)
+{
+  std::unique_ptr<HiresTexturePack> pack = CreatePack(0);
+  CheckPack(pack.get());
+  for (const HiresTexturePack::Entry& entry : pack->GetEntries())
+    EXPECT_EQ(HiresTexturePack::Compression::None, entry.compression);
+}
+
+TEST_F(HiresTexturePackTest, Compressed)
+{
+  std::unique_ptr<HiresTexturePack> pack = CreatePack(3);
+  CheckPack(pack.get());
+
+  // Only the texture that gets smaller is stored compressed.
+  const HiresTexturePack::Entry* png = pack->Find("tex1_64x64_0123456789abcdef_5");
+  EXPECT_EQ(HiresTexturePack::Compression::Zstd, png->compression);
+  EXPECT_LT(png->data_size, png->uncompressed_size);
+  const HiresTexturePack::Entry* dds = pack->Find("tex1_32x32_m_fedcba9876543210_14");
+  EXPECT_EQ(HiresTexturePack::Compression::None, dds->compression);
+}
+
+TEST_F(HiresTexturePackTest, RejectsInvalidFiles)
+{
+  const std::string path = m_directory + "/invalid.dtp";
+  File::WriteStringToFile(path, "not a texture pack");
+  EXPECT_EQ(nullptr, HiresTexturePack::Open(path));
+  EXPECT_EQ(nullptr, HiresTexturePack::Open(m_directory + "/missing.dtp"));
+
+  // Truncate a valid pack in the middle of its index.
+  ASSERT_NE(nullptr, CreatePack(0));
+  std::string contents;
+  File::ReadFileToString(m_directory + "/pack.dtp", contents);
+  File::WriteStringToFile(path, contents.substr(0, 40));
+  EXPECT_EQ(nullptr, HiresTexturePack::Open(path));
+}
+
+TEST_F(HiresTexturePackTest, ConcurrentReads)
+{
+  std::unique_ptr<HiresTexturePack> pack = CreatePack(3);
+  ASSERT_NE(nullptr, pack);
+  const HiresTexturePack::Entry* png = pack->Find("tex1_64x64_0123456789abcdef_5");
+  const HiresTexturePack::Entry* dds = pack->Find("tex1_32x32_m_fedcba9876543210_14");
+  ASSERT_NE(nullptr, png);
+  ASSERT_NE(nullptr, dds);
+
+  std::vector<std::thread> threads;
+  std::vector<int> failures(4);
+  for (size_t i = 0; i < failures.size(); i++)
+  {
+    threads.emplace_back([&, i] {
+      const HiresTexturePack::Entry* entry = i % 2 ? dds : png;
+      const std::string& expected = m_contents[i % 2 ? "tex1_32x32_m_fedcba9876543210_14_arb.dds" :
+                                                       "tex1_64x64_0123456789abcdef_5.png"];
+      std::vector<u8> data;
+      for (int j = 0; j < 200; j++)
+      {
+        if (!pack->ReadData(*entry, &data) || std::string(data.begin(), data.end()) != expected)
+          failures[i]++;
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  for (int thread_failures : failures)
+    EXPECT_EQ(0, thread_failures);
+}
+
+TEST_F(HiresTexturePackTest, CreateFailsForUnreadableFile)
+{
+  auto files = HiresTexturePack::FindTextureFiles(m_directory + "/textures");
+  files.push_back({"tex1_8x8_0000000000000000_0", m_directory + "/textures/missing.png", false,
+                   false});
+  std::string error_message;
+  EXPECT_FALSE(HiresTexturePack::Create(m_directory + "/pack.dtp", files, 0, &error_message));
+  EXPECT_NE(std::string::npos, error_message.find("missing.png"));
+}
+
+TEST_F(HiresTexturePackTest, RejectsWrongUncompressedSize)
+{
+  std::unique_ptr<HiresTexturePack> pack = CreatePack(3);
+  ASSERT_NE(nullptr, pack);
+  const HiresTexturePack::Entry* png = pack->Find("tex1_64x64_0123456789abcdef_5");
+  ASSERT_NE(nullptr, png);
+  ASSERT_EQ(HiresTexturePack::Compression::Zstd, png->compression);
+  const size_t entry_offset = 16 + (png - pack->GetEntries().data()) * sizeof(*png) +
+                              offsetof(HiresTexturePack::Entry, uncompressed_size);
+  pack.reset();
+
+  // Claim that the texture is far bigger than it is.
+  std::string contents;
+  File::ReadFileToString(m_directory + "/pack.dtp", contents);
+  const u32 uncompressed_size = 0xFFFFFFFF;
+  std::memcpy(&contents[entry_offset], &uncompressed_size, sizeof(uncompressed_size));
+  File::WriteStringToFile(m_directory + "/pack.dtp", contents);
+
+  pack = HiresTexturePack::Open(m_directory + "/pack.dtp");
+  ASSERT_NE(nullptr, pack);
+  std::vector<u8> data;
+  EXPECT_FALSE(pack->ReadData(*pack->Find("tex1_64x64_0123456789abcdef_5"), &data));
+  EXPECT_TRUE(pack->ReadData(*pack->Find("tex1_32x32_m_fedcba9876543210_14"), &data));
+}